@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: async_control.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Non-blocking control. A motion is submitted with ControlAsync() and the
+ *        main thread keeps working (e.g. vision processing) while it runs.
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <chrono>
+#include <memory>
+#include <pthread.h>
+#include <thread>
+#include <filesystem>
+
+//=== Third-party library headers ===//
+#include "perseuslib/perseus_robot.h"
+#include "perseuslib/controller/command_handle.hpp"
+#include "logging/perseus_log.h"
+
+
+int main(int argc, char** argv)
+{
+  namespace ctrl = wisson_SDK::control;
+
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_AsyncCtrl");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "Async-Ctrl";
+
+  /*********************************  PerseusRobot-SDK init begin  *********************************/
+  std::filesystem::path config_path = std::filesystem::path(CONFIG_PATH) / "config.yaml";
+  auto robot = wisson_SDK::PerseusRobot::Create(config_path);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  auto mode = ctrl::ControllerMode::JointPosition();
+  std::array<double, 9> joint1 = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0};
+  std::array<double, 9> joint2 = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 0.0, 35.0};
+  auto cmd = ctrl::RobotCommand::CreateCommands(
+    std::vector<ctrl::MotionCommand>{
+      ctrl::MotionCommand::CreateCommand(joint1, 5.0),
+      ctrl::MotionCommand::CreateCommand(joint2, 5.0)
+    },
+    30.0
+  );
+
+  auto handle = robot->ControlAsync(mode, cmd);
+  handle.OnComplete([&](const ctrl::CommandHandle& h) {
+    SPDLOG_INFO("[{}] Motion finished: {}", example_tag, ctrl::detail::ResponseStatusToString(h.Status()));
+  });
+
+  // Overlap other work with the motion.
+  while (!handle.Wait(std::chrono::milliseconds(200))) {
+    SPDLOG_INFO("[{}] {} ({:.0f}%), main thread free for vision processing",
+                example_tag, ctrl::detail::CommandStateToString(handle.State()), handle.Progress() * 100.0);
+  }
+  return 0;
+}
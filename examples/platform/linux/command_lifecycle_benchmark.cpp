@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: command_lifecycle_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Latency breakdown of commands sent through a CommandMultiplexer, the
+ *        SendQueue and a writer thread to a local stand-in server that takes
+ *        [ack_us] to acknowledge and [waypoint_ms] per waypoint. Prints every
+ *        lifecycle segment and attributes the total to client, network and robot.
+ *
+ * Usage: command_lifecycle_benchmark [commands=300] [ack_us=300] [waypoint_ms=1]
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/common/event_fd.hpp"
+#include "perseuslib/controller/command_table.hpp"
+#include "perseuslib/network/command_frame.hpp"
+#include "perseuslib/network/send_queue.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+namespace net = wisson_SDK::network;
+
+namespace {
+
+/**
+ * @brief Acknowledges a command after @p ack_us, then reports every waypoint after @p waypoint_ms.
+ */
+void Serve(example::LoopbackListener& listener, int ack_us, int waypoint_ms)
+{
+  auto conn = listener.Accept();
+  auto respond = [&](uint32_t id, ctrl::ResponseStatus st) {
+    std::array<uint8_t, net::kCommandResponseSize> resp;
+    net::EncodeCommandResponse({id, st, 0}, resp);
+    conn.SendFrame(resp.data(), resp.size());
+  };
+  std::vector<uint8_t> frame;
+  while (conn.RecvFrame(frame)) {
+    const auto cmd = net::DecodeCommandFrame(frame.data(), frame.size());
+    if (!cmd) continue;
+    std::this_thread::sleep_for(std::chrono::microseconds(ack_us));
+    respond(cmd->cmd_id, ctrl::ResponseStatus::kWaiting);
+    for (std::size_t i = 0; i < cmd->values.size(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(waypoint_ms));
+      respond(cmd->cmd_id, ctrl::ResponseStatus::kSubSuccess);
+    }
+    respond(cmd->cmd_id, ctrl::ResponseStatus::kSuccess);
+  }
+  conn.ShutdownWrite();
+}
+
+std::shared_ptr<ctrl::RobotCommand> ArmCommand(int waypoints)
+{
+  std::vector<ctrl::MotionCommand> path;
+  for (int i = 0; i < waypoints; ++i) {
+    path.push_back(ctrl::MotionCommand::CreateCommand({0.4280, 30.0 + i, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0}, 1.0));
+  }
+  return ctrl::RobotCommand::CreateCommands(path);
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_Lifecycle");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "Lifecycle-Bench";
+
+  const int commands = argc > 1 ? std::stoi(argv[1]) : 300;
+  const int ack_us = argc > 2 ? std::stoi(argv[2]) : 300;
+  const int waypoint_ms = argc > 3 ? std::stoi(argv[3]) : 1;
+  const auto mode = ctrl::ControllerMode::JointPosition();
+
+  example::LoopbackListener listener;
+  std::thread server([&] { Serve(listener, ack_us, waypoint_ms); });
+  auto conn = example::LoopbackListener::Connect(listener.port());
+
+  // User thread: encode and enqueue; writer thread: drain to the socket.
+  net::SendQueue queue;
+  wisson_SDK::EventFd wakeup;
+  queue.SetWakeupHandler([&] { wakeup.Notify(); });
+  std::vector<uint8_t> encoded;
+  ctrl::CommandMultiplexer mux([&](const ctrl::RobotCommand& cmd, ctrl::CommandTimeline& timeline) {
+    net::EncodeCommandFrame(cmd, mode, encoded);
+    timeline.Mark(ctrl::CommandStage::kSerialized);
+    if (!queue.Submit(encoded.data(), encoded.size())) return false;
+    timeline.Mark(ctrl::CommandStage::kEnqueued);
+    return true;
+  });
+
+  std::atomic<bool> stop{false};
+  std::thread writer([&] {
+    while (!stop.load()) {
+      if (!wakeup.Wait(std::chrono::milliseconds(100))) continue;
+      wakeup.Consume();
+      queue.Drain([&](const net::FrameBuffer& buf) {
+        conn.SendFrame(buf.data, static_cast<uint32_t>(buf.size));
+        uint32_t cmd_id;
+        std::memcpy(&cmd_id, buf.data + 4, sizeof(cmd_id));
+        mux.OnWritten(cmd_id);
+      });
+    }
+  });
+  std::thread reader([&] {
+    std::vector<uint8_t> msg;
+    while (conn.RecvFrame(msg)) {
+      if (auto r = net::DecodeCommandResponse(msg.data(), msg.size())) mux.OnResponse(r->cmd_id, r->status);
+    }
+  });
+
+  int failed = 0;
+  std::string last;
+  for (int i = 0; i < commands; ++i) {
+    auto handle = mux.Submit(ArmCommand(3), ctrl::CommandResource::kLeftArm);
+    handle.Wait();
+    if (handle.Status() != ctrl::ResponseStatus::kSuccess) ++failed;
+    if (i + 1 == commands) last = handle.Timeline().ToString();
+  }
+
+  conn.ShutdownWrite();
+  server.join();
+  reader.join();
+  stop = true;
+  writer.join();
+
+  const auto& stats = mux.Stats();
+  SPDLOG_INFO("[{}] {} commands of 3 waypoints, ack after {} us, {} ms per waypoint, {} failed", example_tag,
+              commands, ack_us, waypoint_ms, failed);
+  SPDLOG_INFO("[{}] segment    | p50 [us] | p99 [us] | max [us] | mean [us]", example_tag);
+  for (std::size_t s = 0; s < ctrl::kLifecycleSegmentCount; ++s) {
+    const auto segment = static_cast<ctrl::LifecycleSegment>(s);
+    const auto& h = stats.Of(segment);
+    SPDLOG_INFO("[{}] {:<10} | {:>8.1f} | {:>8.1f} | {:>8.1f} | {:>9.1f}", example_tag,
+                ctrl::detail::LifecycleSegmentToString(segment), h.PercentileNs(50.0) * 1e-3,
+                h.PercentileNs(99.0) * 1e-3, h.MaxNs() * 1e-3, h.MeanNs() * 1e-3);
+  }
+
+  auto mean_us = [&](ctrl::LifecycleSegment s) { return stats.Of(s).MeanNs() * 1e-3; };
+  const double client_us = mean_us(ctrl::LifecycleSegment::kSerialize) + mean_us(ctrl::LifecycleSegment::kEnqueue) +
+                           mean_us(ctrl::LifecycleSegment::kIoWait);
+  const double network_us = mean_us(ctrl::LifecycleSegment::kAck);
+  const double robot_us = mean_us(ctrl::LifecycleSegment::kExecute);
+  const double total_us = mean_us(ctrl::LifecycleSegment::kTotal);
+  SPDLOG_INFO("[{}] mean total {:.1f} us: client {:.1f} us ({:.1f} %), network + intake {:.1f} us ({:.1f} %), "
+              "robot {:.1f} us ({:.1f} %)", example_tag, total_us, client_us, 100.0 * client_us / total_us,
+              network_us, 100.0 * network_us / total_us, robot_us, 100.0 * robot_us / total_us);
+  SPDLOG_INFO("[{}] last command: {}", example_tag, last);
+  return failed == 0 ? 0 : 1;
+}
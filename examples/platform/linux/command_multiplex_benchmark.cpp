@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: command_multiplex_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Dual-arm workload (left arm, right arm and gripper commands) against a
+ *        local stand-in server. One outstanding command per robot is compared with
+ *        per-resource multiplexing through the cmd_id table. Also reports the cost
+ *        of routing one response with many commands in flight.
+ *
+ * Usage: command_multiplex_benchmark [cycles=10] [waypoint_ms=4]
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/command_table.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Result
+{
+  double makespan_ms{0};
+  std::size_t max_concurrent{0};
+  int failed{0};
+};
+
+std::shared_ptr<ctrl::RobotCommand> ArmCommand(int waypoints)
+{
+  std::vector<ctrl::MotionCommand> path;
+  for (int i = 0; i < waypoints; ++i) {
+    path.push_back(ctrl::MotionCommand::CreateCommand({0.4280, 30.0 + i, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0}, 1.0));
+  }
+  return ctrl::RobotCommand::CreateCommands(path);
+}
+
+/**
+ * @brief Stand-in server executing every received command on its own thread:
+ *        [cmd_id | waypoints] -> kSubSuccess per waypoint, then kSuccess.
+ */
+Result Run(bool multiplex, int cycles, int waypoint_ms)
+{
+  example::LoopbackListener listener;
+  std::thread server([&] {
+    auto conn = listener.Accept();
+    std::mutex send_mutex;
+    std::vector<std::thread> motions;
+    auto respond = [&](uint32_t id, ctrl::ResponseStatus st) {
+      const uint32_t msg[2] = {id, static_cast<uint32_t>(st)};
+      std::lock_guard<std::mutex> lock(send_mutex);
+      conn.SendFrame(reinterpret_cast<const uint8_t*>(msg), sizeof(msg));
+    };
+    std::vector<uint8_t> frame;
+    while (conn.RecvFrame(frame)) {
+      uint32_t hdr[2];
+      std::memcpy(hdr, frame.data(), sizeof(hdr));
+      motions.emplace_back([=, &respond] {
+        for (uint32_t i = 0; i < hdr[1]; ++i) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(waypoint_ms));
+          respond(hdr[0], ctrl::ResponseStatus::kSubSuccess);
+        }
+        respond(hdr[0], ctrl::ResponseStatus::kSuccess);
+      });
+    }
+    for (auto& t : motions) t.join();
+    conn.ShutdownWrite();
+  });
+
+  auto client = example::LoopbackListener::Connect(listener.port());
+  ctrl::CommandMultiplexer mux([&](const ctrl::RobotCommand& cmd) {
+    const uint32_t hdr[2] = {cmd.cmd_id, static_cast<uint32_t>(cmd.commands.size())};
+    return client.SendFrame(reinterpret_cast<const uint8_t*>(hdr), sizeof(hdr));
+  });
+  std::thread io([&] {
+    std::vector<uint8_t> msg;
+    while (client.RecvFrame(msg)) {
+      uint32_t v[2];
+      std::memcpy(v, msg.data(), sizeof(v));
+      mux.OnResponse(v[0], static_cast<ctrl::ResponseStatus>(v[1]));
+    }
+  });
+
+  // Per cycle: both arms pick (5 waypoints each), then the gripper closes.
+  auto resources = [&](ctrl::ResourceMask own) { return multiplex ? own : ctrl::kAllResources; };
+  const auto t0 = Clock::now();
+  std::vector<ctrl::CommandHandle> handles;
+  for (int c = 0; c < cycles; ++c) {
+    handles.push_back(mux.Submit(ArmCommand(5), resources(ctrl::ToMask(ctrl::CommandResource::kLeftArm))));
+    handles.push_back(mux.Submit(ArmCommand(5), resources(ctrl::ToMask(ctrl::CommandResource::kRightArm))));
+    handles.push_back(mux.Submit(ctrl::RobotCommand::CreateCommand(ctrl::EndEffectorCommand{
+                                   .ee_action = ctrl::EndEffectorAction::Close, .timeout = 1.0}),
+                                 resources(ctrl::ToMask(ctrl::CommandResource::kEndEffector))));
+  }
+  Result r;
+  for (auto& h : handles) {
+    h.Wait();
+    if (h.Status() != ctrl::ResponseStatus::kSuccess) ++r.failed;
+  }
+  r.makespan_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+  r.max_concurrent = mux.MaxConcurrent();
+
+  client.ShutdownWrite();
+  server.join();
+  io.join();
+  return r;
+}
+
+/**
+ * @brief Cost of routing one intermediate response with @p in_flight commands in the table.
+ */
+double RouteNs(std::size_t in_flight)
+{
+  ctrl::InFlightTable table;
+  std::vector<uint32_t> ids;
+  for (std::size_t i = 0; i < in_flight; ++i) {
+    auto state = std::make_shared<ctrl::detail::CommandHandleState>();
+    state->cmd = ctrl::RobotCommand::CreateCommand(ctrl::MotionCommand::CreateCommand({}, 1.0));
+    state->cmd->cmd_id = ctrl::Controller::GenerateCommandId();
+    ids.push_back(state->cmd->cmd_id);
+    table.Insert({state, ctrl::ToMask(ctrl::CommandResource::kLeftArm)});
+  }
+  const int rounds = 1000000;
+  ctrl::InFlightTable::Entry finished;
+  const auto t0 = Clock::now();
+  for (int i = 0; i < rounds; ++i) table.Route(ids[i % ids.size()], ctrl::ResponseStatus::kWaiting, finished);
+  return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / rounds;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_Multiplex");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "Multiplex-Bench";
+
+  const int cycles = argc > 1 ? std::stoi(argv[1]) : 10;
+  const int waypoint_ms = argc > 2 ? std::stoi(argv[2]) : 4;
+  SPDLOG_INFO("[{}] {} cycles of left pick + right pick (5 waypoints) + gripper close, {} ms per waypoint",
+              example_tag, cycles, waypoint_ms);
+  SPDLOG_INFO("[{}] dispatch          | makespan [ms] | max in flight | failed", example_tag);
+
+  const Result single = Run(false, cycles, waypoint_ms);
+  SPDLOG_INFO("[{}] one per robot     | {:>13.1f} | {:>13} | {:>6}", example_tag, single.makespan_ms,
+              single.max_concurrent, single.failed);
+  const Result multi = Run(true, cycles, waypoint_ms);
+  SPDLOG_INFO("[{}] per resource      | {:>13.1f} | {:>13} | {:>6}", example_tag, multi.makespan_ms,
+              multi.max_concurrent, multi.failed);
+  SPDLOG_INFO("[{}] speedup {:.2f}x", example_tag, single.makespan_ms / multi.makespan_ms);
+
+  SPDLOG_INFO("[{}] response routing: {:.0f} ns with 1 in flight, {:.0f} ns with 256 in flight", example_tag,
+              RouteNs(1), RouteNs(256));
+  return 0;
+}
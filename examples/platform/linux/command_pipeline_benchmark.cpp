@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: command_pipeline_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Robot idle time between consecutive motions with and without command
+ *        pipelining. A local stand-in server executes each RobotCommand for a fixed
+ *        time and queues commands that arrive while it is busy; a one-way network
+ *        delay is emulated on the server side.
+ *
+ * Usage: command_pipeline_benchmark [motions=30] [motion_ms=20] [one_way_delay_ms=2]
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include <json/json.h>
+#include "perseuslib/controller/command_pipeline.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+/**
+ * @brief Frames released no earlier than their due time (emulated link delay).
+ */
+struct DelayedInbox
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::pair<Clock::time_point, std::vector<uint8_t>>> frames;
+  bool closed{false};
+
+  void Push(Clock::time_point due, std::vector<uint8_t> frame)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      frames.emplace_back(due, std::move(frame));
+    }
+    cv.notify_all();
+  }
+
+  bool Pop(std::vector<uint8_t>& out)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return closed || !frames.empty(); });
+    if (frames.empty()) return false;
+    const auto due = frames.front().first;
+    lock.unlock();
+    std::this_thread::sleep_until(due);
+    lock.lock();
+    out = std::move(frames.front().second);
+    frames.pop_front();
+    return true;
+  }
+
+  void Close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      closed = true;
+    }
+    cv.notify_all();
+  }
+};
+
+std::vector<uint8_t> SerializeCommand(const ctrl::RobotCommand& cmd)
+{
+  Json::Value body;
+  body["CmdId"] = Json::UInt(cmd.cmd_id);
+  body["TotalTimeout"] = cmd.total_timeout;
+  for (const auto& q : cmd.getJointPositionsVec()) {
+    Json::Value joints(Json::arrayValue);
+    for (double x : q) joints.append(x);
+    body["Joints"].append(joints);
+  }
+  for (double t : cmd.getTimeoutVec()) body["Timeouts"].append(t);
+  Json::StreamWriterBuilder writer;
+  writer["indentation"] = "";
+  const std::string s = Json::writeString(writer, body);
+  return {s.begin(), s.end()};
+}
+
+struct Result
+{
+  double cycle_ms{0};
+  double mean_gap_ms{0};
+  double max_gap_ms{0};
+};
+
+Result RunCycle(std::size_t depth, int motions, int motion_ms, int delay_ms)
+{
+  const auto delay = std::chrono::milliseconds(delay_ms);
+  example::LoopbackListener listener;
+  std::vector<double> gaps_ms;
+
+  // Stand-in server: receive -> (delay) -> execute in order -> (delay) -> respond.
+  std::thread server([&] {
+    auto conn = listener.Accept();
+    DelayedInbox inbox, outbox;
+    std::thread rx([&] {
+      std::vector<uint8_t> frame;
+      while (conn.RecvFrame(frame)) inbox.Push(Clock::now() + delay, frame);
+      inbox.Close();
+    });
+    std::thread tx([&] {
+      std::vector<uint8_t> frame;
+      while (outbox.Pop(frame)) conn.SendFrame(frame.data(), static_cast<uint32_t>(frame.size()));
+    });
+
+    std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+    std::vector<uint8_t> frame;
+    std::optional<Clock::time_point> last_finish;
+    for (int i = 0; i < motions && inbox.Pop(frame); ++i) {
+      const auto start = Clock::now();
+      if (last_finish) gaps_ms.push_back(std::chrono::duration<double, std::milli>(start - *last_finish).count());
+      Json::Value body;
+      const char* begin = reinterpret_cast<const char*>(frame.data());
+      reader->parse(begin, begin + frame.size(), &body, nullptr);
+      std::this_thread::sleep_until(start + std::chrono::milliseconds(motion_ms));  // motion
+      last_finish = Clock::now();
+
+      std::vector<uint8_t> response(sizeof(uint32_t) * 2);
+      const uint32_t id = body["CmdId"].asUInt();
+      const auto status = static_cast<uint32_t>(ctrl::ResponseStatus::kSuccess);
+      std::memcpy(response.data(), &id, sizeof(id));
+      std::memcpy(response.data() + sizeof(id), &status, sizeof(status));
+      outbox.Push(*last_finish + delay, std::move(response));
+    }
+    outbox.Close();
+    tx.join();
+    ::shutdown(conn.fd(), SHUT_RDWR);
+    rx.join();
+  });
+
+  auto client = example::LoopbackListener::Connect(listener.port());
+  ctrl::CommandPipeline pipeline(SerializeCommand, [&](const std::vector<uint8_t>& f) {
+    return client.SendFrame(f.data(), static_cast<uint32_t>(f.size()));
+  }, ctrl::kDefaultPipelineCapacity, depth);
+
+  // Client io thread.
+  std::thread io([&] {
+    std::vector<uint8_t> frame;
+    while (client.RecvFrame(frame)) {
+      uint32_t id = 0, status = 0;
+      std::memcpy(&id, frame.data(), sizeof(id));
+      std::memcpy(&status, frame.data() + sizeof(id), sizeof(status));
+      pipeline.OnResponse(id, static_cast<ctrl::ResponseStatus>(status));
+    }
+  });
+
+  // Pick-and-place style cycle alternating between two poses.
+  std::array<double, 9> a = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0};
+  std::array<double, 9> b = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 0.0, 35.0};
+  const auto t0 = Clock::now();
+  ctrl::CommandHandle last;
+  for (int i = 0; i < motions; ++i) {
+    auto cmd = ctrl::RobotCommand::CreateCommand(ctrl::MotionCommand::CreateCommand(i % 2 ? b : a, 5.0));
+    last = pipeline.Submit(std::move(cmd));
+  }
+  last.Wait();
+  const double cycle_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+  server.join();
+  io.join();
+
+  Result r;
+  r.cycle_ms = cycle_ms;
+  if (!gaps_ms.empty()) {
+    for (double g : gaps_ms) r.mean_gap_ms += g;
+    r.mean_gap_ms /= static_cast<double>(gaps_ms.size());
+    r.max_gap_ms = *std::max_element(gaps_ms.begin(), gaps_ms.end());
+  }
+  return r;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_Pipeline");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "CmdPipeline-Bench";
+
+  const int motions = argc > 1 ? std::stoi(argv[1]) : 30;
+  const int motion_ms = argc > 2 ? std::stoi(argv[2]) : 20;
+  const int delay_ms = argc > 3 ? std::stoi(argv[3]) : 2;
+  SPDLOG_INFO("[{}] {} motions of {} ms, one-way delay {} ms", example_tag, motions, motion_ms, delay_ms);
+  SPDLOG_INFO("[{}] mode        | cycle [ms] | idle gap mean [ms] | idle gap max [ms]", example_tag);
+
+  for (std::size_t depth : {std::size_t{1}, ctrl::kDefaultPipelineDepth}) {
+    const Result r = RunCycle(depth, motions, motion_ms, delay_ms);
+    SPDLOG_INFO("[{}] {} | {:>10.1f} | {:>18.3f} | {:>17.3f}", example_tag,
+                depth == 1 ? "sequential " : "pipelined  ", r.cycle_ms, r.mean_gap_ms, r.max_gap_ms);
+  }
+  return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: command_pool_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Heap allocations and time per submitted command, counted by replacing the
+ *        global operator new. RobotCommand::CreateCommands() with the vector
+ *        getters is compared with RobotCommandPool and the range helpers; both
+ *        encode into a reused frame buffer and go through a SendQueue. Exits with
+ *        1 if the pooled path allocates after warm-up.
+ *
+ * Usage: command_pool_benchmark [commands=200000]
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/command_pool.hpp"
+#include "perseuslib/network/command_frame.hpp"
+#include "perseuslib/network/send_queue.hpp"
+#include "logging/perseus_log.h"
+#include "alloc_counter.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+namespace net = wisson_SDK::network;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct PathResult
+{
+  double allocations_per_cmd{0.0};
+  double ns_per_cmd{0.0};
+};
+
+/**
+ * @brief Submit @p n commands built by @p make, after @p warmup untimed ones.
+ */
+template <typename MakeFn, typename ReadFn>
+PathResult Run(int n, int warmup, MakeFn&& make, ReadFn&& read)
+{
+  net::SendQueue queue;
+  std::vector<uint8_t> frame;
+  double sink = 0.0;
+  const auto mode = ctrl::ControllerMode::JointPosition();
+
+  auto submit_one = [&] {
+    auto cmd = make();
+    cmd->cmd_id = ctrl::Controller::GenerateCommandId();
+    sink += read(*cmd);
+    net::EncodeCommandFrame(*cmd, mode, frame);
+    queue.Submit(frame.data(), frame.size());
+    queue.Drain([&](const net::FrameBuffer& buf) { sink += buf.size; });
+  };
+
+  for (int i = 0; i < warmup; ++i) submit_one();
+  example::CountAllocations count;
+  const uint64_t before = example::Allocations();
+  const auto t0 = Clock::now();
+  for (int i = 0; i < n; ++i) submit_one();
+  const double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+  const uint64_t allocations = example::Allocations() - before;
+  if (sink < 0.0) std::abort();
+  return {static_cast<double>(allocations) / n, ns / n};
+}
+
+/**
+ * @brief Hammer a small pool from several threads; every command must come back reset.
+ */
+bool ConcurrentRecycle(int threads, int rounds)
+{
+  ctrl::RobotCommandPool pool(8);
+  const auto entry = ctrl::EndEffectorCommand{ctrl::EndEffectorAction::Close, 1.0};
+  std::atomic<int> dirty{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < rounds; ++i) {
+        auto cmd = pool.AcquireCommand(entry);
+        if (!cmd) continue;
+        if (cmd->cmd_id != 0 || cmd->commands.size() != 1) dirty.fetch_add(1);
+        cmd->cmd_id = static_cast<uint32_t>(t + 1);
+      }
+    });
+  }
+  for (auto& w : workers) w.join();
+  return dirty.load() == 0;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_CmdPool");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "CmdPool-Bench";
+
+  const int n = argc > 1 ? std::stoi(argv[1]) : 200000;
+  const int warmup = 1000;
+
+  std::vector<ctrl::MotionCommand> path;
+  for (std::size_t i = 0; i < ctrl::cmd_list_size; ++i) {
+    const double s = static_cast<double>(i) / (ctrl::cmd_list_size - 1);
+    path.push_back(ctrl::MotionCommand::CreateCommand(
+      {0.4280, 30.0 + 20.0 * s, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0 - 30.0 * s, 5.0}, 0.5));
+  }
+
+  const auto heap = Run(n, warmup,
+    [&] { return ctrl::RobotCommand::CreateCommands(path); },
+    [](const ctrl::RobotCommand& cmd) {
+      double sum = 0.0;
+      for (const auto& q : cmd.getJointPositionsVec()) sum += q[1];
+      for (double t : cmd.getTimeoutVec()) sum += t;
+      return sum;
+    });
+
+  ctrl::RobotCommandPool pool(16);
+  const auto pooled = Run(n, warmup,
+    [&] { return pool.AcquireCommands(path); },
+    [](const ctrl::RobotCommand& cmd) {
+      double sum = 0.0;
+      for (const auto& q : cmd.JointPositions()) sum += q[1];
+      for (double t : cmd.Timeouts()) sum += t;
+      return sum;
+    });
+
+  const bool recycled = ConcurrentRecycle(4, 100000);
+
+  SPDLOG_INFO("[{}] {} commands of {} waypoints after {} warm-up", example_tag, n, path.size(), warmup);
+  SPDLOG_INFO("[{}] path                            | allocations / cmd | ns / cmd", example_tag);
+  SPDLOG_INFO("[{}] CreateCommands + vector getters | {:>17.2f} | {:>8.0f}", example_tag,
+              heap.allocations_per_cmd, heap.ns_per_cmd);
+  SPDLOG_INFO("[{}] RobotCommandPool + range views  | {:>17.2f} | {:>8.0f}", example_tag,
+              pooled.allocations_per_cmd, pooled.ns_per_cmd);
+  SPDLOG_INFO("[{}] concurrent recycle (4 threads, pool of 8): {}", example_tag,
+              recycled ? "every command came back reset" : "FAILED");
+
+  return (pooled.allocations_per_cmd == 0.0 && recycled) ? 0 : 1;
+}
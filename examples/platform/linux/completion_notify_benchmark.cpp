@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: completion_notify_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Wakeup latency from receipt of a response (or state frame) on the io
+ *        thread to the user code that reacts to it. A local stand-in server
+ *        answers after a random delay. The user thread waits by epoll on
+ *        CommandHandle::NotifyFd() / StateIngestor::StateNotifyFd(), by blocking
+ *        in CommandHandle::Wait(), or by polling Done() every millisecond.
+ *
+ * Usage: completion_notify_benchmark [trials=500]
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+//=== Third-party library headers ===//
+#include "perseuslib/common/clock_sync.hpp"
+#include "perseuslib/common/latency_histogram.hpp"
+#include "perseuslib/controller/command_handle.hpp"
+#include "perseuslib/network/command_frame.hpp"
+#include "perseuslib/network/state_ingest.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+namespace net = wisson_SDK::network;
+using wisson_SDK::timer::SteadyNowNs;
+
+namespace {
+
+constexpr uint8_t kRequestResponse = 'r';
+constexpr uint8_t kRequestState = 's';
+constexpr std::size_t kStateFrameSize = 64;
+
+/**
+ * @brief Answers every request byte with a response or a state frame after up to 500 us.
+ */
+void Serve(example::LoopbackListener& listener)
+{
+  auto conn = listener.Accept();
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> delay_us(0, 500);
+  std::vector<uint8_t> frame;
+  uint32_t cmd_id = 0;
+  while (conn.RecvFrame(frame)) {
+    std::this_thread::sleep_for(std::chrono::microseconds(delay_us(rng)));
+    if (frame[0] == kRequestResponse) {
+      std::array<uint8_t, net::kCommandResponseSize> resp;
+      net::EncodeCommandResponse({++cmd_id, ctrl::ResponseStatus::kSuccess, 0}, resp);
+      conn.SendFrame(resp.data(), resp.size());
+    } else {
+      const std::array<uint8_t, kStateFrameSize> state{};
+      conn.SendFrame(state.data(), state.size());
+    }
+  }
+  conn.ShutdownWrite();
+}
+
+/**
+ * @brief Client io thread: completes the current handle, publishes states.
+ */
+struct Client
+{
+  explicit Client(uint16_t port) : conn(example::LoopbackListener::Connect(port))
+  {
+    state_fd = ingestor.StateNotifyFd();
+    io = std::thread([this] { Receive(); });
+  }
+
+  ~Client()
+  {
+    conn.ShutdownWrite();
+    io.join();
+  }
+
+  void Request(uint8_t what) { conn.SendFrame(&what, 1); }
+
+  void Receive()
+  {
+    std::vector<uint8_t> msg;
+    while (conn.RecvFrame(msg)) {
+      const net::FrameView frame{msg.data(), msg.size()};
+      ingestor.ProcessBatch(std::span<const net::FrameView>(&frame, 1),
+        [](const net::FrameView& f) { return f.size == kStateFrameSize ? net::FrameClass::kState : net::FrameClass::kOther; },
+        [&](const net::FrameView&) { received_ns.store(SteadyNowNs()); },
+        [&](const net::FrameView& f) {
+          if (!net::DecodeCommandResponse(f.data, f.size)) return;
+          received_ns.store(SteadyNowNs());
+          std::lock_guard<std::mutex> lock(mutex);
+          if (pending) std::exchange(pending, nullptr)->Complete(ctrl::ResponseStatus::kSuccess);
+        });
+    }
+  }
+
+  ctrl::CommandHandle Submit()
+  {
+    auto state = std::make_shared<ctrl::detail::CommandHandleState>();
+    state->cmd = ctrl::RobotCommand::CreateCommand(ctrl::EndEffectorCommand{ctrl::EndEffectorAction::Open, 1.0});
+    state->state = ctrl::CommandState::kRunning;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending = state;
+    }
+    Request(kRequestResponse);
+    return ctrl::CommandHandle(state);
+  }
+
+  example::LoopbackStream conn;
+  net::StateIngestor ingestor;
+  int state_fd{-1};
+  std::atomic<int64_t> received_ns{0};
+  std::mutex mutex;
+  std::shared_ptr<ctrl::detail::CommandHandleState> pending;
+  std::thread io;
+};
+
+enum class Mode { kEpoll, kWait, kPoll1ms, kStateEpoll };
+
+void Run(Mode mode, int trials, Client& client, wisson_SDK::timer::LatencyHistogram& h)
+{
+  const int ep = epoll_create1(EPOLL_CLOEXEC);
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  if (mode == Mode::kStateEpoll) epoll_ctl(ep, EPOLL_CTL_ADD, client.state_fd, &ev);
+
+  for (int t = 0; t < trials; ++t) {
+    if (mode == Mode::kStateEpoll) {
+      client.Request(kRequestState);
+      epoll_event out;
+      while (epoll_wait(ep, &out, 1, -1) != 1) {}
+      const int64_t woke = SteadyNowNs();
+      uint64_t count;
+      (void)!read(client.state_fd, &count, sizeof(count));
+      h.RecordNs(static_cast<uint64_t>(woke - client.received_ns.load()));
+      continue;
+    }
+
+    auto handle = client.Submit();
+    switch (mode)
+    {
+      case Mode::kEpoll: {
+        const int fd = handle.NotifyFd();
+        epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+        epoll_event out;
+        while (epoll_wait(ep, &out, 1, -1) != 1) {}
+        h.RecordNs(static_cast<uint64_t>(SteadyNowNs() - client.received_ns.load()));
+        epoll_ctl(ep, EPOLL_CTL_DEL, fd, nullptr);
+        break;
+      }
+      case Mode::kWait:
+        handle.Wait();
+        h.RecordNs(static_cast<uint64_t>(SteadyNowNs() - client.received_ns.load()));
+        break;
+      default:
+        while (!handle.Done()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        h.RecordNs(static_cast<uint64_t>(SteadyNowNs() - client.received_ns.load()));
+        break;
+    }
+  }
+  close(ep);
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_Notify");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "Notify-Bench";
+
+  const int trials = argc > 1 ? std::stoi(argv[1]) : 500;
+
+  example::LoopbackListener listener;
+  std::thread server([&] { Serve(listener); });
+  {
+    Client client(listener.port());
+
+    SPDLOG_INFO("[{}] {} trials per mode, response delay 0-500 us", example_tag, trials);
+    SPDLOG_INFO("[{}] user thread waits by         | p50 [us] | p99 [us] | max [us]", example_tag);
+    auto run = [&](const char* name, Mode mode) {
+      wisson_SDK::timer::LatencyHistogram h;
+      Run(mode, trials, client, h);
+      SPDLOG_INFO("[{}] {} | {:>8.1f} | {:>8.1f} | {:>8.1f}", example_tag, name, h.PercentileNs(50.0) * 1e-3,
+                  h.PercentileNs(99.0) * 1e-3, h.MaxNs() * 1e-3);
+    };
+    run("epoll on NotifyFd()        ", Mode::kEpoll);
+    run("CommandHandle::Wait()      ", Mode::kWait);
+    run("polling Done() every 1 ms  ", Mode::kPoll1ms);
+    run("epoll on StateNotifyFd()   ", Mode::kStateEpoll);
+  }
+  server.join();
+  return 0;
+}
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: alloc_counter.hpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Heap allocation counter of the example benchmarks. Replaces the global
+ *        operator new / delete, so include it from one translation unit per
+ *        program only. Not part of the SDK.
+ */
+#pragma once
+
+//=== Standard library headers ===//
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+namespace example {
+
+namespace detail {
+
+inline std::atomic<uint64_t> g_allocations{0};
+inline thread_local bool t_count_allocations = false;
+
+}  // namespace detail
+
+/**
+ * @brief Allocations made so far by threads inside a CountAllocations scope.
+ */
+inline uint64_t Allocations() noexcept { return detail::g_allocations.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Counts the heap allocations of the calling thread while alive.
+ */
+class CountAllocations
+{
+public:
+  CountAllocations() noexcept : previous_(detail::t_count_allocations) { detail::t_count_allocations = true; }
+  ~CountAllocations() { detail::t_count_allocations = previous_; }
+
+  CountAllocations(const CountAllocations&) = delete;
+  CountAllocations& operator=(const CountAllocations&) = delete;
+
+private:
+  bool previous_;
+};
+
+}  // namespace example
+
+
+void* operator new(std::size_t size)
+{
+  if (example::detail::t_count_allocations) {
+    example::detail::g_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
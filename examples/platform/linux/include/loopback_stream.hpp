@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: loopback_stream.hpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Minimal length-prefixed TCP loopback used by the stand-in servers of the
+ *        example benchmarks. Not part of the SDK.
+ */
+#pragma once
+
+//=== Standard library headers ===//
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace example {
+
+/**
+ * @brief Connected TCP socket exchanging frames prefixed with a u32 length.
+ */
+class LoopbackStream
+{
+public:
+  LoopbackStream() = default;
+  explicit LoopbackStream(int fd) : fd_(fd)
+  {
+    int one = 1;
+    ::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  }
+  LoopbackStream(LoopbackStream&& other) noexcept : fd_(other.fd_) { other.fd_ = -1; }
+  LoopbackStream& operator=(LoopbackStream&& other) noexcept
+  {
+    std::swap(fd_, other.fd_);
+    return *this;
+  }
+  ~LoopbackStream() { if (fd_ >= 0) ::close(fd_); }
+
+  LoopbackStream(const LoopbackStream&) = delete;
+  LoopbackStream& operator=(const LoopbackStream&) = delete;
+
+  [[nodiscard]] int fd() const noexcept { return fd_; }
+
+  bool SendFrame(const uint8_t* data, uint32_t size)
+  {
+    return WriteAll(&size, sizeof(size)) && WriteAll(data, size);
+  }
+
+  /**
+   * @brief Receive one frame into @p out. Returns false on EOF.
+   */
+  bool RecvFrame(std::vector<uint8_t>& out)
+  {
+    uint32_t size = 0;
+    if (!ReadAll(&size, sizeof(size))) return false;
+    out.resize(size);
+    return ReadAll(out.data(), size);
+  }
+
+  /**
+   * @brief Append whatever bytes are already queued on the socket to @p buf.
+   * @return Bytes read; 0 if nothing was pending, -1 on EOF/error.
+   */
+  ssize_t RecvAvailable(std::vector<uint8_t>& buf)
+  {
+    ssize_t total = 0;
+    uint8_t chunk[16384];
+    for (;;) {
+      const ssize_t r = ::recv(fd_, chunk, sizeof(chunk), MSG_DONTWAIT);
+      if (r > 0) {
+        buf.insert(buf.end(), chunk, chunk + r);
+        total += r;
+        continue;
+      }
+      if (r == 0) return total > 0 ? total : -1;
+      return total;  // EAGAIN: drained
+    }
+  }
+
+  void ShutdownWrite() { ::shutdown(fd_, SHUT_WR); }
+
+private:
+  bool WriteAll(const void* p, std::size_t n)
+  {
+    auto* b = static_cast<const uint8_t*>(p);
+    while (n > 0) {
+      const ssize_t w = ::send(fd_, b, n, MSG_NOSIGNAL);
+      if (w <= 0) return false;
+      b += w;
+      n -= static_cast<std::size_t>(w);
+    }
+    return true;
+  }
+
+  bool ReadAll(void* p, std::size_t n)
+  {
+    auto* b = static_cast<uint8_t*>(p);
+    while (n > 0) {
+      const ssize_t r = ::recv(fd_, b, n, 0);
+      if (r <= 0) return false;
+      b += r;
+      n -= static_cast<std::size_t>(r);
+    }
+    return true;
+  }
+
+private:
+  int fd_{-1};
+};
+
+
+/**
+ * @brief Walk the complete u32-length-prefixed frames at the front of @p buf.
+ *
+ * Calls fn(const uint8_t* data, uint32_t size) per complete frame. A trailing
+ * partial frame is left alone.
+ * @return Number of bytes consumed; erase them once the frames are handled.
+ */
+template <typename Fn>
+std::size_t SplitFrames(const std::vector<uint8_t>& buf, Fn&& fn)
+{
+  std::size_t pos = 0;
+  while (buf.size() - pos >= sizeof(uint32_t)) {
+    uint32_t size = 0;
+    std::memcpy(&size, buf.data() + pos, sizeof(size));
+    if (buf.size() - pos - sizeof(size) < size) break;
+    fn(buf.data() + pos + sizeof(size), size);
+    pos += sizeof(size) + size;
+  }
+  return pos;
+}
+
+
+/**
+ * @brief Listening socket on 127.0.0.1 with an ephemeral port.
+ */
+class LoopbackListener
+{
+public:
+  LoopbackListener()
+  {
+    fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t len = sizeof(addr);
+    if (fd_ < 0 || ::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd_, 4) != 0 || ::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+      throw std::runtime_error("LoopbackListener: cannot listen on 127.0.0.1");
+    }
+    port_ = ntohs(addr.sin_port);
+  }
+  ~LoopbackListener() { if (fd_ >= 0) ::close(fd_); }
+
+  LoopbackListener(const LoopbackListener&) = delete;
+  LoopbackListener& operator=(const LoopbackListener&) = delete;
+
+  [[nodiscard]] uint16_t port() const noexcept { return port_; }
+
+  LoopbackStream Accept() { return LoopbackStream(::accept(fd_, nullptr, nullptr)); }
+
+  static LoopbackStream Connect(uint16_t port)
+  {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+      throw std::runtime_error("LoopbackListener: cannot connect to stand-in server");
+    }
+    return LoopbackStream(fd);
+  }
+
+private:
+  int fd_{-1};
+  uint16_t port_{0};
+};
+
+}  // namespace example
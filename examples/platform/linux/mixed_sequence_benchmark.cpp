@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: mixed_sequence_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Pick cycle move, move, close gripper, move, move, open gripper against a
+ *        local stand-in server. One blocking call per mode run (as path_control
+ *        does with JointPosition() and TaskCommand()) is compared with the whole
+ *        cycle in one sequence frame chained by the server. Every command costs
+ *        the server [setup_ms] intake and [settle_ms] stop at its end; a mode
+ *        switch inside a sequence costs 1 ms. The shipped transport does not
+ *        send sequence frames yet: both paths run against the stand-in only.
+ *        Also checks that Split() refuses a torque step; exits with 1 if not.
+ *
+ * Usage: mixed_sequence_benchmark [cycles=10] [step_ms=5] [setup_ms=2] [settle_ms=10]
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <chrono>
+#include <pthread.h>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/command_sequence.hpp"
+#include "perseuslib/network/command_frame.hpp"
+#include "perseuslib/network/sequence_frame.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+namespace net = wisson_SDK::network;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct ServerTiming
+{
+  int step_ms{5};
+  int setup_ms{2};
+  int settle_ms{10};
+  int switch_ms{1};
+};
+
+/**
+ * @brief Executes sequence frames one at a time: kSubSuccess per step, then kSuccess.
+ */
+void Serve(example::LoopbackListener& listener, ServerTiming timing)
+{
+  auto conn = listener.Accept();
+  auto respond = [&](uint32_t id, ctrl::ResponseStatus st, uint32_t index) {
+    std::array<uint8_t, net::kCommandResponseSize> resp;
+    net::EncodeCommandResponse({id, st, index}, resp);
+    conn.SendFrame(resp.data(), resp.size());
+  };
+  std::vector<uint8_t> frame;
+  while (conn.RecvFrame(frame)) {
+    const auto seq = net::DecodeSequenceFrame(frame.data(), frame.size());
+    if (!seq) continue;
+    std::this_thread::sleep_for(std::chrono::milliseconds(timing.setup_ms));
+    for (std::size_t i = 0; i < seq->steps.size(); ++i) {
+      if (i > 0 && seq->modes[i] != seq->modes[i - 1]) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timing.switch_ms));
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(timing.step_ms));
+      respond(seq->cmd_id, ctrl::ResponseStatus::kSubSuccess, static_cast<uint32_t>(i));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(timing.settle_ms));
+    respond(seq->cmd_id, ctrl::ResponseStatus::kSuccess, static_cast<uint32_t>(seq->steps.size()));
+  }
+  conn.ShutdownWrite();
+}
+
+/**
+ * @brief Send @p cmd in @p modes and block until its final status, like Control().
+ */
+ctrl::ResponseStatus Execute(example::LoopbackStream& conn, ctrl::RobotCommand& cmd,
+                             std::span<const ctrl::ControllerMode> modes, std::vector<uint8_t>& frame)
+{
+  static uint32_t next_id = 0;
+  cmd.cmd_id = ++next_id;
+  net::EncodeSequenceFrame(cmd, modes, frame);
+  conn.SendFrame(frame.data(), static_cast<uint32_t>(frame.size()));
+  std::vector<uint8_t> msg;
+  while (conn.RecvFrame(msg)) {
+    const auto r = net::DecodeCommandResponse(msg.data(), msg.size());
+    if (r && net::ApplyCommandResponse(cmd, *r)) return cmd.status;
+  }
+  return ctrl::ResponseStatus::kAbort;
+}
+
+struct Result
+{
+  double cycle_ms{0};
+  int commands{0};
+  int failed{0};
+};
+
+Result Run(bool mixed, int cycles, ServerTiming timing)
+{
+  example::LoopbackListener listener;
+  std::thread server([&] { Serve(listener, timing); });
+  auto conn = example::LoopbackListener::Connect(listener.port());
+
+  const std::array<double, 9> pre = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0};
+  const std::array<double, 9> grasp = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 0.0, 35.0};
+  ctrl::CommandSequence seq;
+  seq.Move(pre, 5.0).Move(grasp, 5.0).Gripper(ctrl::EndEffectorAction::Close, 5.0)
+     .Move(pre, 5.0).Move(grasp, 5.0).Gripper(ctrl::EndEffectorAction::Open, 5.0);
+
+  Result r;
+  std::vector<uint8_t> frame;
+  const auto t0 = Clock::now();
+  for (int c = 0; c < cycles; ++c) {
+    if (mixed) {
+      auto cmd = seq.Build();
+      ++r.commands;
+      if (Execute(conn, *cmd, seq.Modes(), frame) != ctrl::ResponseStatus::kSuccess) ++r.failed;
+      continue;
+    }
+    for (auto& segment : seq.Split()) {
+      ++r.commands;
+      const std::vector<ctrl::ControllerMode> modes(segment.cmd->commands.size(), segment.mode);
+      if (Execute(conn, *segment.cmd, modes, frame) != ctrl::ResponseStatus::kSuccess) ++r.failed;
+    }
+  }
+  r.cycle_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / cycles;
+
+  conn.ShutdownWrite();
+  server.join();
+  return r;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_MixedSeq");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "MixedSeq-Bench";
+
+  const int cycles = argc > 1 ? std::stoi(argv[1]) : 10;
+  ServerTiming timing;
+  if (argc > 2) timing.step_ms = std::stoi(argv[2]);
+  if (argc > 3) timing.setup_ms = std::stoi(argv[3]);
+  if (argc > 4) timing.settle_ms = std::stoi(argv[4]);
+
+  SPDLOG_INFO("[{}] {} cycles of 6 steps (4 mode runs), {} ms per step, {} ms setup, {} ms settle per command",
+              example_tag, cycles, timing.step_ms, timing.setup_ms, timing.settle_ms);
+  SPDLOG_INFO("[{}] submission                 | cycle [ms] | commands | failed", example_tag);
+  const Result split = Run(false, cycles, timing);
+  SPDLOG_INFO("[{}] one call per mode run      | {:>10.1f} | {:>8} | {:>6}", example_tag, split.cycle_ms,
+              split.commands, split.failed);
+  const Result mixed = Run(true, cycles, timing);
+  SPDLOG_INFO("[{}] one mixed sequence frame   | {:>10.1f} | {:>8} | {:>6}", example_tag, mixed.cycle_ms,
+              mixed.commands, mixed.failed);
+  SPDLOG_INFO("[{}] cycle time {:.1f} ms -> {:.1f} ms ({:.2f}x)", example_tag, split.cycle_ms, mixed.cycle_ms,
+              split.cycle_ms / mixed.cycle_ms);
+
+  // A torque step has no Control() path: Split() must refuse it instead of hanging there.
+  bool torque_refused = false;
+  try {
+    ctrl::CommandSequence with_torque;
+    with_torque.Gripper(ctrl::EndEffectorAction::Close, 1.0).Torque({}, 1.0);
+    (void)with_torque.Split();
+  } catch (const wisson_SDK::CommandException&) {
+    torque_refused = true;
+  }
+  SPDLOG_INFO("[{}] torque step on the per-call path: {}", example_tag, torque_refused ? "refused" : "NOT REFUSED");
+  return split.failed + mixed.failed == 0 && torque_refused ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: online_trajectory_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: OnlineTrajectoryGenerator at a 1 kHz cycle with the velocity limits of
+ *        config.yaml. Step responses are compared with the analytic time of the
+ *        time-optimal rest-to-rest jerk-limited profile; a target sampled by a
+ *        30 Hz tracker is followed with and without its velocity. Reports the peak
+ *        velocity / acceleration / jerk relative to the limits, the time per
+ *        Step() and the heap allocations counted by replacing the global
+ *        operator new. Exits with 1 on a limit violation or an allocation.
+ *
+ * Usage: online_trajectory_benchmark [steps=1000000]
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <pthread.h>
+#include <string>
+
+//=== Third-party library headers ===//
+#include "perseuslib/common/latency_histogram.hpp"
+#include "perseuslib/controller/online_trajectory.hpp"
+#include "logging/perseus_log.h"
+#include "alloc_counter.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+using Clock = std::chrono::steady_clock;
+using wisson_SDK::JOINT_NUM;
+
+namespace {
+
+constexpr double kCycle = 0.001;
+constexpr double kLimitSlack = 1.0 + 1e-6;
+
+/**
+ * @brief Duration of the time-optimal rest-to-rest move over @p distance.
+ */
+double OptimalTime(double distance, double V, double A, double J)
+{
+  // Duration of a ramp from rest to velocity v (and back, by symmetry).
+  auto ramp = [&](double v) { return v * J >= A * A ? v / A + A / J : 2.0 * std::sqrt(v / J); };
+  distance = std::abs(distance);
+  if (distance >= V * ramp(V)) return 2.0 * ramp(V) + (distance - V * ramp(V)) / V;
+  double lo = 0.0, hi = V;
+  for (int i = 0; i < 100; ++i) {
+    const double mid = 0.5 * (lo + hi);
+    (mid * ramp(mid) < distance ? lo : hi) = mid;
+  }
+  return 2.0 * ramp(lo);
+}
+
+/**
+ * @brief Peak |velocity|, |acceleration| and |jerk| of a run relative to the limits.
+ */
+struct LimitUsage
+{
+  double velocity{0.0};
+  double acceleration{0.0};
+  double jerk{0.0};
+
+  void Add(const ctrl::TrajectoryPoint& prev, const ctrl::TrajectoryPoint& p, const ctrl::JerkLimits& l)
+  {
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      velocity = std::max(velocity, std::abs(p.velocity[j]) / l.max_velocity[j]);
+      acceleration = std::max(acceleration, std::abs(p.acceleration[j]) / l.max_acceleration[j]);
+      jerk = std::max(jerk, std::abs(p.acceleration[j] - prev.acceleration[j]) / kCycle / l.max_jerk[j]);
+    }
+  }
+  [[nodiscard]] bool Within() const { return velocity <= kLimitSlack && acceleration <= kLimitSlack && jerk <= kLimitSlack; }
+};
+
+/**
+ * @brief Sinusoidal motion of every joint, as a tracker would report it.
+ */
+void TrackedTarget(double t, const ctrl::JerkLimits& l, ctrl::JointVector& pos, ctrl::JointVector& vel)
+{
+  for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+    const double w = 2.0 * M_PI * (0.2 + 0.05 * static_cast<double>(j));
+    const double amp = 0.5 * l.max_velocity[j] / w;
+    pos[j] = amp * std::sin(w * t);
+    vel[j] = amp * w * std::cos(w * t);
+  }
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_OnlineTraj");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "OnlineTraj-Bench";
+
+  const long steps = argc > 1 ? std::stol(argv[1]) : 1'000'000;
+  const ctrl::JointVector velocity_max = {0.20, 90.0, 90.0, 90.0, 90.0, 90.0, 90.0, 90.0, 90.0};
+  const auto limits = ctrl::JerkLimits::FromVelocityLimits(velocity_max);
+  ctrl::OnlineTrajectoryGenerator otg(limits, kCycle);
+  bool ok = true;
+
+  // Step responses: joint 0 [m], joint 1 [deg].
+  SPDLOG_INFO("[{}] step response | distance | optimal [ms] | reached [ms] | gap [cycles] | v/vmax | a/amax | j/jmax",
+              example_tag);
+  for (const std::size_t joint : {std::size_t{0}, std::size_t{1}}) {
+    const double unit = joint == 0 ? 0.001 : 0.5;
+    for (const double distance : {unit, 20.0 * unit, 100.0 * unit, 600.0 * unit}) {
+      otg.Reset(ctrl::JointVector{});
+      ctrl::JointVector target{};
+      target[joint] = distance;
+      otg.SetTarget(target);
+      LimitUsage usage;
+      ctrl::TrajectoryPoint prev = otg.Current();
+      long cycles = 0;
+      while (!otg.Reached() && cycles < 100'000) {
+        const auto& p = otg.Step();
+        usage.Add(prev, p, limits);
+        prev = p;
+        ++cycles;
+      }
+      const double optimal_ms = 1e3 * OptimalTime(distance, limits.max_velocity[joint],
+                                                  limits.max_acceleration[joint], limits.max_jerk[joint]);
+      const double reached_ms = static_cast<double>(cycles) * kCycle * 1e3;
+      ok = ok && usage.Within();
+      SPDLOG_INFO("[{}] joint {}       | {:>8.3f} | {:>12.1f} | {:>12.1f} | {:>12.1f} | {:>6.4f} | {:>6.4f} | {:>6.4f}",
+                  example_tag, joint, distance, optimal_ms, reached_ms, (reached_ms - optimal_ms) / (kCycle * 1e3),
+                  usage.velocity, usage.acceleration, usage.jerk);
+    }
+  }
+
+  // Moving target sampled by a 30 Hz tracker, followed for 10 s; error over the last 5 s.
+  SPDLOG_INFO("[{}] 30 Hz tracker       | rms error j1 [deg] | max error j1 [deg] | v/vmax | a/amax | j/jmax", example_tag);
+  for (const bool feed_velocity : {false, true}) {
+    otg.Reset(ctrl::JointVector{});
+    LimitUsage usage;
+    ctrl::TrajectoryPoint prev = otg.Current();
+    ctrl::JointVector pos{}, vel{};
+    double sum_sq = 0.0, max_err = 0.0;
+    long samples = 0;
+    for (long k = 0; k < 10'000; ++k) {
+      const double t = static_cast<double>(k) * kCycle;
+      if (k % 33 == 0) {
+        TrackedTarget(t, limits, pos, vel);
+        if (feed_velocity) otg.SetTarget(pos, vel);
+        else otg.SetTarget(pos);
+      }
+      const auto& p = otg.Step();
+      usage.Add(prev, p, limits);
+      prev = p;
+      if (k >= 5'000) {
+        ctrl::JointVector truth_pos, truth_vel;
+        TrackedTarget(t + kCycle, limits, truth_pos, truth_vel);
+        const double err = std::abs(p.position[1] - truth_pos[1]);
+        sum_sq += err * err;
+        max_err = std::max(max_err, err);
+        ++samples;
+      }
+    }
+    ok = ok && usage.Within();
+    SPDLOG_INFO("[{}] {} | {:>18.3f} | {:>18.3f} | {:>6.4f} | {:>6.4f} | {:>6.4f}", example_tag,
+                feed_velocity ? "position + velocity" : "position only      ", std::sqrt(sum_sq / samples), max_err,
+                usage.velocity, usage.acceleration, usage.jerk);
+  }
+
+  // Target extrapolated into a position limit: it must stop there, and so must the joint.
+  {
+    auto bounded = limits;
+    bounded.position_max[1] = 50.0;
+    ctrl::OnlineTrajectoryGenerator stop_otg(bounded, kCycle);
+    stop_otg.Reset(ctrl::JointVector{});
+    ctrl::JointVector pos{}, vel{};
+    vel[1] = 0.8 * velocity_max[1];
+    stop_otg.SetTarget(pos, vel);
+    LimitUsage usage;
+    ctrl::TrajectoryPoint prev = stop_otg.Current();
+    double peak = 0.0;
+    for (long k = 0; k < 5'000; ++k) {
+      const auto& p = stop_otg.Step();
+      usage.Add(prev, p, bounded);
+      prev = p;
+      peak = std::max(peak, p.position[1]);
+    }
+    const bool stopped = stop_otg.Target()[1] == 50.0 && stop_otg.Current().velocity[1] == 0.0 &&
+                         peak <= bounded.position_max[1] * kLimitSlack;
+    ok = ok && usage.Within() && stopped;
+    SPDLOG_INFO("[{}] target into limit 50 deg at {:.0f} deg/s: peak {:.6f} deg, final target {:.3f} deg, {} | "
+                "v/vmax {:.4f} | a/amax {:.4f} | j/jmax {:.4f}", example_tag, vel[1], peak, stop_otg.Target()[1],
+                stopped ? "stopped at the limit" : "NOT STOPPED AT THE LIMIT", usage.velocity, usage.acceleration,
+                usage.jerk);
+  }
+
+  // Cost per cycle: a new target every 500 cycles, so most cycles are in motion.
+  wisson_SDK::timer::LatencyHistogram per_step;
+  otg.Reset(ctrl::JointVector{});
+  ctrl::JointVector target{};
+  double checksum = 0.0;
+  example::CountAllocations count;
+  const uint64_t allocations_before = example::Allocations();
+  const auto t0 = Clock::now();
+  for (long k = 0; k < steps; ++k) {
+    if (k % 500 == 0) {
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) target[j] = (k / 500 % 2 ? 1.0 : -1.0) * 3.0 * velocity_max[j];
+      otg.SetTarget(target);
+    }
+    const auto s0 = Clock::now();
+    checksum += otg.Step().position[1];
+    per_step.RecordNs(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - s0).count()));
+  }
+  const double total_ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+  const uint64_t allocations = example::Allocations() - allocations_before;
+  ok = ok && allocations == 0;
+
+  SPDLOG_INFO("[{}] Step() over {} cycles ({} joints): {:.0f} ns mean incl. timing, p99 {} ns, max {} ns, "
+              "{} allocations (checksum {:.3g})", example_tag, steps, JOINT_NUM, total_ns / static_cast<double>(steps),
+              per_step.PercentileNs(99.0), per_step.MaxNs(), allocations, checksum);
+  SPDLOG_INFO("[{}] {}", example_tag, ok ? "limits respected, no allocation" : "LIMIT VIOLATION OR ALLOCATION");
+  return ok ? 0 : 1;
+}
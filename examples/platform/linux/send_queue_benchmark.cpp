@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: send_queue_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Submission throughput from 1..8 user threads into a single io thread.
+ *        Compares the mutex + copied-vector hand-off with the lock-free SendQueue.
+ */
+
+//=== Standard library headers ===//
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <pthread.h>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/network/send_queue.hpp"
+#include "perseuslib/common/timer_utils.hpp"
+#include "logging/perseus_log.h"
+
+
+namespace {
+
+constexpr std::size_t kFramesPerThread = 200000;
+constexpr std::size_t kFrameSize = 512;
+
+/**
+ * Baseline: producers serialize on a mutex and hand over a copied vector,
+ * the io thread is notified once per frame.
+ */
+double RunMutexBaseline(std::size_t num_threads)
+{
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<std::vector<uint8_t>> queue;
+  const std::size_t total = num_threads * kFramesPerThread;
+
+  auto t0 = wisson_SDK::timer::TIC();
+  std::thread io([&] {
+    std::size_t written = 0;
+    uint64_t checksum = 0;
+    while (written < total) {
+      std::unique_lock<std::mutex> lock(mtx);
+      cv.wait(lock, [&] { return !queue.empty(); });
+      auto frame = std::move(queue.front());
+      queue.pop_front();
+      lock.unlock();
+      checksum += frame[0];
+      ++written;
+    }
+    (void)checksum;
+  });
+
+  std::vector<std::thread> producers;
+  const std::vector<uint8_t> payload(kFrameSize, 0x5A);
+  for (std::size_t t = 0; t < num_threads; ++t) {
+    producers.emplace_back([&] {
+      for (std::size_t i = 0; i < kFramesPerThread; ++i) {
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          queue.emplace_back(payload);
+        }
+        cv.notify_one();
+      }
+    });
+  }
+  for (auto& p : producers) p.join();
+  io.join();
+  return static_cast<double>(total) / wisson_SDK::timer::TOC(t0);
+}
+
+/**
+ * SendQueue: pooled buffers, lock-free submission, one wakeup per batch.
+ */
+double RunSendQueue(std::size_t num_threads, uint64_t& wakeups)
+{
+  wisson_SDK::network::SendQueue queue(256, kFrameSize);
+  std::binary_semaphore wake{0};
+  queue.SetWakeupHandler([&] { wake.release(); });
+  const std::size_t total = num_threads * kFramesPerThread;
+
+  auto t0 = wisson_SDK::timer::TIC();
+  std::thread io([&] {
+    std::size_t written = 0;
+    uint64_t checksum = 0;
+    while (written < total) {
+      wake.acquire();
+      written += queue.Drain([&](const wisson_SDK::network::FrameBuffer& buf) { checksum += buf.data[0]; });
+    }
+    (void)checksum;
+  });
+
+  std::vector<std::thread> producers;
+  const std::vector<uint8_t> payload(kFrameSize, 0x5A);
+  for (std::size_t t = 0; t < num_threads; ++t) {
+    producers.emplace_back([&] {
+      for (std::size_t i = 0; i < kFramesPerThread; ++i) {
+        while (!queue.Submit(payload.data(), payload.size())) {
+          std::this_thread::yield();  // pool exhausted: back-pressure
+        }
+      }
+    });
+  }
+  for (auto& p : producers) p.join();
+  io.join();
+  wakeups = queue.WakeupCount();
+  return static_cast<double>(total) / wisson_SDK::timer::TOC(t0);
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_SendQueue");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "SendQueue-Bench";
+
+  SPDLOG_INFO("[{}] {} frames/thread, {} bytes/frame", example_tag, kFramesPerThread, kFrameSize);
+  SPDLOG_INFO("[{}] threads | mutex+copy [frames/s] | send-queue [frames/s] | speedup | io wakeups", example_tag);
+  for (std::size_t n = 1; n <= 8; ++n) {
+    uint64_t wakeups = 0;
+    const double baseline = RunMutexBaseline(n);
+    const double lockfree = RunSendQueue(n, wakeups);
+    SPDLOG_INFO("[{}] {:>7} | {:>21.0f} | {:>22.0f} | {:>6.2f}x | {}",
+                example_tag, n, baseline, lockfree, lockfree / baseline, wakeups);
+  }
+  return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: setpoint_stream_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Closed-loop setpoint streaming at the state rate. A local stand-in server
+ *        streams states at 1 kHz; a servo callback answers each one with a joint
+ *        velocity, torque or impedance setpoint. Reports loop latency, deadline
+ *        misses, state-to-setpoint round trip and heap allocations per cycle.
+ *        Also checks that these modes are refused by the blocking Control() path,
+ *        which the prebuilt controller never completes for them; exits with 1 if not.
+ *
+ * Usage: setpoint_stream_benchmark [seconds=3] [deadline_us=500] [mode=velocity|torque|impedance]
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/controller.h"
+#include "perseuslib/controller/setpoint_stream.hpp"
+#include "logging/perseus_log.h"
+#include "alloc_counter.hpp"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+namespace net = wisson_SDK::network;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr std::size_t kStateFrameSize = sizeof(uint64_t) + sizeof(int64_t) + sizeof(wisson_SDK::RobotState);
+
+int64_t NowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+static_assert(ctrl::detail::IsControlModeSupported(ctrl::ControllerMode::JointPosition()));
+static_assert(ctrl::detail::IsControlModeSupported(ctrl::ControllerMode::TaskCommand()));
+static_assert(!ctrl::detail::IsControlModeSupported(ctrl::ControllerMode::JointVelocity()));
+static_assert(!ctrl::detail::IsControlModeSupported(ctrl::ControllerMode::JointTorque()));
+static_assert(!ctrl::detail::IsControlModeSupported(ctrl::ControllerMode::JointImpedance()));
+
+/**
+ * @brief True if the pre-flight of ControlAsync() refuses @p mode with a CommandException.
+ */
+bool RefusedByControl(const ctrl::ControllerMode& mode)
+{
+  try {
+    ctrl::detail::RequireControlMode(mode);
+  } catch (const wisson_SDK::CommandException&) {
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_Setpoint");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "SetpointStream-Bench";
+
+  const int seconds = argc > 1 ? std::stoi(argv[1]) : 3;
+  const int deadline_us = argc > 2 ? std::stoi(argv[2]) : 500;
+  const std::string mode_name = argc > 3 ? argv[3] : "velocity";
+  const auto mode = mode_name == "torque"    ? ctrl::ControllerMode::JointTorque()
+                  : mode_name == "impedance" ? ctrl::ControllerMode::JointImpedance()
+                                             : ctrl::ControllerMode::JointVelocity();
+
+  example::LoopbackListener listener;
+  std::atomic<bool> stop{false};
+  wisson_SDK::timer::LatencyHistogram round_trip;
+
+  // Stand-in server: 1 kHz states [seq | send time | RobotState]; measures the
+  // time until the setpoint computed from each state comes back.
+  std::thread server([&] {
+    auto conn = listener.Accept();
+    std::thread rx([&] {
+      std::vector<uint8_t> frame;
+      while (conn.RecvFrame(frame)) {
+        if (auto sp = net::DecodeSetpoint(frame.data(), frame.size())) {
+          round_trip.RecordNs(static_cast<uint64_t>(NowNs()) - sp->state_seq);
+        }
+      }
+    });
+    std::vector<uint8_t> frame(kStateFrameSize);
+    wisson_SDK::RobotState s{};
+    auto next = Clock::now();
+    for (uint64_t seq = 0; !stop.load(); ++seq) {
+      for (std::size_t j = 0; j < s.q.size(); ++j) s.q[j] = 0.3 * std::sin(1e-3 * static_cast<double>(seq) + j);
+      const int64_t t = NowNs();
+      std::memcpy(frame.data(), &seq, sizeof(seq));
+      std::memcpy(frame.data() + sizeof(seq), &t, sizeof(t));
+      std::memcpy(frame.data() + sizeof(seq) + sizeof(t), &s, sizeof(s));
+      if (!conn.SendFrame(frame.data(), static_cast<uint32_t>(frame.size()))) break;
+      next += std::chrono::milliseconds(1);
+      std::this_thread::sleep_until(next);
+    }
+    conn.ShutdownWrite();
+    rx.join();
+  });
+
+  auto client = example::LoopbackListener::Connect(listener.port());
+
+  // Servo towards a target seen by a camera: P-law on velocity, PD-law on torque,
+  // or a moving equilibrium with soft per-joint gains for compliant behaviours.
+  std::array<double, wisson_SDK::JOINT_NUM> target{};
+  const double kp = 5.0;
+  const double kd = 0.5;
+  std::array<double, wisson_SDK::JOINT_NUM> prev_q{};
+  ctrl::SetpointStreamConfig config;
+  config.deadline = std::chrono::microseconds(deadline_us);
+  ctrl::SetpointStreamer loop(
+    mode,
+    [&](const wisson_SDK::RobotState& s, net::Setpoint& sp) {
+      for (std::size_t j = 0; j < sp.values.size(); ++j) {
+        switch (sp.kind)
+        {
+          case net::SetpointKind::kTorque:    sp.values[j] = kp * (target[j] - s.q[j]) - kd * (s.q[j] - prev_q[j]) * 1e3; break;
+          case net::SetpointKind::kImpedance: sp.values[j] = target[j]; sp.stiffness[j] = 50.0; sp.damping[j] = 2.0; break;
+          default:                            sp.values[j] = kp * (target[j] - s.q[j]); break;
+        }
+      }
+      prev_q = s.q;
+      return true;
+    },
+    [&](const uint8_t* data, std::size_t size) { return client.SendFrame(data, static_cast<uint32_t>(size)); },
+    config);
+
+  // Client io thread: decode each state and run one loop cycle.
+  uint64_t steady_allocations = 0;
+  uint64_t steady_cycles = 0;
+  std::thread io([&] {
+    std::vector<uint8_t> frame;
+    frame.reserve(kStateFrameSize);
+    wisson_SDK::RobotState state{};
+    uint64_t cycles = 0;
+    uint64_t allocations_at_warmup = 0;
+    example::CountAllocations count;  // the client io thread only
+    while (client.RecvFrame(frame)) {
+      const auto arrival = Clock::now();
+      int64_t sent_ns = 0;
+      std::memcpy(&sent_ns, frame.data() + sizeof(uint64_t), sizeof(sent_ns));
+      std::memcpy(&state, frame.data() + sizeof(uint64_t) + sizeof(int64_t), sizeof(state));
+      // The send time doubles as the echoed state sequence for the round trip.
+      loop.OnState(state, static_cast<uint64_t>(sent_ns), arrival);
+      if (++cycles == 100) allocations_at_warmup = example::Allocations();
+    }
+    steady_allocations = example::Allocations() - allocations_at_warmup;
+    steady_cycles = cycles > 100 ? cycles - 100 : 0;
+  });
+
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  stop.store(true);
+  io.join();
+  client.ShutdownWrite();
+  server.join();
+
+  const auto& stats = loop.Stats();
+  SPDLOG_INFO("[{}] mode = {}, cycles = {}, deadline ({} us) misses = {}, missed states = {}, send failures = {}",
+              example_tag, loop.Mode().ModeToString(), stats.cycles.load(), deadline_us, stats.deadline_misses.load(),
+              stats.missed_states.load(), stats.send_failures.load());
+  SPDLOG_INFO("[{}] loop latency  : {}", example_tag, loop.Latency().SummaryUs());
+  SPDLOG_INFO("[{}] state period  : {}", example_tag, loop.Period().SummaryUs());
+  SPDLOG_INFO("[{}] round trip    : {}", example_tag, round_trip.SummaryUs());
+  SPDLOG_INFO("[{}] heap allocations in steady state: {} over {} cycles", example_tag, steady_allocations, steady_cycles);
+
+  const bool refused = RefusedByControl(ctrl::ControllerMode::JointVelocity()) &&
+                       RefusedByControl(ctrl::ControllerMode::JointTorque()) &&
+                       RefusedByControl(ctrl::ControllerMode::JointImpedance()) &&
+                       !RefusedByControl(ctrl::ControllerMode::JointPosition());
+  SPDLOG_INFO("[{}] velocity / torque / impedance on Control(): {}", example_tag,
+              refused ? "refused" : "NOT REFUSED");
+  return refused ? 0 : 1;
+}
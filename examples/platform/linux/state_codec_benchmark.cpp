@@ -0,0 +1,250 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: state_codec_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Bandwidth and decode time of the state stream encodings. A local stand-in
+ *        server streams recorded motion over TCP loopback as JSON, full binary
+ *        frames, and keyframe + delta frames. Also checks that a keyframe resyncs
+ *        a field that only a skipped delta carried; exits with 1 if it does not.
+ *
+ * Usage: state_codec_benchmark [recorded_q.csv]
+ *        The optional CSV holds one state per line (9 joint values, 1 kHz).
+ *        Without it, a taught pick-and-place motion is synthesized.
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <pthread.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include <json/json.h>
+#include "perseuslib/network/state_delta_codec.hpp"
+#include "perseuslib/common/timer_utils.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace net = wisson_SDK::network;
+
+namespace {
+
+std::vector<wisson_SDK::RobotState> LoadRecordedMotion(const char* csv_path)
+{
+  std::vector<std::array<double, wisson_SDK::JOINT_NUM>> qs;
+  if (csv_path != nullptr) {
+    std::ifstream in(csv_path);
+    std::string line;
+    while (std::getline(in, line)) {
+      std::array<double, wisson_SDK::JOINT_NUM> q{};
+      std::stringstream ss(line);
+      std::string cell;
+      std::size_t i = 0;
+      while (i < q.size() && std::getline(ss, cell, ',')) q[i++] = std::stod(cell);
+      if (i == q.size()) qs.push_back(q);
+    }
+  }
+  if (qs.empty()) {
+    // Synthesized: 10 s of moves between two taught poses with dwell phases.
+    const std::array<double, wisson_SDK::JOINT_NUM> a = {0.4280, 0.52, 0.70, -0.02, 0.03, 0.52, 0.52, 0.52, 0.09};
+    const std::array<double, wisson_SDK::JOINT_NUM> b = {0.4280, 0.52, 0.70, -0.02, 0.03, 0.52, 0.52, 0.00, 0.61};
+    for (int t = 0; t < 10000; ++t) {
+      const double phase = std::fmod(t / 2500.0, 2.0);
+      double s = phase < 1.0 ? phase : 2.0 - phase;
+      s = std::clamp((s - 0.2) / 0.6, 0.0, 1.0);
+      s = s * s * s * (10.0 - 15.0 * s + 6.0 * s * s);  // quintic blend
+      std::array<double, wisson_SDK::JOINT_NUM> q{};
+      for (std::size_t j = 0; j < q.size(); ++j) q[j] = a[j] + (b[j] - a[j]) * s;
+      qs.push_back(q);
+    }
+  }
+
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> hpa(-3, 3);
+  std::vector<wisson_SDK::RobotState> states(qs.size());
+  wisson_SDK::RobotState s{};
+  s.pressure.fill(1500);
+  s.pSource = 6000;
+  s.pSink = 300;
+  s.m_total = 1.2;
+  s.robot_mode = wisson_SDK::RobotMode::kCommandMove;
+  for (std::size_t i = 0; i < qs.size(); ++i) {
+    const auto prev_q = s.q;
+    s.q = qs[i];
+    for (std::size_t j = 0; j < s.q.size(); ++j) s.q_err[j] = 0.05 * (s.q[j] - prev_q[j]);
+    for (int& p : s.pressure) p += hpa(rng);
+    s.pSource += hpa(rng);
+    if (s.q != prev_q) {  // pose only refreshes while moving
+      s.O_T_EE = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, s.q[0], s.q[7] * 0.1, s.q[8] * 0.1, 1};
+    }
+    states[i] = s;
+  }
+  return states;
+}
+
+Json::Value StateToJson(const wisson_SDK::RobotState& s)
+{
+  Json::Value v;
+  for (double x : s.q) v["q"].append(x);
+  for (double x : s.q_err) v["q_err"].append(x);
+  for (int x : s.pressure) v["pressure"].append(x);
+  v["pSource"] = s.pSource;
+  v["pSink"] = s.pSink;
+  v["m_total"] = s.m_total;
+  for (double x : s.O_T_EE) v["O_T_EE"].append(x);
+  v["robot_mode"] = static_cast<int>(s.robot_mode);
+  return v;
+}
+
+void JsonToState(const Json::Value& v, wisson_SDK::RobotState& s)
+{
+  for (Json::ArrayIndex i = 0; i < s.q.size(); ++i) s.q[i] = v["q"][i].asDouble();
+  for (Json::ArrayIndex i = 0; i < s.q_err.size(); ++i) s.q_err[i] = v["q_err"][i].asDouble();
+  for (Json::ArrayIndex i = 0; i < s.pressure.size(); ++i) s.pressure[i] = v["pressure"][i].asInt();
+  s.pSource = v["pSource"].asInt();
+  s.pSink = v["pSink"].asInt();
+  s.m_total = v["m_total"].asDouble();
+  for (Json::ArrayIndex i = 0; i < s.O_T_EE.size(); ++i) s.O_T_EE[i] = v["O_T_EE"][i].asDouble();
+  s.robot_mode = static_cast<wisson_SDK::RobotMode>(v["robot_mode"].asInt());
+}
+
+enum class Encoding { kJson, kFullBinary, kDelta };
+
+struct Result
+{
+  double bytes_per_frame{0};
+  double decode_ns_per_frame{0};
+  double max_q_error{0};
+};
+
+Result Stream(const std::vector<wisson_SDK::RobotState>& motion, Encoding enc)
+{
+  example::LoopbackListener listener;
+
+  // Stand-in server: streams the recorded motion as fast as the socket takes it.
+  std::thread server([&] {
+    auto conn = listener.Accept();
+    net::StateDeltaEncoder encoder(enc == Encoding::kFullBinary ? 1 : net::kDefaultKeyframeInterval);
+    std::array<uint8_t, net::kMaxEncodedStateSize> buf{};
+    Json::StreamWriterBuilder writer;
+    writer["indentation"] = "";
+    for (const auto& s : motion) {
+      if (enc == Encoding::kJson) {
+        const std::string body = Json::writeString(writer, StateToJson(s));
+        conn.SendFrame(reinterpret_cast<const uint8_t*>(body.data()), static_cast<uint32_t>(body.size()));
+      } else {
+        const std::size_t n = encoder.Encode(s, net::kAllStateFields, buf.data(), buf.size());
+        conn.SendFrame(buf.data(), static_cast<uint32_t>(n));
+      }
+    }
+    conn.ShutdownWrite();
+  });
+
+  auto client = example::LoopbackListener::Connect(listener.port());
+  net::StateDeltaDecoder decoder;
+  net::SubscribedRobotState published;
+  std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+  std::vector<uint8_t> frame;
+  Result result;
+  double decode_s = 0.0;
+  std::size_t bytes = 0;
+  std::size_t i = 0;
+  while (client.RecvFrame(frame)) {
+    bytes += frame.size();
+    auto t0 = wisson_SDK::timer::TIC();
+    if (enc == Encoding::kJson) {
+      Json::Value v;
+      const char* begin = reinterpret_cast<const char*>(frame.data());
+      reader->parse(begin, begin + frame.size(), &v, nullptr);
+      JsonToState(v, published.state);
+    } else {
+      decoder.Decode(frame.data(), frame.size(), published);
+    }
+    decode_s += wisson_SDK::timer::TOC(t0);
+    for (std::size_t j = 0; j < wisson_SDK::JOINT_NUM; ++j) {
+      result.max_q_error = std::max(result.max_q_error, std::fabs(published.state.q[j] - motion[i].q[j]));
+    }
+    ++i;
+  }
+  server.join();
+
+  result.bytes_per_frame = static_cast<double>(bytes) / static_cast<double>(i);
+  result.decode_ns_per_frame = decode_s * 1e9 / static_cast<double>(i);
+  return result;
+}
+
+/**
+ * @brief Rate-limited pSource changed in a delta the client skipped (as StateIngestor
+ *        does before a newer keyframe); the next keyframe, although pSource is not
+ *        due in it, must bring the decoder back to the server's value.
+ * @return Decoded pSource after the last frame, or -1 if a frame was rejected.
+ */
+int SkippedDeltaResync()
+{
+  const auto q_and_psource = net::StateField::kQ | net::StateField::kPSource;
+  net::StateDeltaEncoder encoder;
+  std::array<std::array<uint8_t, net::kMaxEncodedStateSize>, 4> frames{};
+  std::array<std::size_t, 4> sizes{};
+  wisson_SDK::RobotState s{};
+  s.pSource = 50;
+  sizes[0] = encoder.Encode(s, q_and_psource, frames[0].data(), frames[0].size());   // keyframe
+  s.pSource = 100;
+  sizes[1] = encoder.Encode(s, q_and_psource, frames[1].data(), frames[1].size());   // delta, skipped
+  encoder.RequestKeyframe();
+  sizes[2] = encoder.Encode(s, static_cast<net::StateFieldMask>(net::StateField::kQ),
+                            frames[2].data(), frames[2].size());                       // forced keyframe
+  s.pSource = 150;
+  sizes[3] = encoder.Encode(s, q_and_psource, frames[3].data(), frames[3].size());   // delta
+
+  net::StateDeltaDecoder decoder;
+  net::SubscribedRobotState published;
+  for (const std::size_t i : {0u, 2u, 3u}) {
+    if (decoder.Decode(frames[i].data(), sizes[i], published) != net::StateDecodeResult::kOk) return -1;
+  }
+  return published.state.pSource;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_StateCodec");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "StateCodec-Bench";
+
+  const auto motion = LoadRecordedMotion(argc > 1 ? argv[1] : nullptr);
+  SPDLOG_INFO("[{}] Streaming {} recorded states through a loopback stand-in server", example_tag, motion.size());
+  SPDLOG_INFO("[{}] encoding      | bytes/frame | kbit/s @1kHz | decode [ns/frame] | max |q err|", example_tag);
+
+  const std::pair<const char*, Encoding> runs[] = {
+    {"json (legacy)", Encoding::kJson},
+    {"binary full  ", Encoding::kFullBinary},
+    {"key + delta  ", Encoding::kDelta},
+  };
+  for (const auto& [name, enc] : runs) {
+    const Result r = Stream(motion, enc);
+    SPDLOG_INFO("[{}] {} | {:>11.1f} | {:>12.1f} | {:>17.0f} | {:.2e}",
+                example_tag, name, r.bytes_per_frame, r.bytes_per_frame * 8.0, r.decode_ns_per_frame, r.max_q_error);
+  }
+
+  const int psource = SkippedDeltaResync();
+  const bool resynced = psource == 150;
+  SPDLOG_INFO("[{}] skipped delta, then keyframe: pSource {} (sent 150), {}", example_tag, psource,
+              resynced ? "resynced" : "DIVERGED");
+  return resynced ? 0 : 1;
+}
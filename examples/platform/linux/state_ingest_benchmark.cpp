@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: state_ingest_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Receive-to-publish latency of the state channel under CPU starvation.
+ *        A stand-in server streams JSON state frames at 1 kHz (plus occasional
+ *        command responses). The receiving thread shares one core with busy
+ *        threads and is periodically stalled. In-order ingestion is compared with
+ *        StateIngestor's newest-frame-only policy. A delta-encoded batch whose
+ *        skipped delta is the only carrier of a rate-limited field is checked
+ *        too; exits with 1 if the published state diverges.
+ *
+ * Usage: state_ingest_benchmark [hog_threads=3] [seconds=5]
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <pthread.h>
+#include <random>
+#include <sched.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include <json/json.h>
+#include "perseuslib/network/state_ingest.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace net = wisson_SDK::network;
+
+namespace {
+
+constexpr uint8_t kStateTag = 'S';
+constexpr uint8_t kResponseTag = 'R';
+constexpr std::size_t kHeaderSize = 1 + sizeof(int64_t);  // tag + send time [ns]
+
+int64_t NowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PinToCpu0()
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(0, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+std::string MakeStateBody(int64_t tick)
+{
+  Json::Value v;
+  for (int j = 0; j < 9; ++j) v["q"].append(0.001 * static_cast<double>(tick + j));
+  for (int j = 0; j < 9; ++j) v["q_err"].append(1e-5 * j);
+  for (int j = 0; j < 18; ++j) v["pressure"].append(1500 + static_cast<int>(tick % 7));
+  v["pSource"] = 6000;
+  v["pSink"] = 300;
+  v["m_total"] = 1.2;
+  for (int j = 0; j < 16; ++j) v["O_T_EE"].append(j % 5 == 0 ? 1.0 : 0.0);
+  Json::StreamWriterBuilder writer;
+  writer["indentation"] = "";
+  return Json::writeString(writer, v);
+}
+
+struct Result
+{
+  double p50_ms{0}, p99_ms{0}, max_ms{0};
+  uint64_t decoded{0}, superseded{0}, max_backlog{0};
+};
+
+Result Run(bool newest_only, int hog_threads, int seconds)
+{
+  example::LoopbackListener listener;
+  std::atomic<bool> stop{false};
+
+  // Stand-in server: 1 kHz state stream, a command response every 100 frames.
+  std::thread server([&] {
+    auto conn = listener.Accept();
+    const std::string body = MakeStateBody(0);
+    std::vector<uint8_t> frame(kHeaderSize + body.size());
+    std::memcpy(frame.data() + kHeaderSize, body.data(), body.size());
+    auto next = std::chrono::steady_clock::now();
+    for (int64_t tick = 0; !stop.load(); ++tick) {
+      frame[0] = (tick % 100 == 99) ? kResponseTag : kStateTag;
+      const int64_t now = NowNs();
+      std::memcpy(frame.data() + 1, &now, sizeof(now));
+      if (!conn.SendFrame(frame.data(), static_cast<uint32_t>(frame.size()))) break;
+      next += std::chrono::milliseconds(1);
+      std::this_thread::sleep_until(next);
+    }
+  });
+
+  // CPU hogs sharing core 0 with the receiving thread.
+  std::vector<std::thread> hogs;
+  for (int i = 0; i < hog_threads; ++i) {
+    hogs.emplace_back([&] {
+      PinToCpu0();
+      volatile uint64_t x = 0;
+      while (!stop.load(std::memory_order_relaxed)) x = x + 1;
+    });
+  }
+
+  std::vector<double> latencies_ms;
+  net::StateIngestor ingestor;
+  uint64_t decoded_in_order = 0;
+  {
+    PinToCpu0();
+    auto conn = example::LoopbackListener::Connect(listener.port());
+    std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> stall_ms(0, 20);
+    std::vector<uint8_t> rx;
+    std::vector<net::FrameView> frames;
+    wisson_SDK::RobotState published{};
+    int64_t published_send_ns = 0;
+
+    auto decode = [&](const net::FrameView& f) {
+      Json::Value v;
+      const char* begin = reinterpret_cast<const char*>(f.data + kHeaderSize);
+      reader->parse(begin, begin + (f.size - kHeaderSize), &v, nullptr);
+      for (Json::ArrayIndex j = 0; j < published.q.size(); ++j) published.q[j] = v["q"][j].asDouble();
+      for (Json::ArrayIndex j = 0; j < published.pressure.size(); ++j) published.pressure[j] = v["pressure"][j].asInt();
+      std::memcpy(&published_send_ns, f.data + 1, sizeof(published_send_ns));
+    };
+    auto classify = [](const net::FrameView& f) {
+      return f.data[0] == kStateTag ? net::FrameClass::kState : net::FrameClass::kOther;
+    };
+
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+      // Simulated stall of the io thread (e.g. a long callback or a preempting task).
+      if (stall_ms(rng) == 0) {
+        const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(stall_ms(rng) + 5);
+        while (std::chrono::steady_clock::now() < until) {}
+      }
+      if (conn.RecvAvailable(rx) < 0) break;
+      frames.clear();
+      const std::size_t consumed = example::SplitFrames(rx, [&](const uint8_t* data, uint32_t size) {
+        frames.push_back({data, size});
+      });
+      if (frames.empty()) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      published_send_ns = 0;
+      if (newest_only) {
+        ingestor.ProcessBatch(frames, classify, decode, [](const net::FrameView&) {});
+      } else {
+        for (const auto& f : frames) {
+          if (classify(f) == net::FrameClass::kState) {
+            decode(f);
+            ++decoded_in_order;
+          }
+        }
+      }
+      if (published_send_ns != 0) {
+        latencies_ms.push_back(static_cast<double>(NowNs() - published_send_ns) * 1e-6);
+      }
+      rx.erase(rx.begin(), rx.begin() + static_cast<std::ptrdiff_t>(consumed));
+    }
+  }
+
+  stop.store(true);
+  for (auto& h : hogs) h.join();
+  server.join();
+
+  Result r;
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  if (!latencies_ms.empty()) {
+    r.p50_ms = latencies_ms[latencies_ms.size() / 2];
+    r.p99_ms = latencies_ms[latencies_ms.size() * 99 / 100];
+    r.max_ms = latencies_ms.back();
+  }
+  r.decoded = newest_only ? ingestor.Stats().decoded.load() : decoded_in_order;
+  r.superseded = ingestor.Stats().superseded.load();
+  r.max_backlog = ingestor.Stats().max_backlog.load();
+  return r;
+}
+
+/**
+ * @brief One batch: keyframe{q, pSource}, delta(pSource 100), forced keyframe with only
+ *        q due, delta(pSource 150). The first two are skipped; the published pSource
+ *        must still be 150.
+ * @return Published pSource, or -1 if a decoded frame was rejected or nothing was skipped.
+ */
+int DeltaBatchResync()
+{
+  const auto q_and_psource = net::StateField::kQ | net::StateField::kPSource;
+  net::StateDeltaEncoder encoder;
+  std::vector<std::vector<uint8_t>> encoded;
+  auto encode = [&](const wisson_SDK::RobotState& s, net::StateFieldMask due) {
+    std::vector<uint8_t> buf(net::kMaxEncodedStateSize);
+    buf.resize(encoder.Encode(s, due, buf.data(), buf.size()));
+    encoded.push_back(std::move(buf));
+  };
+  wisson_SDK::RobotState s{};
+  s.pSource = 50;
+  encode(s, q_and_psource);
+  s.pSource = 100;
+  encode(s, q_and_psource);
+  encoder.RequestKeyframe();
+  encode(s, static_cast<net::StateFieldMask>(net::StateField::kQ));
+  s.pSource = 150;
+  encode(s, q_and_psource);
+
+  std::vector<net::FrameView> frames;
+  for (const auto& e : encoded) frames.push_back({e.data(), e.size()});
+  net::StateIngestor ingestor;
+  net::StateDeltaDecoder decoder;
+  net::SubscribedRobotState published;
+  bool rejected = false;
+  ingestor.ProcessBatch(frames, net::ClassifyDeltaStateFrame, [&](const net::FrameView& f) {
+    rejected = rejected || decoder.Decode(f.data, f.size, published) != net::StateDecodeResult::kOk;
+  }, [](const net::FrameView&) {});
+  if (rejected || ingestor.Stats().superseded.load() != 2) return -1;
+  return published.state.pSource;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_Ingest");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "StateIngest-Bench";
+
+  const int hog_threads = argc > 1 ? std::stoi(argv[1]) : 3;
+  const int seconds = argc > 2 ? std::stoi(argv[2]) : 5;
+  SPDLOG_INFO("[{}] 1 kHz JSON state stream, {} hog thread(s) on the io core, {} s per run",
+              example_tag, hog_threads, seconds);
+  SPDLOG_INFO("[{}] policy      | p50 [ms] | p99 [ms] | max [ms] | decoded | superseded | max backlog", example_tag);
+
+  for (bool newest_only : {false, true}) {
+    const Result r = Run(newest_only, hog_threads, seconds);
+    SPDLOG_INFO("[{}] {} | {:>8.2f} | {:>8.2f} | {:>8.2f} | {:>7} | {:>10} | {:>11}",
+                example_tag, newest_only ? "newest-only" : "in-order   ",
+                r.p50_ms, r.p99_ms, r.max_ms, r.decoded, r.superseded, r.max_backlog);
+  }
+
+  const int psource = DeltaBatchResync();
+  const bool resynced = psource == 150;
+  SPDLOG_INFO("[{}] delta batch, skipped delta carried pSource: published {} (sent 150), {}", example_tag,
+              psource, resynced ? "resynced" : "DIVERGED");
+  return resynced ? 0 : 1;
+}
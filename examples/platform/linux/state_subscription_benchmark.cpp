@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: state_subscription_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Bandwidth and client decode load of field-subset, rate-controlled state
+ *        subscriptions. A local stand-in server decodes the subscription request,
+ *        then streams 10 s of 1 kHz state over TCP loopback, sending only the
+ *        fields that are due in each base-stream tick. Both ends are local:
+ *        the shipped state client does not send subscriptions yet.
+ *
+ * Usage: state_subscription_benchmark
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include <json/json.h>
+#include "perseuslib/network/state_subscription.hpp"
+#include "perseuslib/common/timer_utils.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace net = wisson_SDK::network;
+
+namespace {
+
+constexpr int kTicks = 10000;  // 10 s of the 1 kHz base stream
+
+wisson_SDK::RobotState SynthesizedState(int tick)
+{
+  wisson_SDK::RobotState s{};
+  const double t = tick * 1e-3;
+  for (std::size_t j = 0; j < s.q.size(); ++j) {
+    s.q[j] = 0.3 * std::sin(0.5 * t + 0.2 * static_cast<double>(j));
+    s.q_err[j] = 1e-3 * std::cos(0.5 * t);
+  }
+  for (std::size_t j = 0; j < s.pressure.size(); ++j) s.pressure[j] = 1500 + (tick + static_cast<int>(j)) % 7;
+  s.pSource = 6000 + tick % 5;
+  s.pSink = 300;
+  s.m_total = 1.2;
+  s.O_T_EE = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, s.q[0], s.q[7] * 0.1, s.q[8] * 0.1, 1};
+  s.robot_mode = wisson_SDK::RobotMode::kCommandMove;
+  return s;
+}
+
+/**
+ * @brief Legacy JSON state body restricted to the fields in @p mask.
+ */
+Json::Value StateToJson(const wisson_SDK::RobotState& s, net::StateFieldMask mask)
+{
+  Json::Value v(Json::objectValue);
+  if (net::HasField(mask, net::StateField::kQ))        for (double x : s.q) v["q"].append(x);
+  if (net::HasField(mask, net::StateField::kQErr))     for (double x : s.q_err) v["q_err"].append(x);
+  if (net::HasField(mask, net::StateField::kPressure)) for (int x : s.pressure) v["pressure"].append(x);
+  if (net::HasField(mask, net::StateField::kPSource))  v["pSource"] = s.pSource;
+  if (net::HasField(mask, net::StateField::kPSink))    v["pSink"] = s.pSink;
+  if (net::HasField(mask, net::StateField::kMTotal))   v["m_total"] = s.m_total;
+  if (net::HasField(mask, net::StateField::kOTEE))     for (double x : s.O_T_EE) v["O_T_EE"].append(x);
+  if (net::HasField(mask, net::StateField::kRobotMode)) v["robot_mode"] = static_cast<int>(s.robot_mode);
+  return v;
+}
+
+/**
+ * @brief Parse the fields present in @p v into @p s.
+ * @return Mask of the fields found.
+ */
+net::StateFieldMask JsonToState(const Json::Value& v, wisson_SDK::RobotState& s)
+{
+  net::StateFieldMask mask = 0;
+  if (v.isMember("q")) {
+    for (Json::ArrayIndex i = 0; i < s.q.size(); ++i) s.q[i] = v["q"][i].asDouble();
+    mask |= net::StateField::kQ;
+  }
+  if (v.isMember("q_err")) {
+    for (Json::ArrayIndex i = 0; i < s.q_err.size(); ++i) s.q_err[i] = v["q_err"][i].asDouble();
+    mask |= net::StateField::kQErr;
+  }
+  if (v.isMember("pressure")) {
+    for (Json::ArrayIndex i = 0; i < s.pressure.size(); ++i) s.pressure[i] = v["pressure"][i].asInt();
+    mask |= net::StateField::kPressure;
+  }
+  if (v.isMember("pSource")) { s.pSource = v["pSource"].asInt(); mask |= net::StateField::kPSource; }
+  if (v.isMember("pSink")) { s.pSink = v["pSink"].asInt(); mask |= net::StateField::kPSink; }
+  if (v.isMember("m_total")) { s.m_total = v["m_total"].asDouble(); mask |= net::StateField::kMTotal; }
+  if (v.isMember("O_T_EE")) {
+    for (Json::ArrayIndex i = 0; i < s.O_T_EE.size(); ++i) s.O_T_EE[i] = v["O_T_EE"][i].asDouble();
+    mask |= net::StateField::kOTEE;
+  }
+  if (v.isMember("robot_mode")) {
+    s.robot_mode = static_cast<wisson_SDK::RobotMode>(v["robot_mode"].asInt());
+    mask |= net::StateField::kRobotMode;
+  }
+  return mask;
+}
+
+struct Result
+{
+  std::size_t frames{0};
+  double kbit_per_s{0};
+  double decode_ms_per_s{0};
+  double q_updates_per_s{0};
+  double pressure_updates_per_s{0};
+};
+
+Result Stream(const net::StateSubscription& requested)
+{
+  example::LoopbackListener listener;
+  Json::StreamWriterBuilder writer;
+  writer["indentation"] = "";
+
+  // Stand-in server: decodes the request, then decimates the base stream per group.
+  std::thread server([&] {
+    auto conn = listener.Accept();
+    std::vector<uint8_t> request;
+    if (!conn.RecvFrame(request)) return;
+    Json::Value body;
+    std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+    const char* begin = reinterpret_cast<const char*>(request.data());
+    reader->parse(begin, begin + request.size(), &body, nullptr);
+    const auto sub = net::StateSubscription::FromJson(body);
+    for (int tick = 0; tick < kTicks; ++tick) {
+      const net::StateFieldMask due = sub.FieldsDue(static_cast<uint64_t>(tick));
+      if (due == 0) continue;
+      Json::Value frame = StateToJson(SynthesizedState(tick), due);
+      frame["seq"] = Json::UInt64(tick);
+      const std::string out = Json::writeString(writer, frame);
+      conn.SendFrame(reinterpret_cast<const uint8_t*>(out.data()), static_cast<uint32_t>(out.size()));
+    }
+    conn.ShutdownWrite();
+  });
+
+  auto client = example::LoopbackListener::Connect(listener.port());
+  const std::string request = Json::writeString(writer, requested.ToJson());
+  client.SendFrame(reinterpret_cast<const uint8_t*>(request.data()), static_cast<uint32_t>(request.size()));
+
+  std::unique_ptr<Json::CharReader> reader(Json::CharReaderBuilder().newCharReader());
+  net::SubscribedRobotState published;
+  wisson_SDK::RobotState scratch{};
+  std::vector<uint8_t> frame;
+  Result result;
+  std::size_t bytes = 0;
+  std::size_t q_updates = 0;
+  std::size_t pressure_updates = 0;
+  double decode_s = 0.0;
+  while (client.RecvFrame(frame)) {
+    bytes += frame.size() + sizeof(uint32_t);
+    auto t0 = wisson_SDK::timer::TIC();
+    Json::Value v;
+    const char* begin = reinterpret_cast<const char*>(frame.data());
+    reader->parse(begin, begin + frame.size(), &v, nullptr);
+    const net::StateFieldMask fields = JsonToState(v, scratch);
+    published.Merge(scratch, fields, v["seq"].asUInt64());
+    decode_s += wisson_SDK::timer::TOC(t0);
+    q_updates += published.IsUpdated(net::StateField::kQ) ? 1 : 0;
+    pressure_updates += published.IsUpdated(net::StateField::kPressure) ? 1 : 0;
+    ++result.frames;
+  }
+  server.join();
+
+  const double seconds = kTicks * 1e-3;
+  result.kbit_per_s = static_cast<double>(bytes) * 8.0 / 1000.0 / seconds;
+  result.decode_ms_per_s = decode_s * 1e3 / seconds;
+  result.q_updates_per_s = static_cast<double>(q_updates) / seconds;
+  result.pressure_updates_per_s = static_cast<double>(pressure_updates) / seconds;
+  return result;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_StateSub");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "StateSub-Bench";
+
+  const std::pair<const char*, net::StateSubscription> runs[] = {
+    {"full stream (legacy)    ", net::StateSubscription()},
+    {"q @1kHz                 ", net::StateSubscription().Add(net::StateField::kQ, 1000)},
+    {"q @1kHz + pressure @50Hz", net::StateSubscription()
+                                  .Add(net::StateField::kQ, 1000)
+                                  .Add(net::StateField::kPressure | net::StateField::kPSource | net::StateField::kPSink, 50)},
+    {"q @100Hz + O_T_EE @100Hz", net::StateSubscription().Add(net::StateField::kQ | net::StateField::kOTEE, 100)},
+  };
+
+  SPDLOG_INFO("[{}] {} s of the {} Hz base stream over a loopback stand-in server", example_tag,
+              kTicks / 1000, net::kStateBaseRateHz);
+  SPDLOG_INFO("[{}] subscription             | frames | kbit/s | decode [ms/s] | q [Hz] | pressure [Hz]", example_tag);
+  for (const auto& [name, sub] : runs) {
+    const Result r = Stream(sub);
+    SPDLOG_INFO("[{}] {} | {:>6} | {:>6.0f} | {:>13.2f} | {:>6.0f} | {:>13.0f}", example_tag, name, r.frames,
+                r.kbit_per_s, r.decode_ms_per_s, r.q_updates_per_s, r.pressure_updates_per_s);
+  }
+
+  // A request with an out-of-range rate is refused as a protocol error.
+  Json::Value bad;
+  Json::Value item;
+  item["Fields"] = Json::UInt(net::kAllStateFields);
+  item["RateHz"] = Json::UInt(0);
+  bad["Subscription"].append(item);
+  try {
+    (void)net::StateSubscription::FromJson(bad);
+    SPDLOG_ERROR("[{}] malformed request was accepted", example_tag);
+    return 1;
+  } catch (const wisson_SDK::ProtocolException& e) {
+    SPDLOG_INFO("[{}] malformed request refused: {}", example_tag, e.what());
+  }
+  return 0;
+}
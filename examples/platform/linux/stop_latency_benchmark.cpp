@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: stop_latency_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Stop-issue-to-acknowledgement latency while a producer keeps the send
+ *        queue saturated with 20-waypoint command frames. A stop frame queued
+ *        behind the regular traffic is compared with one sent on the priority
+ *        lane. The io thread paces its writes to a fixed link rate, so the backlog
+ *        sits in the SDK queue as on a link that is slower than the producer.
+ *        Each stop ends a blocking Control() stand-in through the command in
+ *        flight; exits with 1 if one is finished without an acknowledged stop.
+ *
+ * Usage: stop_latency_benchmark [stops=200] [link_mbps=100]
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <pthread.h>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/stop_channel.hpp"
+#include "perseuslib/network/send_queue.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+namespace net = wisson_SDK::network;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Result
+{
+  uint64_t p50_us{0};
+  uint64_t p99_us{0};
+  uint64_t max_us{0};
+  int preempted{0};
+  int failed{0};
+  int wrong{0};   ///< Command finished without an accepted stop, or left running after one.
+  double frames_per_s{0};
+};
+
+/**
+ * @brief Stand-in server: discards command frames and acknowledges stop frames
+ *        as soon as they are read. The client io thread writes at @p link_mbps.
+ */
+Result Run(bool priority_lane, int stops, double link_mbps)
+{
+  example::LoopbackListener listener;
+  std::thread server([&] {
+    auto conn = listener.Accept();
+    std::vector<uint8_t> frame;
+    std::array<uint8_t, net::kCommandResponseSize> ack;
+    while (conn.RecvFrame(frame)) {
+      if (auto stop = net::DecodeStopFrame(frame.data(), frame.size())) {
+        net::EncodeCommandResponse({stop->stop_id, ctrl::ResponseStatus::kUserStop, 0}, ack);
+        conn.SendFrame(ack.data(), ack.size());
+      }
+    }
+    conn.ShutdownWrite();
+  });
+
+  auto client = example::LoopbackListener::Connect(listener.port());
+
+  net::SendQueue queue;
+  std::counting_semaphore<> wake{0};
+  queue.SetWakeupHandler([&] { wake.release(); });
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> written{0};
+  std::thread io([&] {
+    while (true) {
+      wake.acquire();
+      if (done.load()) break;
+      queue.Drain([&](const net::FrameBuffer& buf) {
+        client.SendFrame(buf.data, static_cast<uint32_t>(buf.size));
+        std::this_thread::sleep_for(std::chrono::duration<double, std::micro>(buf.size * 8 / link_mbps));
+        written.fetch_add(1, std::memory_order_relaxed);
+      });
+    }
+  });
+
+  // Saturating producer: backs off briefly whenever the pool is exhausted.
+  std::vector<ctrl::MotionCommand> path(ctrl::cmd_list_size,
+                                        ctrl::MotionCommand::CreateCommand({0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0}, 1.0));
+  auto cmd = ctrl::RobotCommand::CreateCommands(path);
+  std::vector<uint8_t> cmd_frame;
+  net::EncodeCommandFrame(*cmd, ctrl::ControllerMode::JointPosition(), cmd_frame);
+  std::thread producer([&] {
+    while (!done.load()) {
+      if (!queue.Submit(cmd_frame.data(), cmd_frame.size())) std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  });
+
+  // Normal lane: the stop frame waits for a pool buffer like any other frame.
+  auto send_stop = [&](const uint8_t* data, std::size_t size) {
+    if (priority_lane) return queue.SubmitUrgent(data, size);
+    while (!queue.Submit(data, size)) std::this_thread::sleep_for(std::chrono::microseconds(50));
+    return true;
+  };
+  Result r;
+  std::shared_ptr<ctrl::RobotCommand> running;
+  ctrl::StopChannel channel(send_stop);
+  std::thread rx([&] {
+    std::vector<uint8_t> msg;
+    while (client.RecvFrame(msg)) {
+      if (auto resp = net::DecodeCommandResponse(msg.data(), msg.size())) channel.OnResponse(resp->cmd_id, resp->status);
+    }
+    channel.Abort();
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));  // let the queue fill up
+  const auto t0 = Clock::now();
+  const uint64_t written0 = written.load();
+  for (int i = 0; i < stops; ++i) {
+    running = ctrl::RobotCommand::CreateCommands(path);
+    // Stand-in for a Control(mode, running) blocking on another thread: it returns
+    // once the command is finished.
+    std::thread control([cmd = running] {
+      while (!cmd->finished) std::this_thread::sleep_for(std::chrono::microseconds(50));
+    });
+    bool acked = true;
+    try {
+      channel.Stop(*running, ctrl::kAllResources, std::chrono::seconds(1));
+    } catch (const wisson_SDK::NetworkException&) {
+      acked = false;
+      ++r.failed;
+    }
+    // Finished exactly when the server accepted the stop.
+    if (running->finished == acked) ++r.preempted;
+    else ++r.wrong;
+    if (!acked) ctrl::detail::PreemptCommand(*running);  // release the stand-in
+    control.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  r.frames_per_s = static_cast<double>(written.load() - written0) /
+                   std::chrono::duration<double>(Clock::now() - t0).count();
+
+  done = true;
+  producer.join();
+  wake.release();
+  io.join();
+  client.ShutdownWrite();
+  server.join();
+  rx.join();
+
+  const auto& h = channel.AckLatency();
+  r.p50_us = h.PercentileNs(50.0) / 1000;
+  r.p99_us = h.PercentileNs(99.0) / 1000;
+  r.max_us = h.MaxNs() / 1000;
+  return r;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_Stop");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "Stop-Bench";
+
+  const int stops = argc > 1 ? std::stoi(argv[1]) : 200;
+  const double link_mbps = argc > 2 ? std::stod(argv[2]) : 100.0;
+  SPDLOG_INFO("[{}] {} stops under a saturated send queue ({} frames of {} B), link {} Mbit/s",
+              example_tag, stops, net::kDefaultFramePoolSize,
+              net::CommandFrameSize(net::SetpointKind::kPosition, ctrl::cmd_list_size), link_mbps);
+  SPDLOG_INFO("[{}] stop path      | p50 [us] | p99 [us] | max [us] | preempted | unacked | frames/s", example_tag);
+
+  auto print = [&](const char* name, const Result& r) {
+    SPDLOG_INFO("[{}] {} | {:>8} | {:>8} | {:>8} | {:>9} | {:>7} | {:>8.0f}", example_tag, name, r.p50_us,
+                r.p99_us, r.max_us, r.preempted, r.failed, r.frames_per_s);
+  };
+  const Result queued = Run(false, stops, link_mbps);
+  print("regular queue ", queued);
+  const Result urgent = Run(true, stops, link_mbps);
+  print("priority lane ", urgent);
+  SPDLOG_INFO("[{}] p99 reduction {:.1f}x", example_tag,
+              static_cast<double>(queued.p99_us) / static_cast<double>(std::max<uint64_t>(urgent.p99_us, 1)));
+  return queued.wrong + urgent.wrong == 0 ? 0 : 1;
+}
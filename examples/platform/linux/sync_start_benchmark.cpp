@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: sync_start_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Start skew of four arm commands on two robots (local stand-in servers
+ *        with their own clocks and a random handling delay per frame). Separate
+ *        Control-style calls are compared with a StartGroup triggered on receipt
+ *        and with a clock-synchronized StartGroup. The true skew is taken from the
+ *        servers, the reported skew from StartGroup::WaitStarted(). Finally a
+ *        group whose staging times out must be withdrawn without any start.
+ *
+ * Usage: sync_start_benchmark [trials=50] [jitter_us=2000]
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <random>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/common/latency_histogram.hpp"
+#include "perseuslib/controller/sync_start.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+namespace net = wisson_SDK::network;
+using wisson_SDK::timer::SteadyNowNs;
+
+namespace {
+
+/**
+ * @brief Stand-in robot server with its own clock (steady clock + offset) that
+ *        handles every command frame after a random delay of up to jitter_us.
+ */
+class StandInRobot
+{
+public:
+  StandInRobot(int64_t clock_offset_ns, int jitter_us, uint32_t seed)
+    : offset_(clock_offset_ns), jitter_us_(jitter_us), rng_(seed)
+  {
+    thread_ = std::thread([this] { Serve(); });
+  }
+
+  ~StandInRobot() { thread_.join(); }
+
+  uint16_t port() const { return listener_.port(); }
+
+  /**
+   * @brief True start times (local clock) of the commands started since the last call.
+   */
+  std::vector<int64_t> TakeStarts()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::exchange(starts_, {});
+  }
+
+private:
+  int64_t Now() const { return SteadyNowNs() + offset_; }
+
+  void HandlingDelay()
+  {
+    std::uniform_int_distribution<int> d(0, jitter_us_);
+    std::this_thread::sleep_for(std::chrono::microseconds(d(rng_)));
+  }
+
+  void Start(example::LoopbackStream& conn, uint32_t group_id, uint32_t cmd_id)
+  {
+    const int64_t t = Now();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      starts_.push_back(t - offset_);
+    }
+    std::array<uint8_t, net::kStartedSize> started;
+    net::EncodeStarted({group_id, cmd_id, t}, started);
+    conn.SendFrame(started.data(), started.size());
+  }
+
+  void Respond(example::LoopbackStream& conn, uint32_t cmd_id,
+               ctrl::ResponseStatus status = ctrl::ResponseStatus::kWaiting)
+  {
+    std::array<uint8_t, net::kCommandResponseSize> resp;
+    net::EncodeCommandResponse({cmd_id, status, 0}, resp);
+    conn.SendFrame(resp.data(), resp.size());
+  }
+
+  void Serve()
+  {
+    auto conn = listener_.Accept();
+    std::vector<uint8_t> frame;
+    std::vector<uint32_t> staged;
+    while (conn.RecvFrame(frame)) {
+      const int64_t received = Now();
+      if (auto probe = net::DecodeClockProbe(frame.data(), frame.size())) {
+        std::array<uint8_t, net::kClockAnswerSize> answer;
+        net::EncodeClockAnswer({probe->seq, probe->t0, received, Now()}, answer);
+        conn.SendFrame(answer.data(), answer.size());
+      } else if (auto stage = net::DecodeStageFrame(frame.data(), frame.size())) {
+        HandlingDelay();
+        auto cmd = net::DecodeCommandFrame(stage->command, stage->command_size);
+        staged.push_back(cmd->cmd_id);
+        Respond(conn, cmd->cmd_id);
+      } else if (auto trigger = net::DecodeTrigger(frame.data(), frame.size())) {
+        if (trigger->start_ns == 0) {
+          HandlingDelay();
+        } else {
+          std::this_thread::sleep_for(std::chrono::nanoseconds(trigger->start_ns - Now()));
+        }
+        for (uint32_t id : staged) Start(conn, trigger->group_id, id);
+        staged.clear();
+      } else if (net::DecodeWithdraw(frame.data(), frame.size())) {
+        for (uint32_t id : staged) Respond(conn, id, ctrl::ResponseStatus::kUserStop);
+        staged.clear();
+      } else if (auto cmd = net::DecodeCommandFrame(frame.data(), frame.size())) {
+        HandlingDelay();
+        Start(conn, 0, cmd->cmd_id);
+        Respond(conn, cmd->cmd_id);
+      }
+    }
+    conn.ShutdownWrite();
+  }
+
+private:
+  example::LoopbackListener listener_;
+  const int64_t offset_;
+  const int jitter_us_;
+  std::mt19937 rng_;
+  std::mutex mutex_;
+  std::vector<int64_t> starts_;
+  std::thread thread_;
+};
+
+
+/**
+ * @brief Client side of one robot connection.
+ */
+struct RobotLink
+{
+  explicit RobotLink(uint16_t port) : conn(example::LoopbackListener::Connect(port))
+  {
+    rx = std::thread([this] { Receive(); });
+  }
+
+  ~RobotLink()
+  {
+    conn.ShutdownWrite();
+    rx.join();
+  }
+
+  bool Send(const uint8_t* data, std::size_t size)
+  {
+    std::lock_guard<std::mutex> lock(send_mutex);
+    return conn.SendFrame(data, static_cast<uint32_t>(size));
+  }
+
+  void SyncClock(int probes)
+  {
+    for (int i = 0; i < probes; ++i) {
+      std::array<uint8_t, net::kClockProbeSize> probe;
+      net::EncodeClockProbe({static_cast<uint32_t>(i), SteadyNowNs()}, probe);
+      Send(probe.data(), probe.size());
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  void Receive()
+  {
+    std::vector<uint8_t> msg;
+    while (conn.RecvFrame(msg)) {
+      const int64_t arrival = SteadyNowNs();
+      if (auto a = net::DecodeClockAnswer(msg.data(), msg.size())) {
+        clock.AddSample(a->t0, a->t1, a->t2, arrival);
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(group_mutex);
+      if (auto s = net::DecodeStarted(msg.data(), msg.size())) {
+        if (group != nullptr) group->OnStarted(*s, arrival);
+      } else if (auto r = net::DecodeCommandResponse(msg.data(), msg.size())) {
+        if (r->status == ctrl::ResponseStatus::kUserStop) continue;   // withdrawn
+        if (group == nullptr || !group->OnResponse(r->cmd_id, r->status)) acked.release();
+      }
+    }
+  }
+
+  example::LoopbackStream conn;
+  std::mutex send_mutex;
+  wisson_SDK::timer::ClockSync clock;
+  std::mutex group_mutex;
+  ctrl::StartGroup* group{nullptr};
+  std::counting_semaphore<> acked{0};
+  std::thread rx;
+};
+
+enum class Mode { kSequential, kTriggerOnReceipt, kClockSynchronized };
+
+struct Result
+{
+  wisson_SDK::timer::LatencyHistogram true_skew;
+  wisson_SDK::timer::LatencyHistogram reported_skew;
+  int64_t clock_error_ns{0};
+  bool skew_measured{true};   ///< Every report had server start times (StartReport::skew_measured).
+};
+
+int64_t TrueSkew(std::vector<std::unique_ptr<StandInRobot>>& robots)
+{
+  std::vector<int64_t> starts;
+  for (auto& r : robots) {
+    auto s = r->TakeStarts();
+    starts.insert(starts.end(), s.begin(), s.end());
+  }
+  const auto [lo, hi] = std::minmax_element(starts.begin(), starts.end());
+  return *hi - *lo;
+}
+
+void Run(Mode mode, int trials, std::vector<std::unique_ptr<StandInRobot>>& robots,
+         std::vector<std::unique_ptr<RobotLink>>& links, Result& result)
+{
+  const auto arm = ctrl::RobotCommand::CreateCommand(
+    ctrl::MotionCommand::CreateCommand({0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0}, 1.0));
+  std::vector<uint8_t> frame;
+  for (int t = 0; t < trials; ++t) {
+    if (mode == Mode::kSequential) {
+      // One blocking Control-style call per arm: send, wait for the acknowledgement.
+      for (auto& link : links) {
+        for (int a = 0; a < 2; ++a) {
+          arm->cmd_id = ctrl::Controller::GenerateCommandId();
+          net::EncodeCommandFrame(*arm, ctrl::ControllerMode::JointPosition(), frame);
+          link->Send(frame.data(), frame.size());
+          link->acked.acquire();
+        }
+      }
+    } else {
+      ctrl::StartGroup group;
+      for (auto& link : links) {
+        std::lock_guard<std::mutex> lock(link->group_mutex);
+        link->group = &group;
+      }
+      for (auto& link : links) {
+        const auto target = group.AddTarget([&l = *link](const uint8_t* d, std::size_t n) { return l.Send(d, n); },
+                                            mode == Mode::kClockSynchronized ? &link->clock : nullptr);
+        for (int a = 0; a < 2; ++a) {
+          arm->cmd_id = 0;
+          group.Stage(target, *arm, ctrl::ControllerMode::JointPosition());
+        }
+      }
+      group.Trigger();
+      const auto report = group.WaitStarted();
+      result.reported_skew.RecordNs(static_cast<uint64_t>(report.skew_ns));
+      result.clock_error_ns = std::max(result.clock_error_ns, report.clock_error_ns);
+      result.skew_measured = result.skew_measured && report.skew_measured;
+      for (auto& link : links) {
+        std::lock_guard<std::mutex> lock(link->group_mutex);
+        link->group = nullptr;
+      }
+    }
+    result.true_skew.RecordNs(static_cast<uint64_t>(TrueSkew(robots)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_SyncStart");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "SyncStart-Bench";
+
+  const int trials = argc > 1 ? std::stoi(argv[1]) : 50;
+  const int jitter_us = argc > 2 ? std::stoi(argv[2]) : 2000;
+
+  // Two robots whose clocks are 1.2 s ahead / 0.57 s behind the local one.
+  std::vector<std::unique_ptr<StandInRobot>> robots;
+  robots.push_back(std::make_unique<StandInRobot>(1'234'567'890, jitter_us, 1));
+  robots.push_back(std::make_unique<StandInRobot>(-567'890'123, jitter_us, 2));
+  std::vector<std::unique_ptr<RobotLink>> links;
+  for (auto& r : robots) links.push_back(std::make_unique<RobotLink>(r->port()));
+  for (auto& l : links) l->SyncClock(16);
+
+  SPDLOG_INFO("[{}] 2 robots x 2 arms, {} trials, up to {} us handling delay per frame", example_tag, trials, jitter_us);
+  for (std::size_t i = 0; i < links.size(); ++i) {
+    SPDLOG_INFO("[{}] robot {} clock offset estimate {:.3f} ms (rtt {:.1f} us)", example_tag, i,
+                links[i]->clock.OffsetNs() * 1e-6, links[i]->clock.RttNs() * 1e-3);
+  }
+  SPDLOG_INFO("[{}] start              | true skew p50 [us] | max [us] | reported p50 [us] | clock error [us]",
+              example_tag);
+
+  // Without synchronized clocks the report holds arrival times only: the skew is unknown.
+  auto print = [&](const char* name, const Result& r, bool reported) {
+    const std::string skew = !reported          ? std::string("-")
+                           : !r.skew_measured   ? std::string("unknown")
+                                                : std::to_string(r.reported_skew.PercentileNs(50.0) / 1000);
+    SPDLOG_INFO("[{}] {} | {:>18.0f} | {:>8.0f} | {:>17} | {:>16}", example_tag, name,
+                r.true_skew.PercentileNs(50.0) * 1e-3, r.true_skew.MaxNs() * 1e-3, skew,
+                reported && r.skew_measured ? std::to_string(r.clock_error_ns / 1000) : std::string("-"));
+  };
+  Result sequential, on_receipt, synchronized;
+  Run(Mode::kSequential, trials, robots, links, sequential);
+  print("separate calls    ", sequential, false);
+  Run(Mode::kTriggerOnReceipt, trials, robots, links, on_receipt);
+  print("trigger on receipt", on_receipt, true);
+  Run(Mode::kClockSynchronized, trials, robots, links, synchronized);
+  print("clock synchronized", synchronized, true);
+
+  // Staging that is not acknowledged in time: the group is withdrawn, nothing starts.
+  {
+    const auto arm = ctrl::RobotCommand::CreateCommand(
+      ctrl::MotionCommand::CreateCommand({0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0}, 1.0));
+    ctrl::StartGroup group;
+    for (auto& link : links) {
+      std::lock_guard<std::mutex> lock(link->group_mutex);
+      link->group = &group;
+    }
+    for (auto& link : links) {
+      const auto target = group.AddTarget([&l = *link](const uint8_t* d, std::size_t n) { return l.Send(d, n); });
+      arm->cmd_id = 0;
+      group.Stage(target, *arm, ctrl::ControllerMode::JointPosition());
+    }
+    bool refused = false;
+    try {
+      group.Trigger(ctrl::kDefaultStartLead, std::chrono::nanoseconds(0));
+    } catch (const wisson_SDK::NetworkException&) {
+      refused = true;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(4 * jitter_us) + std::chrono::milliseconds(20));
+    std::size_t started = 0;
+    for (auto& r : robots) started += r->TakeStarts().size();
+    for (auto& link : links) {
+      std::lock_guard<std::mutex> lock(link->group_mutex);
+      link->group = nullptr;
+    }
+    SPDLOG_INFO("[{}] staging timeout: trigger {}, {} commands started after the withdraw", example_tag,
+                refused ? "refused" : "NOT refused", started);
+  }
+
+  links.clear();
+  robots.clear();
+  return 0;
+}
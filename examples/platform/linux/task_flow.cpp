@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: task_flow.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Coroutine task flow: move, open gripper, wait for a pressure threshold,
+ *        move back. The flow runs on the SDK task executor without blocking it.
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <chrono>
+#include <memory>
+#include <pthread.h>
+#include <thread>
+#include <filesystem>
+
+//=== Third-party library headers ===//
+#include "perseuslib/perseus_robot.h"
+#include "perseuslib/controller/robot_task.hpp"
+#include "logging/perseus_log.h"
+
+
+namespace ctrl = wisson_SDK::control;
+
+namespace {
+
+const std::string example_tag = "Task-Flow";
+
+ctrl::Task<void> PickFlow(std::shared_ptr<wisson_SDK::PerseusRobot> robot)
+{
+  auto mode = ctrl::ControllerMode::JointPosition();
+  std::array<double, 9> approach = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0};
+  std::array<double, 9> retreat  = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 0.0, 35.0};
+
+  auto status = co_await robot->ControlAsync(
+    mode, ctrl::RobotCommand::CreateCommand(ctrl::MotionCommand::CreateCommand(approach, 5.0)));
+  SPDLOG_INFO("[{}] Approach: {}", example_tag, ctrl::detail::ResponseStatusToString(status));
+
+  status = co_await robot->EndEffectorAsync(ctrl::EndEffectorAction::Open, 5.0);
+  SPDLOG_INFO("[{}] Gripper open: {}", example_tag, ctrl::detail::ResponseStatusToString(status));
+
+  auto state = co_await robot->WaitState(
+    [](const wisson_SDK::RobotState& s) { return s.pSource > 5000; }, std::chrono::seconds(10));
+  if (!state) {
+    SPDLOG_WARN("[{}] Source pressure did not reach the threshold", example_tag);
+    co_return;
+  }
+  SPDLOG_INFO("[{}] Source pressure {} reached", example_tag, state->pSource);
+
+  status = co_await robot->ControlAsync(
+    mode, ctrl::RobotCommand::CreateCommand(ctrl::MotionCommand::CreateCommand(retreat, 5.0)));
+  SPDLOG_INFO("[{}] Retreat: {}", example_tag, ctrl::detail::ResponseStatusToString(status));
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_TaskFlow");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+
+  /*********************************  PerseusRobot-SDK init begin  *********************************/
+  std::filesystem::path config_path = std::filesystem::path(CONFIG_PATH) / "config.yaml";
+  auto robot = wisson_SDK::PerseusRobot::Create(config_path);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  auto done = ctrl::TaskExecutor::Default().Spawn(PickFlow(robot));
+  done.get();
+  return 0;
+}
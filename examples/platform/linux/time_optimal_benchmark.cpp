@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: time_optimal_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Cycle time of reference paths with the velocity and acceleration limits
+ *        of config.yaml: hand-picked 5 s timeouts per waypoint (as path_control
+ *        does), the fastest stop at every waypoint, the spline uniformly scaled
+ *        onto the limits, and the time-optimal parameterization of the same
+ *        spline. Also reports the tightened timeouts of ToCommand(), the peak
+ *        velocity / acceleration of the time-optimal motion relative to the
+ *        limits and the planning time.
+ *
+ * Usage: time_optimal_benchmark [grid=2000]
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/command_limits_loader.hpp"
+#include "perseuslib/controller/time_optimal.hpp"
+#include "logging/perseus_log.h"
+
+
+namespace ctrl = wisson_SDK::control;
+using Clock = std::chrono::steady_clock;
+using wisson_SDK::JOINT_NUM;
+
+namespace {
+
+constexpr double kHandPickedTimeout = 5.0;
+
+struct ReferencePath
+{
+  const char* name;
+  std::shared_ptr<ctrl::RobotCommand> cmd;
+};
+
+/**
+ * @brief Approach, grasp, lift, transfer and place above a second bin.
+ */
+std::shared_ptr<ctrl::RobotCommand> PickPlacePath()
+{
+  const std::vector<ctrl::JointVector> points = {
+    {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0, 30.0, 5.0},
+    {0.3800, 35.0, 55.0, 10.0, 2.0, 25.0, 35.0, 10.0, 20.0},
+    {0.3300, 40.0, 60.0, 15.0, 2.0, 20.0, 40.0, 0.0, 35.0},
+    {0.4000, 20.0, 45.0, 5.0, 2.0, 10.0, 20.0, 10.0, 35.0},
+    {0.4500, -30.0, 30.0, -20.0, 2.0, -10.0, -20.0, 20.0, 35.0},
+    {0.3500, -45.0, 50.0, -25.0, 2.0, -15.0, -30.0, 5.0, 35.0},
+  };
+  std::vector<ctrl::MotionCommand> commands;
+  for (const auto& p : points) commands.push_back(ctrl::MotionCommand::CreateCommand(p, kHandPickedTimeout));
+  return ctrl::RobotCommand::CreateCommands(commands, kHandPickedTimeout * points.size());
+}
+
+/**
+ * @brief Twelve waypoints swinging every joint.
+ */
+std::shared_ptr<ctrl::RobotCommand> SweepPath()
+{
+  std::vector<ctrl::MotionCommand> commands;
+  for (int i = 0; i < 12; ++i) {
+    ctrl::JointVector q;
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      q[j] = (j == 0 ? 0.3 : 0.0) + (j == 0 ? 0.1 : 40.0) * std::sin(0.7 * i + 0.9 * static_cast<double>(j));
+    }
+    commands.push_back(ctrl::MotionCommand::CreateCommand(q, kHandPickedTimeout));
+  }
+  return ctrl::RobotCommand::CreateCommands(commands, kHandPickedTimeout * commands.size());
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_TimeOptimal");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "TimeOptimal-Bench";
+
+  const std::size_t grid = argc > 1 ? std::stoul(argv[1]) : ctrl::TimeOptimalPath::kDefaultGridSize;
+  std::filesystem::path config_path = std::filesystem::path(CONFIG_PATH) / "config.yaml";
+  const auto limits = ctrl::TimeOptimalLimits(ctrl::LoadCommandLimits(config_path.string()));
+
+  bool ok = true;
+  for (const ReferencePath& ref : {ReferencePath{"pick and place", PickPlacePath()},
+                                   ReferencePath{"12-point sweep", SweepPath()}}) {
+    const auto waypoints = ref.cmd->getJointPositionsVec();
+    double hand_picked = 0.0;
+    for (std::size_t k = 1; k < ref.cmd->commands.size(); ++k) {
+      hand_picked += std::get<ctrl::MotionCommand>(ref.cmd->commands[k]).timeout;
+    }
+    const double stops = ctrl::PiecewiseTrajectory::Plan(waypoints, ctrl::SegmentProfile::kTrapezoidal, limits).Duration();
+    const double scaled = ctrl::PiecewiseTrajectory::Plan(waypoints, ctrl::SegmentProfile::kCubicSpline, limits).Duration();
+
+    const auto t0 = Clock::now();
+    const auto path = ctrl::PlanTimeOptimal(*ref.cmd, limits, grid);
+    const double plan_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    const auto tightened = path.ToCommand();
+
+    double v_ratio = 0.0, a_ratio = 0.0;
+    for (double t = 0.0; t <= path.Duration(); t += 0.0005) {
+      const auto p = path.At(t);
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+        v_ratio = std::max(v_ratio, std::abs(p.velocity[j]) / limits.max_velocity[j]);
+        a_ratio = std::max(a_ratio, std::abs(p.acceleration[j]) / limits.max_acceleration[j]);
+      }
+    }
+    const auto end = path.At(path.Duration());
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) ok = ok && std::abs(end.position[j] - waypoints.back()[j]) < 1e-9;
+    ok = ok && v_ratio <= 1.001 && a_ratio <= 1.001;
+
+    SPDLOG_INFO("[{}] {} ({} waypoints, grid {}), cycle time [s]:", example_tag, ref.name, waypoints.size(), grid);
+    SPDLOG_INFO("[{}]   hand-picked timeouts      | {:>7.3f} | timeout budget", example_tag, hand_picked);
+    SPDLOG_INFO("[{}]   stop at every waypoint    | {:>7.3f} |", example_tag, stops);
+    SPDLOG_INFO("[{}]   spline, uniformly scaled  | {:>7.3f} |", example_tag, scaled);
+    SPDLOG_INFO("[{}]   spline, time-optimal      | {:>7.3f} | {:.2f}x vs stops, {:.2f}x vs scaled spline",
+                example_tag, path.Duration(), stops / path.Duration(), scaled / path.Duration());
+    SPDLOG_INFO("[{}]   tightened total_timeout {:.3f} s (hand-picked {:.1f} s); peak v/vmax {:.4f}, a/amax {:.4f}; "
+                "planned in {:.2f} ms", example_tag, tightened->total_timeout, ref.cmd->total_timeout, v_ratio,
+                a_ratio, plan_ms);
+  }
+  SPDLOG_INFO("[{}] {}", example_tag, ok ? "time-optimal motions within limits" : "LIMIT OR ENDPOINT ERROR");
+  return ok ? 0 : 1;
+}
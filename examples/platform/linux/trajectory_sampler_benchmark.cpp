@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: trajectory_sampler_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: PiecewiseTrajectory through a 12-waypoint path with the velocity limits of
+ *        config.yaml, for every SegmentProfile. Reports the duration, the peak
+ *        velocity / acceleration relative to the limits and the sampling
+ *        throughput of a per-joint scalar evaluation (binary search per sample),
+ *        At() and the batched SampleUniform() into a cache-resident chunk, plus the
+ *        largest difference between the scalar and the vectorized results.
+ *
+ * Usage: trajectory_sampler_benchmark [samples=2000000]
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <pthread.h>
+#include <span>
+#include <string>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/trajectory_sampler.hpp"
+#include "logging/perseus_log.h"
+
+
+namespace ctrl = wisson_SDK::control;
+using Clock = std::chrono::steady_clock;
+using wisson_SDK::JOINT_NUM;
+
+namespace {
+
+/**
+ * @brief Reference: joint by joint, with a binary search per sample.
+ */
+void ScalarAt(const ctrl::PiecewiseTrajectory& traj, double t, ctrl::TrajectoryPoint& out)
+{
+  const auto pieces = traj.Pieces();
+  t = std::clamp(t, 0.0, traj.Duration());
+  auto it = std::upper_bound(pieces.begin(), pieces.end(), t,
+                             [](double value, const ctrl::TrajectoryPiece& p) { return value < p.t0; });
+  const auto& p = it == pieces.begin() ? pieces.front() : *std::prev(it);
+  const double s = t - p.t0;
+  for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+    double q = 0.0, v = 0.0, a = 0.0;
+    for (int k = 5; k >= 0; --k) {
+      const double c = p.coeff[k][j];
+      q = q * s + c;
+      if (k >= 1) v = v * s + k * c;
+      if (k >= 2) a = a * s + k * (k - 1) * c;
+    }
+    out.position[j] = q;
+    out.velocity[j] = v;
+    out.acceleration[j] = a;
+  }
+}
+
+const char* ProfileName(ctrl::SegmentProfile p)
+{
+  switch (p)
+  {
+    case ctrl::SegmentProfile::kTrapezoidal: return "trapezoidal ";
+    case ctrl::SegmentProfile::kQuintic:     return "quintic     ";
+    case ctrl::SegmentProfile::kCubicSpline: return "cubic spline";
+  }
+  return "?";
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_TrajSampler");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "TrajSampler-Bench";
+
+  const std::size_t samples = argc > 1 ? std::stoul(argv[1]) : 2'000'000;
+  ctrl::BlendLimits<JOINT_NUM> limits;
+  limits.max_velocity = {0.20, 90.0, 90.0, 90.0, 90.0, 90.0, 90.0, 90.0, 90.0};
+  for (std::size_t j = 0; j < JOINT_NUM; ++j) limits.max_acceleration[j] = 4.0 * limits.max_velocity[j];
+
+  std::vector<ctrl::JointVector> waypoints;
+  for (int i = 0; i < 12; ++i) {
+    ctrl::JointVector q;
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      const double amplitude = j == 0 ? 0.1 : 40.0;
+      q[j] = amplitude * std::sin(0.7 * i + 0.9 * static_cast<double>(j));
+    }
+    waypoints.push_back(q);
+  }
+
+  SPDLOG_INFO("[{}] 12 waypoints, 9 joints, {} samples per run", example_tag, samples);
+  SPDLOG_INFO("[{}] profile      | duration [s] | v/vmax | a/amax | scalar [Msamples/s] | At() | SampleUniform() | max diff",
+              example_tag);
+  constexpr std::size_t kChunk = 1024;
+  std::vector<ctrl::TrajectoryPoint> batch(kChunk), reference(kChunk);
+  bool ok = true;
+  for (const auto profile : {ctrl::SegmentProfile::kTrapezoidal, ctrl::SegmentProfile::kQuintic,
+                             ctrl::SegmentProfile::kCubicSpline}) {
+    const auto traj = ctrl::PiecewiseTrajectory::Plan(waypoints, profile, limits);
+    const double period = traj.Duration() / static_cast<double>(samples - 1);
+    // Samples [begin, begin + kChunk) of the run, clipped to the run.
+    auto chunks = [&](auto&& body) {
+      const auto t0 = Clock::now();
+      for (std::size_t begin = 0; begin < samples; begin += kChunk) body(begin, std::min(kChunk, samples - begin));
+      return static_cast<double>(samples) / std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+    };
+
+    const double scalar = chunks([&](std::size_t begin, std::size_t n) {
+      for (std::size_t i = 0; i < n; ++i) ScalarAt(traj, static_cast<double>(begin + i) * period, reference[i]);
+    });
+    const double single = chunks([&](std::size_t begin, std::size_t n) {
+      for (std::size_t i = 0; i < n; ++i) traj.At(static_cast<double>(begin + i) * period, batch[i]);
+    });
+    const double batched = chunks([&](std::size_t begin, std::size_t n) {
+      traj.SampleUniform(static_cast<double>(begin) * period, period, std::span(batch).first(n));
+    });
+
+    double v_ratio = 0.0, a_ratio = 0.0, diff = 0.0;
+    chunks([&](std::size_t begin, std::size_t n) {
+      traj.SampleUniform(static_cast<double>(begin) * period, period, std::span(batch).first(n));
+      for (std::size_t i = 0; i < n; ++i) {
+        ScalarAt(traj, static_cast<double>(begin + i) * period, reference[i]);
+        for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+          v_ratio = std::max(v_ratio, std::abs(batch[i].velocity[j]) / limits.max_velocity[j]);
+          a_ratio = std::max(a_ratio, std::abs(batch[i].acceleration[j]) / limits.max_acceleration[j]);
+          diff = std::max({diff, std::abs(batch[i].position[j] - reference[i].position[j]),
+                           std::abs(batch[i].velocity[j] - reference[i].velocity[j])});
+        }
+      }
+    });
+    const auto last = traj.At(traj.Duration());
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      ok = ok && std::abs(last.position[j] - waypoints.back()[j]) < 1e-9 && std::abs(last.velocity[j]) < 1e-9;
+    }
+    ok = ok && v_ratio <= 1.0 + 1e-9 && a_ratio <= 1.0 + 1e-9;
+    SPDLOG_INFO("[{}] {} | {:>12.3f} | {:>6.4f} | {:>6.4f} | {:>19.1f} | {:>4.1f} | {:>15.1f} | {:.1e}", example_tag,
+                ProfileName(profile), traj.Duration(), v_ratio, a_ratio, scalar, single, batched, diff);
+  }
+  SPDLOG_INFO("[{}] {}", example_tag, ok ? "limits respected, ends at rest on the last waypoint" : "LIMIT OR ENDPOINT ERROR");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: trajectory_stream_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Streams a dense taught path with thousands of waypoints to a local
+ *        stand-in server. Chunked blocking calls (window = one chunk) are compared
+ *        with windowed streaming. The server stops the robot whenever its waypoint
+ *        buffer runs dry before the end of the path.
+ *
+ * Usage: trajectory_stream_benchmark [waypoints=5000] [waypoint_us=200] [stop_ms=30]
+ */
+
+//=== Standard library headers ===//
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/trajectory_stream.hpp"
+#include "logging/perseus_log.h"
+#include "loopback_stream.hpp"
+
+
+namespace ctrl = wisson_SDK::control;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct ChunkHeader
+{
+  uint32_t cmd_id;
+  uint32_t seq;
+  uint32_t last;
+  uint32_t count;
+};
+
+struct Waypoint
+{
+  uint32_t cmd_id;
+  bool chunk_end;
+  bool path_end;
+};
+
+/**
+ * @brief Lazily generated dense path; nothing is stored per waypoint.
+ */
+ctrl::WaypointSource DensePath(int count)
+{
+  return [count, i = 0]() mutable -> std::optional<ctrl::MotionCommand> {
+    if (i >= count) return std::nullopt;
+    const double s = static_cast<double>(i++) / count;
+    std::array<double, wisson_SDK::JOINT_NUM> q = {0.4280, 30.0, 40.0, -1.0, 2.0, 30.0, 30.0,
+                                                   30.0 * std::cos(6.28 * s), 5.0 + 30.0 * s};
+    return ctrl::MotionCommand::CreateCommand(q, 0.05);
+  };
+}
+
+struct Result
+{
+  double total_ms{0};
+  int stops{0};
+  uint64_t max_outstanding{0};
+  uint64_t chunks{0};
+};
+
+Result Stream(std::size_t window, int waypoints, int waypoint_us, int stop_ms)
+{
+  example::LoopbackListener listener;
+  Result result;
+
+  // Stand-in server: buffers received chunks and executes them back to back.
+  std::thread server([&] {
+    auto conn = listener.Accept();
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Waypoint> buffer;
+    bool eof = false;
+
+    std::thread rx([&] {
+      std::vector<uint8_t> frame;
+      while (conn.RecvFrame(frame)) {
+        ChunkHeader h{};
+        std::memcpy(&h, frame.data(), sizeof(h));
+        std::lock_guard<std::mutex> lock(mutex);
+        for (uint32_t i = 0; i < h.count; ++i) {
+          buffer.push_back({h.cmd_id, i + 1 == h.count, h.last != 0 && i + 1 == h.count});
+        }
+        cv.notify_all();
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      eof = true;
+      cv.notify_all();
+    });
+
+    auto respond = [&](uint32_t id, ctrl::ResponseStatus st) {
+      uint32_t msg[2] = {id, static_cast<uint32_t>(st)};
+      conn.SendFrame(reinterpret_cast<const uint8_t*>(msg), sizeof(msg));
+    };
+
+    bool moving = false;
+    for (;;) {
+      Waypoint wp{};
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (buffer.empty() && moving) {
+          // Buffer ran dry mid-path: the robot has to decelerate to a stop.
+          ++result.stops;
+          moving = false;
+          lock.unlock();
+          std::this_thread::sleep_for(std::chrono::milliseconds(stop_ms));
+          lock.lock();
+        }
+        cv.wait(lock, [&] { return eof || !buffer.empty(); });
+        if (buffer.empty()) break;
+        wp = buffer.front();
+        buffer.pop_front();
+      }
+      moving = true;
+      std::this_thread::sleep_for(std::chrono::microseconds(waypoint_us));
+      respond(wp.cmd_id, ctrl::ResponseStatus::kSubSuccess);
+      if (wp.chunk_end) respond(wp.cmd_id, ctrl::ResponseStatus::kSuccess);
+      if (wp.path_end) break;
+    }
+    ::shutdown(conn.fd(), SHUT_WR);
+    rx.join();
+  });
+
+  auto client = example::LoopbackListener::Connect(listener.port());
+  std::vector<uint8_t> frame;
+  ctrl::TrajectoryStream stream([&](const ctrl::RobotCommand& chunk, const ctrl::StreamChunkInfo& info) {
+    const auto joints = chunk.getJointPositionsVec();
+    const ChunkHeader h{chunk.cmd_id, info.seq, info.last ? 1u : 0u, static_cast<uint32_t>(joints.size())};
+    frame.resize(sizeof(h) + joints.size() * sizeof(joints[0]));
+    std::memcpy(frame.data(), &h, sizeof(h));
+    std::memcpy(frame.data() + sizeof(h), joints.data(), joints.size() * sizeof(joints[0]));
+    return client.SendFrame(frame.data(), static_cast<uint32_t>(frame.size()));
+  }, ctrl::kDefaultStreamChunk, window);
+
+  std::thread io([&] {
+    std::vector<uint8_t> msg;
+    while (client.RecvFrame(msg)) {
+      uint32_t v[2];
+      std::memcpy(v, msg.data(), sizeof(v));
+      stream.OnResponse(v[0], static_cast<ctrl::ResponseStatus>(v[1]));
+    }
+  });
+
+  const auto t0 = Clock::now();
+  const auto status = stream.Run(DensePath(waypoints));
+  result.total_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+  client.ShutdownWrite();
+  server.join();
+  io.join();
+
+  if (status != ctrl::ResponseStatus::kSuccess) result.total_ms = -1.0;
+  result.max_outstanding = stream.Stats().max_outstanding.load();
+  result.chunks = stream.Stats().chunks_sent.load();
+  return result;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_TrajStream");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "TrajStream-Bench";
+
+  const int waypoints = argc > 1 ? std::stoi(argv[1]) : 5000;
+  const int waypoint_us = argc > 2 ? std::stoi(argv[2]) : 200;
+  const int stop_ms = argc > 3 ? std::stoi(argv[3]) : 30;
+  SPDLOG_INFO("[{}] {} waypoints, {} us each, {} ms per unplanned stop, chunk = {}",
+              example_tag, waypoints, waypoint_us, stop_ms, ctrl::kDefaultStreamChunk);
+  SPDLOG_INFO("[{}] mode           | total [ms] | stops | chunks | max unreached waypoints", example_tag);
+
+  const std::pair<const char*, std::size_t> runs[] = {
+    {"chunked calls ", ctrl::kDefaultStreamChunk},
+    {"windowed      ", ctrl::kDefaultStreamWindow},
+  };
+  for (const auto& [name, window] : runs) {
+    const Result r = Stream(window, waypoints, waypoint_us, stop_ms);
+    SPDLOG_INFO("[{}] {} | {:>10.1f} | {:>5} | {:>6} | {:>23}",
+                example_tag, name, r.total_ms, r.stops, r.chunks, r.max_outstanding);
+  }
+  return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2025, WissonRobotics
+ * File: waypoint_blend_benchmark.cpp
+ * Author: Yuchen Xia (xiayuchen66@gmail.com)
+ * Version 1.0
+ * Date: 2026-10-16
+ * Brief: Cycle time of a reference pick-and-place path with exact stops at every
+ *        via point versus blended via points, in joint and Cartesian space. The
+ *        sampled trajectories are checked against the velocity / acceleration
+ *        limits, and the distance by which each via point is missed is reported.
+ *
+ * Usage: waypoint_blend_benchmark [period_ms=4]
+ */
+
+//=== Standard library headers ===//
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+//=== Third-party library headers ===//
+#include "perseuslib/controller/waypoint_blend.hpp"
+#include "logging/perseus_log.h"
+
+
+namespace ctrl = wisson_SDK::control;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Report
+{
+  double cycle_s{0};
+  double plan_us{0};
+  double max_velocity_ratio{0};       ///< Peak |v| / v_max over all axes.
+  double max_acceleration_ratio{0};   ///< Peak |a| / a_max over all axes (finite differences).
+  double max_via_miss{0};             ///< Largest distance a via point is missed by (per-axis).
+  std::size_t samples{0};
+};
+
+template <std::size_t N>
+Report Evaluate(const std::vector<std::array<double, N>>& waypoints, double radius,
+                const ctrl::BlendLimits<N>& limits, double period)
+{
+  Report r;
+  const auto t0 = Clock::now();
+  const auto path = ctrl::BlendedPath<N>::Plan(waypoints, std::vector<double>{radius}, limits);
+  r.plan_us = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+  r.cycle_s = path.Duration();
+
+  std::vector<double> closest(waypoints.size(), std::numeric_limits<double>::max());
+  const double dt = 1e-4;
+  auto prev_v = path.Velocity(0.0);
+  for (double t = 0.0; t <= path.Duration(); t += dt) {
+    const auto q = path.Position(t);
+    const auto v = path.Velocity(t);
+    for (std::size_t j = 0; j < N; ++j) {
+      r.max_velocity_ratio = std::max(r.max_velocity_ratio, std::abs(v[j]) / limits.max_velocity[j]);
+      r.max_acceleration_ratio = std::max(r.max_acceleration_ratio,
+                                          std::abs(v[j] - prev_v[j]) / dt / limits.max_acceleration[j]);
+    }
+    prev_v = v;
+    for (std::size_t i = 0; i < waypoints.size(); ++i) {
+      double d = 0.0;
+      for (std::size_t j = 0; j < N; ++j) d = std::max(d, std::abs(q[j] - waypoints[i][j]));
+      closest[i] = std::min(closest[i], d);
+    }
+  }
+  r.max_via_miss = *std::max_element(closest.begin(), closest.end());
+  r.samples = static_cast<std::size_t>(std::ceil(path.Duration() / period)) + 1;
+  return r;
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv)
+{
+  // Set main thread name
+  pthread_setname_np(pthread_self(), "Demo_Blend");
+
+  // Log initialization
+  wisson_SDK::logging::LoggerManager::InitLogging();
+  const std::string example_tag = "Blend-Bench";
+
+  const double period = (argc > 1 ? std::stod(argv[1]) : 4.0) * 1e-3;
+
+  // Reference pick-and-place cycle (joint 0 [m], joints 1-8 [deg]).
+  const std::vector<std::array<double, wisson_SDK::JOINT_NUM>> joint_path = {
+    {0.4280, 30.0, 40.0, -1.0,  2.0, 30.0, 30.0, 30.0,  5.0},
+    {0.4000, 35.0, 50.0, 10.0,  5.0, 25.0, 35.0, 20.0, 10.0},
+    {0.3600, 45.0, 55.0, 20.0, 10.0, 20.0, 40.0, 10.0, 20.0},
+    {0.3400, 50.0, 45.0, 25.0, 20.0, 15.0, 45.0,  0.0, 25.0},
+    {0.3600, 40.0, 35.0, 15.0, 30.0, 20.0, 40.0, -10.0, 20.0},
+    {0.4000, 30.0, 30.0,  5.0, 25.0, 25.0, 35.0, -5.0, 10.0},
+    {0.4280, 30.0, 40.0, -1.0,  2.0, 30.0, 30.0, 30.0,  5.0},
+  };
+  ctrl::BlendLimits<wisson_SDK::JOINT_NUM> joint_limits;
+  joint_limits.max_velocity.fill(60.0);
+  joint_limits.max_acceleration.fill(180.0);
+  joint_limits.max_velocity[0] = 0.2;
+  joint_limits.max_acceleration[0] = 0.6;
+
+  // Cartesian square with a diagonal, constant orientation [m].
+  const std::vector<std::array<double, 3>> cart_path = {
+    {0.30, 0.00, 0.40}, {0.30, 0.15, 0.40}, {0.45, 0.15, 0.40}, {0.45, 0.00, 0.40},
+    {0.30, 0.15, 0.35}, {0.30, 0.00, 0.40},
+  };
+  ctrl::BlendLimits<3> cart_limits;
+  cart_limits.max_velocity.fill(0.25);
+  cart_limits.max_acceleration.fill(1.0);
+
+  SPDLOG_INFO("[{}] {} joint waypoints, {} Cartesian waypoints, sample period {} ms",
+              example_tag, joint_path.size(), cart_path.size(), period * 1e3);
+  SPDLOG_INFO("[{}] space     | radius  | cycle [s] | speedup | via miss | v/vmax | a/amax | plan [us] | samples",
+              example_tag);
+
+  auto print = [&](const char* space, const std::string& radius, const Report& r, double baseline) {
+    SPDLOG_INFO("[{}] {} | {:>7} | {:>9.3f} | {:>6.2f}x | {:>8.4f} | {:>6.3f} | {:>6.3f} | {:>9.1f} | {:>7}",
+                example_tag, space, radius, r.cycle_s, baseline / r.cycle_s, r.max_via_miss,
+                r.max_velocity_ratio, r.max_acceleration_ratio, r.plan_us, r.samples);
+  };
+
+  const double joint_baseline = Evaluate(joint_path, 0.0, joint_limits, period).cycle_s;
+  for (double radius : {0.0, 2.0, 5.0, 10.0}) {
+    print("joint    ", radius == 0.0 ? "stop" : std::to_string(static_cast<int>(radius)) + " deg",
+          Evaluate(joint_path, radius, joint_limits, period), joint_baseline);
+  }
+  const double cart_baseline = Evaluate(cart_path, 0.0, cart_limits, period).cycle_s;
+  for (double radius : {0.0, 0.01, 0.03, 0.05}) {
+    print("cartesian", radius == 0.0 ? "stop" : std::to_string(static_cast<int>(radius * 1e3)) + " mm",
+          Evaluate(cart_path, radius, cart_limits, period), cart_baseline);
+  }
+  return 0;
+}
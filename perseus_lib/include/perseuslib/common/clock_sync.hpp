@@ -0,0 +1,119 @@
+/**
+ * @file clock_sync.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Offset between the local steady clock and a server clock.
+ *
+ * Four-timestamp exchange as in NTP: the client stamps a probe when sending (t0),
+ * the server stamps it when receiving (t1) and when answering (t2), the client
+ * stamps the answer on arrival (t3). Of the last kWindow probes the one with the
+ * smallest round trip gives the offset, which bounds the error by rtt / 2.
+ *
+ * @example:
+ *   ClockSync sync;
+ *   sync.AddSample(t0, t1, t2, t3);                     // io thread, per probe answer
+ *   int64_t remote_start = sync.ToRemote(SteadyNowNs() + 20'000'000);
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+
+
+namespace wisson_SDK::timer {
+
+/**
+ * @brief Local steady clock [ns]; the time base of ClockSync.
+ */
+[[nodiscard]] inline int64_t SteadyNowNs() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+/**
+ * @brief Estimates remote clock = local clock + offset. Thread-safe.
+ */
+class ClockSync
+{
+public:
+  static constexpr std::size_t kWindow = 16;
+
+  /**
+   * @brief Add one probe exchange [ns]: t0 / t3 on the local clock, t1 / t2 on the server clock.
+   */
+  void AddSample(int64_t t0, int64_t t1, int64_t t2, int64_t t3) noexcept
+  {
+    const int64_t rtt = (t3 - t0) - (t2 - t1);
+    if (rtt < 0) return;
+    const int64_t offset = ((t1 - t0) + (t2 - t3)) / 2;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    samples_[next_ % kWindow] = {offset, rtt};
+    ++next_;
+  }
+
+  [[nodiscard]] bool Valid() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return next_ > 0;
+  }
+
+  /**
+   * @brief Remote minus local clock [ns]; 0 before the first sample.
+   */
+  [[nodiscard]] int64_t OffsetNs() const { return Best().offset; }
+
+  /**
+   * @brief Round trip of the sample the offset is taken from; the offset error is at most half of it.
+   */
+  [[nodiscard]] int64_t RttNs() const { return Best().rtt; }
+
+  [[nodiscard]] int64_t ToRemote(int64_t local_ns) const { return local_ns + OffsetNs(); }
+  [[nodiscard]] int64_t ToLocal(int64_t remote_ns) const { return remote_ns - OffsetNs(); }
+
+  void Reset()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    next_ = 0;
+  }
+
+private:
+  struct Sample
+  {
+    int64_t offset{0};
+    int64_t rtt{0};
+  };
+
+  Sample Best() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Sample best{0, 0};
+    int64_t best_rtt = std::numeric_limits<int64_t>::max();
+    const std::size_t n = next_ < kWindow ? next_ : kWindow;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (samples_[i].rtt < best_rtt) {
+        best = samples_[i];
+        best_rtt = samples_[i].rtt;
+      }
+    }
+    return best;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::array<Sample, kWindow> samples_{};
+  std::size_t next_{0};
+};
+
+} // namespace wisson_SDK::timer
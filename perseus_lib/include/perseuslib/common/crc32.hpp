@@ -0,0 +1,54 @@
+/**
+ * @file crc32.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) over byte buffers.
+ *
+ * Same check value as zlib's crc32(): Crc32("123456789") == 0xCBF43926.
+ *
+ * @example:
+ *   uint32_t crc = Crc32(frame.data(), frame.size());
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace wisson_SDK {
+
+namespace detail {
+
+[[nodiscard]] inline constexpr std::array<uint32_t, 256> MakeCrc32Table() noexcept
+{
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t c = i;
+    for (int k = 0; k < 8; ++k) c = (c & 1u) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+    table[i] = c;
+  }
+  return table;
+}
+
+inline constexpr std::array<uint32_t, 256> kCrc32Table = MakeCrc32Table();
+
+} // namespace detail
+
+/**
+ * @brief CRC-32 of @p size bytes at @p data.
+ * @param crc CRC of the preceding bytes, to checksum a buffer in pieces.
+ */
+[[nodiscard]] inline uint32_t Crc32(const uint8_t* data, std::size_t size, uint32_t crc = 0) noexcept
+{
+  crc = ~crc;
+  for (std::size_t i = 0; i < size; ++i) crc = detail::kCrc32Table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+  return ~crc;
+}
+
+}  // namespace wisson_SDK
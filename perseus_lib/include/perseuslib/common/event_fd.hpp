@@ -0,0 +1,104 @@
+/**
+ * @file event_fd.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Pollable notification for user event loops (Linux eventfd).
+ *
+ * An EventFd becomes readable after Notify() and stays readable until Consume()
+ * reads it, so it can be added to epoll / poll / select or wrapped in an asio
+ * posix::stream_descriptor next to the application's own descriptors. Notify()
+ * is a single write() and safe from any thread, including the SDK io threads.
+ *
+ * @example:
+ *   epoll_event ev{.events = EPOLLIN, .data = {.ptr = &handle}};
+ *   epoll_ctl(ep, EPOLL_CTL_ADD, handle.NotifyFd(), &ev);
+ *   ...
+ *   epoll_wait(ep, events, n, -1);   // handle finished
+ */
+#pragma once
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "perseuslib/common/wisson_exception.hpp"
+
+
+namespace wisson_SDK {
+
+/**
+ * @brief Owned, non-blocking eventfd counter.
+ */
+class EventFd
+{
+public:
+  /**
+   * @throw ConstructorException if the descriptor cannot be created.
+   */
+  EventFd() : fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+  {
+    if (fd_ < 0) {
+      throw wisson_SDK::ConstructorException(std::string("libperseus-EventFd: eventfd failed: ") + std::strerror(errno) + ".");
+    }
+  }
+
+  ~EventFd() { ::close(fd_); }
+
+  EventFd(const EventFd&) = delete;
+  EventFd& operator=(const EventFd&) = delete;
+
+  /**
+   * @brief Descriptor to poll for readability. Owned by this object.
+   */
+  [[nodiscard]] int Fd() const noexcept { return fd_; }
+
+  /**
+   * @brief Make the descriptor readable (any thread).
+   */
+  void Notify() const noexcept
+  {
+    const uint64_t one = 1;
+    while (::write(fd_, &one, sizeof(one)) < 0 && errno == EINTR) {}
+  }
+
+  /**
+   * @brief Reset the descriptor to non-readable.
+   * @return Number of Notify() calls since the last Consume(), 0 if none.
+   */
+  uint64_t Consume() const noexcept
+  {
+    uint64_t count = 0;
+    while (::read(fd_, &count, sizeof(count)) < 0) {
+      if (errno != EINTR) return 0;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Block until readable or @p timeout elapsed, without consuming.
+   * @return true if readable.
+   */
+  bool Wait(std::chrono::milliseconds timeout) const noexcept
+  {
+    pollfd p{fd_, POLLIN, 0};
+    int r;
+    while ((r = ::poll(&p, 1, static_cast<int>(timeout.count()))) < 0 && errno == EINTR) {}
+    return r > 0;
+  }
+
+private:
+  int fd_;
+};
+
+}  // namespace wisson_SDK
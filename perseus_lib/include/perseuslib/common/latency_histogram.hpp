@@ -0,0 +1,163 @@
+/**
+ * @file latency_histogram.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Allocation-free, log-linear latency histogram.
+ *
+ * Buckets split every power of two into kSubBuckets linear steps, so the relative
+ * error of a reported percentile is below 1 / kSubBuckets across the whole range
+ * (1 ns .. ~4.9 h). Record() is lock-free and may be called from a real-time
+ * thread while other threads read percentiles.
+ *
+ * @example:
+ *   LatencyHistogram h;
+ *   h.Record(std::chrono::microseconds(230));
+ *   double p99_us = h.PercentileNs(99.0) * 1e-3;
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+
+namespace wisson_SDK::timer {
+
+class LatencyHistogram
+{
+public:
+  static constexpr std::size_t kSubBucketBits = 3;
+  static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+  static constexpr std::size_t kOctaves = 44;   ///< Up to 2^44 ns.
+  static constexpr std::size_t kBucketCount = kOctaves * kSubBuckets;
+
+  LatencyHistogram() = default;
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  /**
+   * @brief Record one sample [ns]. Lock-free, no allocation.
+   */
+  void RecordNs(uint64_t ns) noexcept
+  {
+    buckets_[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t prev = max_ns_.load(std::memory_order_relaxed);
+    while (ns > prev && !max_ns_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+    prev = min_ns_.load(std::memory_order_relaxed);
+    while (ns < prev && !min_ns_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+  }
+
+  template <typename Rep, typename Period>
+  void Record(std::chrono::duration<Rep, Period> d) noexcept
+  {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    RecordNs(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+  }
+
+  [[nodiscard]] uint64_t Count() const noexcept { return count_.load(std::memory_order_relaxed); }
+  [[nodiscard]] uint64_t MaxNs() const noexcept { return max_ns_.load(std::memory_order_relaxed); }
+  [[nodiscard]] uint64_t MinNs() const noexcept
+  {
+    const uint64_t v = min_ns_.load(std::memory_order_relaxed);
+    return v == std::numeric_limits<uint64_t>::max() ? 0 : v;
+  }
+  [[nodiscard]] double MeanNs() const noexcept
+  {
+    const uint64_t n = Count();
+    return n == 0 ? 0.0 : static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) / static_cast<double>(n);
+  }
+
+  /**
+   * @brief Upper bound of the bucket holding the @p percentile (0..100) sample [ns].
+   */
+  [[nodiscard]] uint64_t PercentileNs(double percentile) const noexcept
+  {
+    const uint64_t n = Count();
+    if (n == 0) return 0;
+    const double clamped = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+    uint64_t rank = static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(n) + 0.5);
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      seen += buckets_[i].load(std::memory_order_relaxed);
+      if (seen >= rank) return std::min(BucketUpperBound(i), MaxNs());
+    }
+    return MaxNs();
+  }
+
+  /**
+   * @brief Samples of at least @p threshold_ns (bucket resolution).
+   */
+  [[nodiscard]] uint64_t CountAtLeastNs(uint64_t threshold_ns) const noexcept
+  {
+    uint64_t total = 0;
+    for (std::size_t i = BucketIndex(threshold_ns); i < kBucketCount; ++i) {
+      total += buckets_[i].load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  void Reset() noexcept
+  {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_ns_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+    min_ns_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief One-line summary in microseconds, for logging.
+   */
+  [[nodiscard]] std::string SummaryUs() const
+  {
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "n = %llu, mean = %.1f us, p50 = %.1f us, p99 = %.1f us, p99.9 = %.1f us, max = %.1f us",
+                  static_cast<unsigned long long>(Count()), MeanNs() * 1e-3, PercentileNs(50.0) * 1e-3,
+                  PercentileNs(99.0) * 1e-3, PercentileNs(99.9) * 1e-3, MaxNs() * 1e-3);
+    return buf;
+  }
+
+private:
+  [[nodiscard]] static constexpr std::size_t BucketIndex(uint64_t ns) noexcept
+  {
+    if (ns < kSubBuckets) return static_cast<std::size_t>(ns);
+    const std::size_t msb = static_cast<std::size_t>(std::bit_width(ns)) - 1;        // >= kSubBucketBits
+    const std::size_t octave = msb - kSubBucketBits + 1;
+    const std::size_t sub = static_cast<std::size_t>(ns >> (msb - kSubBucketBits)) & (kSubBuckets - 1);
+    const std::size_t index = octave * kSubBuckets + sub;
+    return index < kBucketCount ? index : kBucketCount - 1;
+  }
+
+  [[nodiscard]] static constexpr uint64_t BucketUpperBound(std::size_t index) noexcept
+  {
+    if (index < kSubBuckets) return index;
+    const std::size_t octave = index / kSubBuckets;
+    const std::size_t sub = index % kSubBuckets;
+    const std::size_t shift = octave - 1;
+    return ((static_cast<uint64_t>(kSubBuckets + sub + 1)) << shift) - 1;
+  }
+
+private:
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_ns_{0};
+  std::atomic<uint64_t> max_ns_{0};
+  std::atomic<uint64_t> min_ns_{std::numeric_limits<uint64_t>::max()};
+};
+
+} // namespace wisson_SDK::timer
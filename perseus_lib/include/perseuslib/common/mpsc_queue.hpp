@@ -0,0 +1,192 @@
+/**
+ * @file mpsc_queue.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Lock-free intrusive queues used on the SDK hot paths.
+ *
+ * This header contains:
+ *  - MpscNode / MpscQueue : intrusive multi-producer single-consumer FIFO (Vyukov)
+ *  - IndexFreeList        : ABA-safe lock-free free list of slot indices
+ *
+ * Neither container allocates; nodes and slots are owned by the caller.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+
+namespace wisson_SDK {
+
+// -----------------------------------------------------------------------------------
+//                              MPSC Queue
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Intrusive hook for MpscQueue. Derive queued objects from it.
+ */
+struct MpscNode
+{
+  std::atomic<MpscNode*> mpsc_next{nullptr};
+};
+
+
+/**
+ * @brief Intrusive multi-producer single-consumer queue.
+ *
+ * Push() is wait-free and may be called from any thread. Pop() must only be
+ * called from a single consumer thread (e.g. the io thread).
+ *
+ * @note Pop() may transiently return nullptr while a producer is between its
+ *       two push steps. The producer completes the link right after, so the
+ *       consumer picks the node up on its next drain.
+ */
+class MpscQueue
+{
+public:
+  MpscQueue() noexcept : head_(&stub_), tail_(&stub_) {}
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  /**
+   * @brief Enqueue a node (any thread).
+   */
+  void Push(MpscNode* node) noexcept
+  {
+    node->mpsc_next.store(nullptr, std::memory_order_relaxed);
+    MpscNode* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->mpsc_next.store(node, std::memory_order_release);
+  }
+
+  /**
+   * @brief Dequeue the oldest node (consumer thread only).
+   * @return Oldest node, or nullptr if the queue is (momentarily) empty.
+   */
+  MpscNode* Pop() noexcept
+  {
+    MpscNode* tail = tail_;
+    MpscNode* next = tail->mpsc_next.load(std::memory_order_acquire);
+
+    if (tail == &stub_) {
+      if (next == nullptr) return nullptr;
+      tail_ = next;
+      tail = next;
+      next = next->mpsc_next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+
+    // tail is the last linked node; only hand it out once a producer is not mid-push
+    if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+
+    Push(&stub_);
+    next = tail->mpsc_next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Approximate emptiness check (consumer thread only).
+   */
+  [[nodiscard]] bool Empty() const noexcept
+  {
+    return tail_ == &stub_ && stub_.mpsc_next.load(std::memory_order_acquire) == nullptr;
+  }
+
+private:
+  alignas(64) std::atomic<MpscNode*> head_;  ///< Producers exchange here
+  alignas(64) MpscNode* tail_;               ///< Consumer-owned read end
+  MpscNode stub_;
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Index Free List
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Lock-free LIFO of slot indices in [0, capacity).
+ *
+ * The top-of-stack word packs a 32-bit index with a 32-bit generation tag, so
+ * concurrent Acquire()/Release() from any number of threads are ABA-safe.
+ */
+class IndexFreeList
+{
+public:
+  static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+
+  explicit IndexFreeList(uint32_t capacity)
+    : capacity_(capacity), next_(new std::atomic<uint32_t>[capacity])
+  {
+    for (uint32_t i = 0; i < capacity; ++i) {
+      next_[i].store(i + 1 < capacity ? i + 1 : kInvalid, std::memory_order_relaxed);
+    }
+    top_.store(Pack(capacity > 0 ? 0 : kInvalid, 0), std::memory_order_release);
+  }
+
+  IndexFreeList(const IndexFreeList&) = delete;
+  IndexFreeList& operator=(const IndexFreeList&) = delete;
+
+  /**
+   * @brief Take a free index.
+   * @return Slot index, or kInvalid if every slot is in use.
+   */
+  uint32_t Acquire() noexcept
+  {
+    uint64_t top = top_.load(std::memory_order_acquire);
+    for (;;) {
+      const uint32_t index = Index(top);
+      if (index == kInvalid) return kInvalid;
+      const uint32_t next = next_[index].load(std::memory_order_relaxed);
+      if (top_.compare_exchange_weak(top, Pack(next, Tag(top) + 1),
+                                     std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return index;
+      }
+    }
+  }
+
+  /**
+   * @brief Return an index obtained from Acquire().
+   */
+  void Release(uint32_t index) noexcept
+  {
+    uint64_t top = top_.load(std::memory_order_relaxed);
+    for (;;) {
+      next_[index].store(Index(top), std::memory_order_relaxed);
+      if (top_.compare_exchange_weak(top, Pack(index, Tag(top) + 1),
+                                     std::memory_order_release, std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+  [[nodiscard]] uint32_t Capacity() const noexcept { return capacity_; }
+
+private:
+  static constexpr uint64_t Pack(uint32_t index, uint32_t tag) noexcept
+    { return (static_cast<uint64_t>(tag) << 32) | index; }
+  static constexpr uint32_t Index(uint64_t v) noexcept { return static_cast<uint32_t>(v); }
+  static constexpr uint32_t Tag(uint64_t v) noexcept { return static_cast<uint32_t>(v >> 32); }
+
+private:
+  const uint32_t capacity_;
+  std::unique_ptr<std::atomic<uint32_t>[]> next_;
+  alignas(64) std::atomic<uint64_t> top_{0};
+};
+
+}  // namespace wisson_SDK
@@ -48,14 +48,14 @@ struct RobotState
   /**
   * \f$q\f$
   * Measured joint positions.
-  * Vector of size JOINT_NUM, expressed in Unit: \f$[rad]\f$.
+  * Vector of size JOINT_NUM, expressed in Unit: \f$[deg]\f$ (joint 0: \f$[m]\f$).
   */
   std::array<double,JOINT_NUM> q{};
 
   /**
   * \f$q_err\f$
   * Measured joint errors.
-  * Vector of size JOINT_NUM, expressed in Unit: \f$[rad]\f$.
+  * Vector of size JOINT_NUM, expressed in Unit: \f$[deg]\f$ (joint 0: \f$[m]\f$).
   */
   std::array<double,JOINT_NUM> q_err{};
 
@@ -100,8 +100,8 @@ struct RobotState
    */
   void ClearData() 
   {
-    q.fill(0.0);                    ///< Joint positions (rad), reset to 0
-    q_err.fill(0.0);                ///< Joint errors (rad), reset to 0
+    q.fill(0.0);                    ///< Joint positions (deg), reset to 0
+    q_err.fill(0.0);                ///< Joint errors (deg), reset to 0
     pressure.fill(0);               ///< Pressure sensors (e.g., per joint or gripper), reset to 0
     pSource = 0;                    ///< Source pressure, reset to 0
     pSink = 0;                      ///< Sink pressure, reset to 0
@@ -0,0 +1,60 @@
+/**
+ * @file simd_utils.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Two-lane double vectors for per-joint loops.
+ *
+ * Thin wrappers over the GCC / Clang vector extensions. A Double2 maps to one
+ * SSE2 register on x86-64 and one NEON register on aarch64, so the same code is
+ * vectorized on the development host and on the robot controller, independent of
+ * the optimization level the application is built with.
+ *
+ * @example:
+ *   Mask2 ok = kAllLanes;
+ *   for (std::size_t j = 0; j + 2 <= N; j += 2) ok &= Load2(&q[j]) <= Load2(&q_max[j]);
+ *   bool all_ok = All(ok);
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace wisson_SDK::math::simd {
+
+using Double2 = double __attribute__((vector_size(16)));    ///< Two doubles.
+using Mask2 = int64_t __attribute__((vector_size(16)));     ///< Lane mask; a comparison yields -1 (true) or 0.
+
+inline constexpr Mask2 kAllLanes = {-1, -1};
+
+[[nodiscard]] inline Double2 Load2(const double* p) noexcept
+{
+  Double2 v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline void Store2(double* p, Double2 v) noexcept { std::memcpy(p, &v, sizeof(v)); }
+
+[[nodiscard]] inline constexpr Double2 Splat2(double x) noexcept { return Double2{x, x}; }
+
+[[nodiscard]] inline Double2 Abs2(Double2 v) noexcept
+{
+  constexpr Mask2 kNoSign = {INT64_MAX, INT64_MAX};
+  return reinterpret_cast<Double2>(reinterpret_cast<Mask2>(v) & kNoSign);
+}
+
+/**
+ * @brief Lanes that are neither infinite nor NaN (x - x is NaN for both).
+ */
+[[nodiscard]] inline Mask2 Finite2(Double2 v) noexcept { return (v - v) == Splat2(0.0); }
+
+[[nodiscard]] inline bool All(Mask2 m) noexcept { return (m[0] & m[1]) != 0; }
+[[nodiscard]] inline bool Any(Mask2 m) noexcept { return (m[0] | m[1]) != 0; }
+
+} // namespace wisson_SDK::math::simd
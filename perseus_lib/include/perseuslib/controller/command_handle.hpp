@@ -0,0 +1,418 @@
+/**
+ * @file command_handle.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Non-blocking command submission: CommandHandle and CommandDispatcher.
+ *
+ * This header contains:
+ *  - CommandHandle     : lightweight, shareable view on one submitted RobotCommand
+ *                        (status, progress, Wait(timeout), Cancel(), callbacks,
+ *                        NotifyFd() for epoll / asio loops, Timeline())
+ *  - CommandDispatcher : per-robot FIFO that executes submitted commands on a
+ *                        dedicated thread and completes their handles
+ *
+ * @example:
+ *   auto handle = robot->ControlAsync(mode, cmd);
+ *   handle.OnComplete([](const CommandHandle& h) { ... });
+ *   // ... overlap vision processing ...
+ *   handle.Wait(std::chrono::seconds(10));
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "perseuslib/common/event_fd.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+#include "command_timeline.hpp"
+#include "robot_command.hpp"
+
+
+namespace wisson_SDK::control {
+
+// -----------------------------------------------------------------------------------
+//                              Enum Definitions
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Lifecycle of a submitted command, as seen by the client.
+ */
+enum class CommandState : uint8_t
+{
+  kQueued,    ///< Accepted, waiting for the robot to become free.
+  kRunning,   ///< Handed to the controller.
+  kFinished   ///< Done; see CommandHandle::Status() for the outcome.
+};
+
+
+namespace detail {
+
+[[nodiscard]] inline constexpr std::string_view CommandStateToString(CommandState state) noexcept
+{
+  switch (state)
+  {
+    case CommandState::kQueued:   return "Queued";
+    case CommandState::kRunning:  return "Running";
+    case CommandState::kFinished: return "Finished";
+    default:                      return "Unknown";
+  }
+}
+
+
+/**
+ * @brief State shared between a CommandHandle and the dispatcher.
+ */
+struct CommandHandleState
+{
+  std::shared_ptr<RobotCommand> cmd;
+  std::function<ResponseStatus()> run;  ///< Blocking execution of cmd.
+  std::atomic<CommandState> state{CommandState::kQueued};
+  std::atomic<bool> cancel_requested{false};
+  std::function<bool()> preempt;  ///< Stops a running command; empty if unsupported.
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  ResponseStatus final_status{ResponseStatus::kIdle};
+  std::exception_ptr error;
+  std::vector<std::function<void()>> callbacks;
+  std::unique_ptr<EventFd> notify_fd;   ///< Created by CommandHandle::NotifyFd().
+  CommandTimeline timeline;
+
+  CommandHandleState() { timeline.Mark(CommandStage::kSubmitted); }
+
+  /**
+   * @brief Publish the outcome and run completion callbacks (exactly once).
+   */
+  void Complete(ResponseStatus status, std::exception_ptr err = nullptr)
+  {
+    std::vector<std::function<void()>> to_run;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (state.load(std::memory_order_relaxed) == CommandState::kFinished) return;
+      timeline.Mark(CommandStage::kFinished);
+      final_status = status;
+      error = std::move(err);
+      state.store(CommandState::kFinished, std::memory_order_release);
+      to_run.swap(callbacks);
+      if (notify_fd) notify_fd->Notify();
+    }
+    cv.notify_all();
+    for (auto& cb : to_run) cb();
+  }
+};
+
+} // namespace detail
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Command Handle
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Shareable handle on one asynchronously executed RobotCommand.
+ *
+ * Copies refer to the same command. All members are thread-safe.
+ */
+class CommandHandle
+{
+public:
+  using Callback = std::function<void(const CommandHandle&)>;
+
+  CommandHandle() = default;
+  explicit CommandHandle(std::shared_ptr<detail::CommandHandleState> state) : state_(std::move(state)) {}
+
+  [[nodiscard]] bool Valid() const noexcept { return state_ != nullptr; }
+
+  [[nodiscard]] CommandState State() const noexcept { return state_->state.load(std::memory_order_acquire); }
+  [[nodiscard]] bool Done() const noexcept { return State() == CommandState::kFinished; }
+
+  /**
+   * @brief Outcome of the command; kSending/kWaiting while not finished.
+   */
+  [[nodiscard]] ResponseStatus Status() const
+  {
+    switch (State())
+    {
+      case CommandState::kQueued:  return ResponseStatus::kSending;
+      case CommandState::kRunning: return ResponseStatus::kWaiting;
+      default: break;
+    }
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->final_status;
+  }
+
+  /**
+   * @brief Index of the MotionCommand currently executed (RobotCommand::current_index).
+   */
+  [[nodiscard]] std::size_t CurrentIndex() const noexcept { return state_->cmd->current_index.load(); }
+
+  /**
+   * @brief Fraction of sub-commands completed, in [0, 1].
+   */
+  [[nodiscard]] double Progress() const noexcept
+  {
+    const std::size_t n = state_->cmd->commands.size();
+    if (Done() && Status() == ResponseStatus::kSuccess) return 1.0;
+    return n == 0 ? 0.0 : static_cast<double>(std::min(CurrentIndex(), n)) / static_cast<double>(n);
+  }
+
+  [[nodiscard]] const std::shared_ptr<RobotCommand>& Command() const noexcept { return state_->cmd; }
+
+  /**
+   * @brief Exception raised while executing, if any (e.g. NetworkException).
+   */
+  [[nodiscard]] std::exception_ptr Error() const
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->error;
+  }
+
+  /**
+   * @brief Block until the command finished or @p timeout elapsed.
+   * @return true if finished.
+   */
+  template <typename Rep, typename Period>
+  bool Wait(std::chrono::duration<Rep, Period> timeout) const
+  {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return state_->cv.wait_for(lock, timeout, [this] { return Done(); });
+  }
+
+  /**
+   * @brief Block until the command finished.
+   */
+  void Wait() const
+  {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->cv.wait(lock, [this] { return Done(); });
+  }
+
+  /**
+   * @brief Descriptor that becomes readable once the command finished.
+   *
+   * For applications with their own epoll / poll / asio loop: no thread blocks in
+   * Wait() and nothing polls Done(). Created on first call; owned by the command and
+   * valid while any copy of the handle exists, so remove it from the loop before the
+   * last copy goes. Reading it is optional.
+   * @throw ConstructorException if no eventfd can be created.
+   */
+  [[nodiscard]] int NotifyFd() const
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (!state_->notify_fd) {
+      state_->notify_fd = std::make_unique<EventFd>();
+      if (Done()) state_->notify_fd->Notify();
+    }
+    return state_->notify_fd->Fd();
+  }
+
+  /**
+   * @brief Lifecycle timestamps of the command (submission, send, acknowledge, waypoints,
+   *        completion). Stages the executing path does not report stay 0.
+   */
+  [[nodiscard]] const CommandTimeline& Timeline() const noexcept { return state_->timeline; }
+
+  /**
+   * @brief Request cancellation.
+   *
+   * A queued command is dropped and finishes with kUserStop. A running command is
+   * preempted through the hook passed to CommandDispatcher::Submit() and finishes with
+   * kUserStop; without a hook it runs to completion and false is returned.
+   * @return true if the command will not run (further).
+   */
+  bool Cancel()
+  {
+    state_->cancel_requested.store(true, std::memory_order_release);
+    CommandState expected = CommandState::kQueued;
+    if (state_->state.compare_exchange_strong(expected, CommandState::kRunning)) {
+      // Claimed before the dispatcher picked it up: it never reaches the robot.
+      state_->Complete(ResponseStatus::kUserStop);
+      return true;
+    }
+    if (State() == CommandState::kRunning && state_->preempt) {
+      if (!state_->preempt()) return false;
+      state_->Complete(ResponseStatus::kUserStop);
+      return true;
+    }
+    return Done();
+  }
+
+  /**
+   * @brief Register a completion callback.
+   *
+   * Runs on the dispatcher thread when the command finishes, or immediately on the
+   * calling thread if it already has. Keep callbacks short.
+   */
+  void OnComplete(Callback cb) const
+  {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (!Done()) {
+        state_->callbacks.emplace_back([self = *this, cb = std::move(cb)] { cb(self); });
+        return;
+      }
+    }
+    cb(*this);
+  }
+
+private:
+  std::shared_ptr<detail::CommandHandleState> state_;
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                            Command Dispatcher
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Executes submitted commands in FIFO order on one dedicated thread.
+ *
+ * Each job carries the blocking call that executes it (e.g. PerseusRobot::Control)
+ * and returns the final ResponseStatus. The worker sleeps on a condition variable
+ * between commands; there is no polling.
+ */
+class CommandDispatcher
+{
+public:
+  explicit CommandDispatcher(std::string thread_name = "SDK_Dispatch")
+    : shared_(std::make_shared<Shared>())
+  {
+    // The worker owns a reference, so a dispatcher destroyed from one of its own
+    // callbacks does not have to join itself.
+    std::thread([s = shared_, name = std::move(thread_name)] {
+      pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+      Run(*s);
+    }).detach();
+  }
+
+  ~CommandDispatcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      shared_->stop = true;
+    }
+    shared_->cv.notify_all();
+  }
+
+  CommandDispatcher(const CommandDispatcher&) = delete;
+  CommandDispatcher& operator=(const CommandDispatcher&) = delete;
+
+  /**
+   * @brief Queue a command and return its handle immediately.
+   * @param cmd     Command to execute.
+   * @param run     Blocking execution of @p cmd, returning the final status.
+   * @param preempt Optional hook used by CommandHandle::Cancel() while running.
+   */
+  CommandHandle Submit(std::shared_ptr<RobotCommand> cmd, std::function<ResponseStatus()> run,
+                       std::function<bool()> preempt = {})
+  {
+    if (!cmd || !run) {
+      throw wisson_SDK::InvalidOperationException("libperseus-CommandDispatcher: null RobotCommand or executor.");
+    }
+    auto state = std::make_shared<detail::CommandHandleState>();
+    state->cmd = std::move(cmd);
+    state->run = std::move(run);
+    state->preempt = std::move(preempt);
+    {
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      if (shared_->stop) {
+        throw wisson_SDK::InvalidOperationException("libperseus-CommandDispatcher: dispatcher stopped.");
+      }
+      shared_->queue.push_back(state);
+    }
+    shared_->cv.notify_one();
+    return CommandHandle(std::move(state));
+  }
+
+  /**
+   * @brief Number of commands waiting (excluding the running one).
+   */
+  [[nodiscard]] std::size_t Pending() const
+  {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->queue.size();
+  }
+
+  /**
+   * @brief Dispatcher dedicated to @p owner, created on first use.
+   *
+   * Entries of destroyed owners are released on the next lookup.
+   */
+  static std::shared_ptr<CommandDispatcher> ForOwner(const std::shared_ptr<const void>& owner,
+                                                     const std::string& thread_name = "SDK_Dispatch")
+  {
+    static std::mutex registry_mutex;
+    static std::unordered_map<const void*, std::pair<std::weak_ptr<const void>, std::shared_ptr<CommandDispatcher>>> registry;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::erase_if(registry, [](const auto& entry) { return entry.second.first.expired(); });
+    auto& slot = registry[owner.get()];
+    if (!slot.second) {
+      slot = {owner, std::make_shared<CommandDispatcher>(thread_name)};
+    }
+    return slot.second;
+  }
+
+private:
+  struct Shared
+  {
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::shared_ptr<detail::CommandHandleState>> queue;
+    bool stop{false};
+  };
+
+  static void Run(Shared& s)
+  {
+    for (;;) {
+      std::shared_ptr<detail::CommandHandleState> job;
+      {
+        std::unique_lock<std::mutex> lock(s.mutex);
+        s.cv.wait(lock, [&] { return s.stop || !s.queue.empty(); });
+        if (s.queue.empty()) return;  // stopped and drained
+        job = std::move(s.queue.front());
+        s.queue.pop_front();
+      }
+
+      // Cancelled while queued: already completed by CommandHandle::Cancel().
+      CommandState expected = CommandState::kQueued;
+      if (!job->state.compare_exchange_strong(expected, CommandState::kRunning)) {
+        job->run = nullptr;
+        continue;
+      }
+
+      try {
+        job->Complete(job->run());
+      } catch (...) {
+        job->Complete(ResponseStatus::kFail, std::current_exception());
+      }
+      job->run = nullptr;  // drop captured resources (e.g. the robot) early
+    }
+  }
+
+private:
+  std::shared_ptr<Shared> shared_;
+};
+
+}  // namespace wisson_SDK::control
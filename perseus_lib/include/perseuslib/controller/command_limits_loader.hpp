@@ -0,0 +1,76 @@
+/**
+ * @file command_limits_loader.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Reads CommandLimits from the CommandLimits section of config.yaml.
+ *
+ * Kept apart from command_validator.hpp so that validating does not require yaml-cpp.
+ *
+ * @example:
+ *   const auto limits = LoadCommandLimits(CONFIG_PATH "/config.yaml");
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include <yaml-cpp/yaml.h>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "command_validator.hpp"
+
+
+namespace wisson_SDK::control {
+
+namespace detail {
+
+inline constexpr char kCommandLimitsKey[]    = "CommandLimits";
+inline constexpr char kPositionMinKey[]      = "Joint-Position-Min";
+inline constexpr char kPositionMaxKey[]      = "Joint-Position-Max";
+inline constexpr char kVelocityMaxKey[]      = "Joint-Velocity-Max";
+inline constexpr char kAccelerationMaxKey[]  = "Joint-Acceleration-Max";
+inline constexpr char kRigidToleranceKey[]   = "Rigid-Tolerance";
+
+inline void ReadJointArray(const YAML::Node& node, const char* key, std::array<double, JOINT_NUM>& out)
+{
+  if (!node[key]) return;
+  if (!node[key].IsSequence() || node[key].size() != JOINT_NUM) {
+    throw wisson_SDK::ConstructorException(std::string("libperseus-CommandLimits: ") + key + " must list " +
+                                           std::to_string(JOINT_NUM) + " values.");
+  }
+  for (std::size_t j = 0; j < JOINT_NUM; ++j) out[j] = node[key][j].as<double>();
+}
+
+} // namespace detail
+
+/**
+ * @brief Read the CommandLimits section of config.yaml.
+ *
+ * Missing keys (or a missing section) leave the corresponding limits unlimited.
+ * @throw ConstructorException if the file cannot be parsed or a list has the wrong length.
+ */
+[[nodiscard]] inline CommandLimits LoadCommandLimits(const std::string& config_path)
+{
+  CommandLimits limits = CommandLimits::Unlimited();
+  try {
+    const YAML::Node root = YAML::LoadFile(config_path);
+    const YAML::Node node = root[detail::kCommandLimitsKey];
+    if (!node) return limits;
+    detail::ReadJointArray(node, detail::kPositionMinKey, limits.position_min);
+    detail::ReadJointArray(node, detail::kPositionMaxKey, limits.position_max);
+    detail::ReadJointArray(node, detail::kVelocityMaxKey, limits.velocity_max);
+    detail::ReadJointArray(node, detail::kAccelerationMaxKey, limits.acceleration_max);
+    if (node[detail::kRigidToleranceKey]) limits.rigid_tolerance = node[detail::kRigidToleranceKey].as<double>();
+  } catch (const YAML::Exception& e) {
+    throw wisson_SDK::ConstructorException("libperseus-CommandLimits: cannot read " + config_path + ": " + e.what());
+  }
+  return limits;
+}
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,319 @@
+/**
+ * @file command_pipeline.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Bounded per-controller submission queue with command pipelining.
+ *
+ * Without pipelining the next RobotCommand is serialized and sent only after the
+ * previous one reported kSuccess, so the robot idles for a full round trip between
+ * motions. CommandPipeline serializes commands when they are submitted and keeps
+ * up to `depth` of them on the wire; with CapabilityFlag::kCmdPipelining the
+ * server starts the next one the moment the current one completes, and discards
+ * the ones queued behind a command that fails, aborts or times out.
+ *
+ * @example:
+ *   CommandPipeline pipeline(serialize, send);
+ *   pipeline.SetDepth(caps.cmd_pipelining ? kDefaultPipelineDepth : 1);
+ *   auto h1 = pipeline.Submit(approach);     // sent immediately
+ *   auto h2 = pipeline.Submit(grasp);        // pre-serialized and sent ahead
+ *   // io thread: pipeline.OnResponse(cmd_id, status);
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "command_handle.hpp"
+#include "controller.h"
+
+
+namespace wisson_SDK::control {
+
+// -----------------------------------------------------------------------------------
+//                                Constants
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Commands on the wire at once: the executing one plus one sent ahead.
+ */
+inline constexpr std::size_t kDefaultPipelineDepth = 2;
+
+/**
+ * @brief Commands accepted by Submit() before it blocks.
+ */
+inline constexpr std::size_t kDefaultPipelineCapacity = 8;
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Command Pipeline
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Per-controller FIFO of RobotCommands with send-ahead.
+ *
+ * Submit() may be called from any thread; OnResponse() and Abort() from the io
+ * thread. The sender is called with the internal lock held and must not block
+ * (e.g. network::SendQueue::Submit). A command whose frame cannot be sent finishes
+ * with kFail. A command finishing with anything but kSuccess finishes every command
+ * behind it with kAbort, so no motion runs after a failed one; the pipeline stays
+ * usable for later submissions.
+ */
+class CommandPipeline
+{
+public:
+  using Frame = std::vector<uint8_t>;
+  using Serializer = std::function<Frame(const RobotCommand&)>;
+  using Sender = std::function<bool(const Frame&)>;
+
+  CommandPipeline(Serializer serializer, Sender sender,
+                  std::size_t capacity = kDefaultPipelineCapacity, std::size_t depth = kDefaultPipelineDepth)
+    : serializer_(std::move(serializer)), sender_(std::move(sender)),
+      capacity_(std::max<std::size_t>(capacity, 1)), depth_(std::clamp<std::size_t>(depth, 1, capacity_))
+  {
+    if (!serializer_ || !sender_) {
+      throw wisson_SDK::ConstructorException("libperseus-CommandPipeline: serializer and sender are required.");
+    }
+  }
+
+  CommandPipeline(const CommandPipeline&) = delete;
+  CommandPipeline& operator=(const CommandPipeline&) = delete;
+
+  /**
+   * @brief Set the number of commands kept on the wire (1 = no pipelining).
+   */
+  void SetDepth(std::size_t depth)
+  {
+    std::vector<std::shared_ptr<detail::CommandHandleState>> failed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      depth_ = std::clamp<std::size_t>(depth, 1, capacity_);
+      PumpLocked(failed);
+    }
+    CompleteFailed(failed);
+  }
+
+  /**
+   * @brief Serialize @p cmd and queue it, blocking while the queue is full.
+   * @throw NetworkException if the pipeline was aborted.
+   */
+  CommandHandle Submit(std::shared_ptr<RobotCommand> cmd)
+  {
+    auto entry = MakeEntry(std::move(cmd));
+    std::vector<std::shared_ptr<detail::CommandHandleState>> failed;
+    CommandHandle handle;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_full_.wait(lock, [this] { return aborted_ || entries_.size() < capacity_; });
+      handle = EnqueueLocked(std::move(entry), failed);
+    }
+    CompleteFailed(failed);
+    return handle;
+  }
+
+  /**
+   * @brief Non-blocking Submit(); std::nullopt if the queue is full.
+   */
+  std::optional<CommandHandle> TrySubmit(std::shared_ptr<RobotCommand> cmd)
+  {
+    auto entry = MakeEntry(std::move(cmd));
+    std::vector<std::shared_ptr<detail::CommandHandleState>> failed;
+    CommandHandle handle;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!aborted_ && entries_.size() >= capacity_) return std::nullopt;
+      handle = EnqueueLocked(std::move(entry), failed);
+    }
+    CompleteFailed(failed);
+    return handle;
+  }
+
+  /**
+   * @brief Feed a command response received from the server.
+   * @return false if @p cmd_id does not belong to this pipeline.
+   */
+  bool OnResponse(uint32_t cmd_id, ResponseStatus status)
+  {
+    std::shared_ptr<detail::CommandHandleState> finished;
+    std::deque<Entry> behind;
+    std::vector<std::shared_ptr<detail::CommandHandleState>> failed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = std::find_if(entries_.begin(), entries_.end(),
+                             [cmd_id](const Entry& e) { return e.state->cmd->cmd_id == cmd_id; });
+      if (it == entries_.end()) return false;
+
+      RobotCommand& cmd = *it->state->cmd;
+      if (status == ResponseStatus::kSubSuccess) {
+        cmd.Advance();
+        return true;
+      }
+      if (!detail::IsActionFinished(status)) {
+        cmd.status = status;
+        return true;
+      }
+      cmd.status = status;
+      cmd.finished = true;
+      finished = it->state;
+      entries_.erase(it);
+      if (status == ResponseStatus::kSuccess) {
+        PumpLocked(failed);
+      } else {
+        // Commands sent ahead or queued were planned to follow this one.
+        behind.swap(entries_);
+      }
+    }
+    not_full_.notify_all();
+    finished->Complete(status);
+    for (auto& e : behind) {
+      e.state->cmd->status = ResponseStatus::kAbort;
+      e.state->Complete(ResponseStatus::kAbort);
+    }
+    CompleteFailed(failed);
+    return true;
+  }
+
+  /**
+   * @brief Fail every pending command, e.g. after the connection was lost.
+   */
+  void Abort(ResponseStatus status = ResponseStatus::kAbort)
+  {
+    std::deque<Entry> pending;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      aborted_ = true;
+      pending.swap(entries_);
+    }
+    not_full_.notify_all();
+    for (auto& e : pending) {
+      e.state->cmd->status = status;
+      e.state->Complete(status);
+    }
+  }
+
+  /**
+   * @brief Commands sent and not yet finished.
+   */
+  [[nodiscard]] std::size_t InFlight() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<std::size_t>(std::count_if(entries_.begin(), entries_.end(), [](const Entry& e) { return e.sent; }));
+  }
+
+  /**
+   * @brief Commands accepted and not yet finished (sent or not).
+   */
+  [[nodiscard]] std::size_t Size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+private:
+  struct Entry
+  {
+    std::shared_ptr<detail::CommandHandleState> state;
+    Frame frame;         ///< Serialized at submission, released once sent.
+    bool sent{false};
+  };
+
+  Entry MakeEntry(std::shared_ptr<RobotCommand> cmd)
+  {
+    if (!cmd) {
+      throw wisson_SDK::InvalidOperationException("libperseus-CommandPipeline: null RobotCommand.");
+    }
+    if (cmd->cmd_id == 0) cmd->cmd_id = Controller::GenerateCommandId();
+    cmd->status = ResponseStatus::kSending;
+
+    Entry entry;
+    entry.state = std::make_shared<detail::CommandHandleState>();
+    entry.frame = serializer_(*cmd);  // outside the lock: overlaps the running command
+    entry.state->cmd = std::move(cmd);
+    return entry;
+  }
+
+  CommandHandle EnqueueLocked(Entry entry, std::vector<std::shared_ptr<detail::CommandHandleState>>& failed)
+  {
+    if (aborted_) {
+      throw wisson_SDK::NetworkException("libperseus-CommandPipeline: pipeline aborted.");
+    }
+    CommandHandle handle(entry.state);
+    entries_.push_back(std::move(entry));
+    PumpLocked(failed);
+    return handle;
+  }
+
+  /**
+   * @brief Send queued entries until `depth_` are on the wire.
+   *
+   * Entries whose frame cannot be sent are removed and returned in @p failed, to be
+   * completed once the lock is released.
+   */
+  void PumpLocked(std::vector<std::shared_ptr<detail::CommandHandleState>>& failed)
+  {
+    std::size_t in_flight = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->sent) {
+        ++in_flight;
+        ++it;
+        continue;
+      }
+      // Cancelled through its handle before being sent.
+      if (it->state->state.load() != CommandState::kQueued) {
+        it = entries_.erase(it);
+        not_full_.notify_all();
+        continue;
+      }
+      if (in_flight >= depth_) break;
+
+      CommandState expected = CommandState::kQueued;
+      if (!it->state->state.compare_exchange_strong(expected, CommandState::kRunning)) {
+        continue;  // lost the race against Cancel(); erased on the next iteration
+      }
+      if (!sender_(it->frame)) {
+        it->state->cmd->status = ResponseStatus::kFail;
+        failed.push_back(std::move(it->state));
+        it = entries_.erase(it);
+        not_full_.notify_all();
+        continue;
+      }
+      it->state->cmd->status = ResponseStatus::kWaiting;
+      it->sent = true;
+      Frame().swap(it->frame);
+      ++in_flight;
+      ++it;
+    }
+  }
+
+  static void CompleteFailed(const std::vector<std::shared_ptr<detail::CommandHandleState>>& failed)
+  {
+    for (const auto& s : failed) s->Complete(ResponseStatus::kFail);
+  }
+
+private:
+  Serializer serializer_;
+  Sender sender_;
+  const std::size_t capacity_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::deque<Entry> entries_;
+  std::size_t depth_;
+  bool aborted_{false};
+};
+
+}  // namespace wisson_SDK::control
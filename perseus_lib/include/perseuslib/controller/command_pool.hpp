@@ -0,0 +1,210 @@
+/**
+ * @file command_pool.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Recycled RobotCommands for allocation-free command submission.
+ *
+ * This header contains:
+ *  - RobotCommandPool : fixed set of RobotCommands handed out as shared_ptr and
+ *                       returned to the pool when the last reference is dropped
+ *
+ * RobotCommand::CreateCommands() allocates the command, its shared_ptr control
+ * block and the entry vector on every call. A pooled command is built once with
+ * room for cmd_list_size entries; its control block lives in a slot next to it,
+ * so acquiring, filling and dropping a command does not touch the heap. Together
+ * with the range helpers of RobotCommand (JointPositions(), Timeouts(), ...) and a
+ * reused frame buffer, the submission path runs without allocation after warm-up.
+ *
+ * @example:
+ *   RobotCommandPool pool(32);
+ *   auto cmd = pool.AcquireCommands(path);   // nullptr if all 32 are in flight
+ *   robot->Control(ControllerMode::JointPosition(), cmd);
+ *   cmd.reset();                             // back to the pool
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <vector>
+
+#include "perseuslib/common/mpsc_queue.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+#include "controller.h"
+
+
+namespace wisson_SDK::control {
+
+/**
+ * @brief Default number of pooled commands.
+ */
+inline constexpr std::size_t kDefaultCommandPoolSize = 64;
+
+
+namespace detail {
+
+/**
+ * @brief Storage shared by a pool and the commands it handed out, so commands may
+ *        outlive the RobotCommandPool object.
+ */
+struct CommandPoolState
+{
+  /// Room for the shared_ptr control block of one command.
+  struct alignas(std::max_align_t) ControlBlock
+  {
+    unsigned char bytes[96];
+  };
+
+  explicit CommandPoolState(uint32_t size) : blocks(size), free_list(size) {}
+
+  std::vector<std::unique_ptr<RobotCommand>> commands;
+  std::vector<ControlBlock> blocks;
+  IndexFreeList free_list;
+};
+
+/**
+ * @brief Hands out the control block slot of one pooled command. The slot (and
+ *        with it the command) is released when the control block is freed, i.e.
+ *        after the last shared_ptr and weak_ptr are gone.
+ */
+template <typename T>
+struct CommandSlotAllocator
+{
+  using value_type = T;
+
+  CommandSlotAllocator(std::shared_ptr<CommandPoolState> s, uint32_t i) noexcept : state(std::move(s)), slot(i) {}
+
+  template <typename U>
+  CommandSlotAllocator(const CommandSlotAllocator<U>& other) noexcept : state(other.state), slot(other.slot) {}
+
+  T* allocate(std::size_t n)
+  {
+    static_assert(sizeof(T) <= sizeof(CommandPoolState::ControlBlock) &&
+                  alignof(T) <= alignof(CommandPoolState::ControlBlock),
+                  "CommandPoolState::ControlBlock too small for this standard library");
+    if (n != 1) throw std::bad_alloc();
+    return reinterpret_cast<T*>(&state->blocks[slot]);
+  }
+
+  void deallocate(T*, std::size_t) noexcept { state->free_list.Release(slot); }
+
+  template <typename U>
+  bool operator==(const CommandSlotAllocator<U>& other) const noexcept
+  {
+    return state == other.state && slot == other.slot;
+  }
+
+  std::shared_ptr<CommandPoolState> state;
+  uint32_t slot;
+};
+
+} // namespace detail
+
+
+// -----------------------------------------------------------------------------------
+//                              Robot Command Pool
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Fixed-size pool of RobotCommands.
+ *
+ * Acquire*() is lock-free and safe from any thread; commands go back to the pool
+ * from whichever thread drops the last reference. A command returns reset
+ * (cmd_id 0, kIdle, no entries) with its entry storage kept.
+ */
+class RobotCommandPool
+{
+public:
+  explicit RobotCommandPool(std::size_t pool_size = kDefaultCommandPoolSize)
+    : state_(std::make_shared<detail::CommandPoolState>(static_cast<uint32_t>(pool_size)))
+  {
+    if (pool_size == 0) {
+      throw wisson_SDK::ConstructorException("libperseus-RobotCommandPool: pool size must be non-zero.");
+    }
+    state_->commands.reserve(pool_size);
+    for (std::size_t i = 0; i < pool_size; ++i) {
+      state_->commands.emplace_back(new RobotCommand());
+      state_->commands.back()->commands.reserve(cmd_list_size);
+    }
+  }
+
+  RobotCommandPool(const RobotCommandPool&) = delete;
+  RobotCommandPool& operator=(const RobotCommandPool&) = delete;
+
+  /**
+   * @brief Pooled counterpart of RobotCommand::CreateCommands().
+   * @param sequence Any sized range of MotionCommand / TorqueCommand / EndEffectorCommand.
+   * @return Command, or nullptr if every pooled command is in use.
+   * @throw ConstructorException if @p sequence is empty or longer than cmd_list_size.
+   */
+  template <std::ranges::sized_range Sequence>
+  std::shared_ptr<RobotCommand> AcquireCommands(const Sequence& sequence, double total_timeout_s = 30.0)
+  {
+    const std::size_t n = std::ranges::size(sequence);
+    if (n == 0 || n > cmd_list_size) {
+      throw wisson_SDK::ConstructorException("libperseus-RobotCommandPool: Input command vectors are incorrect.");
+    }
+    auto cmd = Take();
+    if (!cmd) return nullptr;
+    cmd->cmd_size = n;
+    cmd->total_timeout = total_timeout_s;
+    for (const auto& c : sequence) cmd->commands.emplace_back(c);
+    return cmd;
+  }
+
+  /**
+   * @brief Pooled counterpart of RobotCommand::CreateCommand().
+   * @return Command, or nullptr if every pooled command is in use.
+   */
+  template <typename CommandType>
+  std::shared_ptr<RobotCommand> AcquireCommand(const CommandType& c)
+  {
+    auto cmd = Take();
+    if (!cmd) return nullptr;
+    cmd->cmd_size = 1;
+    cmd->total_timeout = c.timeout;
+    cmd->commands.emplace_back(c);
+    return cmd;
+  }
+
+  [[nodiscard]] std::size_t Size() const noexcept { return state_->commands.size(); }
+
+private:
+  /**
+   * @brief Resets a command when its last shared_ptr is dropped; the slot itself is
+   *        released by CommandSlotAllocator once the control block goes.
+   */
+  struct Recycler
+  {
+    void operator()(RobotCommand* cmd) const noexcept
+    {
+      cmd->commands.clear();
+      cmd->cmd_id = 0;
+      cmd->cmd_size = 0;
+      cmd->total_timeout = 30.0;
+      cmd->current_index = 0;
+      cmd->finished = false;
+      cmd->status = ResponseStatus::kIdle;
+    }
+  };
+
+  std::shared_ptr<RobotCommand> Take()
+  {
+    const uint32_t slot = state_->free_list.Acquire();
+    if (slot == IndexFreeList::kInvalid) return nullptr;
+    return std::shared_ptr<RobotCommand>(state_->commands[slot].get(), Recycler{},
+                                         detail::CommandSlotAllocator<RobotCommand>(state_, slot));
+  }
+
+private:
+  std::shared_ptr<detail::CommandPoolState> state_;
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,188 @@
+/**
+ * @file command_sequence.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Heterogeneous command sequences with one controller mode per step.
+ *
+ * This header contains:
+ *  - DefaultStepMode()   : controller mode an entry runs in unless told otherwise
+ *  - CommandSequence     : builder for move / gripper / torque steps, e.g. move,
+ *                          close gripper, move, submitted as one RobotCommand
+ *  - SequenceSegment     : run of consecutive steps sharing a mode, for transports
+ *                          without a sequence frame path
+ *
+ * With CapabilityFlag::kMixedSequences a transport can send the whole sequence in
+ * one sequence frame (network/sequence_frame.hpp) and the server chains the steps,
+ * switching modes between them without a round trip or a stop. Not wired into the
+ * shipped transport yet: it sends no sequence frames, and PerseusRobot has no
+ * sequence entry point. Until then Split() yields one RobotCommand per mode run,
+ * to be executed one Control() call after another; that is the separate-call
+ * pattern, with a stop and a round trip at every mode change.
+ *
+ * @example:
+ *   CommandSequence seq;
+ *   seq.Move(pre_grasp, 2.0).Move(grasp, 1.0).Gripper(EndEffectorAction::Close, 1.0).Move(lift, 2.0);
+ *   for (auto& segment : seq.Split()) {
+ *     robot->Control(segment.mode, segment.cmd);
+ *     if (segment.cmd->status != ResponseStatus::kSuccess) break;
+ *   }
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "controller.h"
+
+
+namespace wisson_SDK::control {
+
+/**
+ * @brief Mode an entry runs in by default: joint position for motions, joint torque
+ *        for torques, task command for end-effector actions.
+ */
+[[nodiscard]] inline constexpr ControllerMode DefaultStepMode(const SDKCmdVariant& step) noexcept
+{
+  if (std::holds_alternative<TorqueCommand>(step)) return ControllerMode::JointTorque();
+  if (std::holds_alternative<EndEffectorCommand>(step)) return ControllerMode::TaskCommand();
+  return ControllerMode::JointPosition();
+}
+
+
+/**
+ * @brief Consecutive steps of a sequence that share one controller mode.
+ */
+struct SequenceSegment
+{
+  ControllerMode mode;
+  std::shared_ptr<RobotCommand> cmd;
+  std::size_t first_step{0};   ///< Index of the segment's first step in the sequence.
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Command Sequence
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Ordered steps with their controller modes (at most cmd_list_size).
+ */
+class CommandSequence
+{
+public:
+  /**
+   * @brief Append @p step executed in @p mode.
+   * @throw CommandException if @p step cannot run in @p mode, @p mode is impedance
+   *        (gains are per command, not per step) or the sequence is full.
+   */
+  CommandSequence& Then(const SDKCmdVariant& step, const ControllerMode& mode)
+  {
+    if (!detail::IsCommandSupported(mode, step) || mode.type == ControlType::kImpedance) {
+      throw wisson_SDK::CommandException("libperseus-CommandSequence: step " + std::to_string(steps_.size()) +
+                                         " cannot run in mode " + mode.ModeToString() + ".");
+    }
+    if (steps_.size() >= cmd_list_size) {
+      throw wisson_SDK::CommandException("libperseus-CommandSequence: more than " + std::to_string(cmd_list_size) +
+                                         " steps.");
+    }
+    steps_.push_back(step);
+    modes_.push_back(mode);
+    return *this;
+  }
+
+  CommandSequence& Then(const SDKCmdVariant& step) { return Then(step, DefaultStepMode(step)); }
+
+  /**
+   * @brief Joint position move.
+   */
+  CommandSequence& Move(const std::array<double, JOINT_NUM>& joint_positions, double timeout_s)
+  {
+    return Then(MotionCommand::CreateCommand(joint_positions, timeout_s), ControllerMode::JointPosition());
+  }
+
+  CommandSequence& Gripper(EndEffectorAction action, double timeout_s)
+  {
+    return Then(EndEffectorCommand{.ee_action = action, .timeout = timeout_s}, ControllerMode::TaskCommand());
+  }
+
+  CommandSequence& Torque(const std::array<double, JOINT_NUM>& desired_torque, double timeout_s)
+  {
+    return Then(TorqueCommand::CreateCommand(desired_torque, timeout_s), ControllerMode::JointTorque());
+  }
+
+  [[nodiscard]] std::size_t Size() const noexcept { return steps_.size(); }
+  [[nodiscard]] bool Empty() const noexcept { return steps_.empty(); }
+  [[nodiscard]] std::span<const SDKCmdVariant> Steps() const noexcept { return steps_; }
+  [[nodiscard]] std::span<const ControllerMode> Modes() const noexcept { return modes_; }
+
+  /**
+   * @brief Number of mode changes between consecutive steps.
+   */
+  [[nodiscard]] std::size_t ModeChanges() const noexcept
+  {
+    std::size_t n = 0;
+    for (std::size_t i = 1; i < modes_.size(); ++i) n += modes_[i] != modes_[i - 1];
+    return n;
+  }
+
+  /**
+   * @brief All steps as one RobotCommand; pair it with Modes() for a sequence frame.
+   * @throw ConstructorException if the sequence is empty.
+   */
+  [[nodiscard]] std::shared_ptr<RobotCommand> Build(double total_timeout_s = 30.0) const
+  {
+    return RobotCommand::CreateCommands(steps_, total_timeout_s);
+  }
+
+  /**
+   * @brief One RobotCommand per run of steps sharing a mode, in order, for Control().
+   *
+   * Each segment's total timeout is the sum of its step timeouts, capped by
+   * @p total_timeout_s. The cap applies per segment; a deadline for the whole
+   * sequence is up to the caller.
+   * @throw CommandException if a step's mode cannot be executed by Control() (e.g.
+   *        Torque(); see detail::IsControlModeSupported()). Such sequences need a
+   *        sequence frame.
+   */
+  [[nodiscard]] std::vector<SequenceSegment> Split(double total_timeout_s = 30.0) const
+  {
+    for (std::size_t i = 0; i < modes_.size(); ++i) {
+      if (!detail::IsControlModeSupported(modes_[i])) {
+        throw wisson_SDK::CommandException("libperseus-CommandSequence: step " + std::to_string(i) + " in mode " +
+                                           modes_[i].ModeToString() + " cannot be executed by Control().");
+      }
+    }
+    std::vector<SequenceSegment> segments;
+    for (std::size_t begin = 0; begin < steps_.size();) {
+      std::size_t end = begin + 1;
+      while (end < steps_.size() && modes_[end] == modes_[begin]) ++end;
+
+      const std::vector<SDKCmdVariant> run(steps_.begin() + static_cast<std::ptrdiff_t>(begin),
+                                           steps_.begin() + static_cast<std::ptrdiff_t>(end));
+      double timeout = 0.0;
+      for (const auto& step : run) timeout += std::visit([](const auto& c) { return c.timeout; }, step);
+      segments.push_back({modes_[begin], RobotCommand::CreateCommands(run, std::min(timeout, total_timeout_s)), begin});
+      begin = end;
+    }
+    return segments;
+  }
+
+private:
+  std::vector<SDKCmdVariant> steps_;
+  std::vector<ControllerMode> modes_;
+};
+
+}  // namespace wisson_SDK::control
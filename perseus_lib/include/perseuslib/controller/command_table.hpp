@@ -0,0 +1,521 @@
+/**
+ * @file command_table.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Several in-flight commands per robot, routed by cmd_id.
+ *
+ * This header contains:
+ *  - CommandResource : robot parts a command occupies (arms, end effector)
+ *  - InFlightTable   : lock-striped table cmd_id -> command; routing a response
+ *                      only locks the stripe of its cmd_id
+ *  - CommandMultiplexer : per-resource dispatch; commands on disjoint resources
+ *                      run concurrently, commands sharing a resource keep their
+ *                      submission order; per-segment lifecycle latency in Stats()
+ *
+ * @example:
+ *   CommandMultiplexer mux(send_command);
+ *   auto left  = mux.Submit(pick_left,  CommandResource::kLeftArm);
+ *   auto right = mux.Submit(pick_right, CommandResource::kRightArm);   // runs concurrently
+ *   auto grip  = mux.Submit(close_cmd,  CommandResource::kEndEffector);
+ *   // io thread: mux.OnWritten(cmd_id); mux.OnResponse(cmd_id, status);
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "command_handle.hpp"
+#include "controller.h"
+
+
+namespace wisson_SDK::control {
+
+// -----------------------------------------------------------------------------------
+//                                 Resources
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Robot parts a command occupies. Combined as a bitmask (ResourceMask).
+ */
+enum class CommandResource : uint32_t
+{
+  kLeftArm     = 1u << 0,
+  kRightArm    = 1u << 1,
+  kEndEffector = 1u << 2,
+};
+
+using ResourceMask = uint32_t;
+
+inline constexpr ResourceMask kAllResources = 0x7u;
+
+[[nodiscard]] inline constexpr ResourceMask operator|(CommandResource a, CommandResource b) noexcept
+  { return static_cast<ResourceMask>(a) | static_cast<ResourceMask>(b); }
+[[nodiscard]] inline constexpr ResourceMask ToMask(CommandResource r) noexcept
+  { return static_cast<ResourceMask>(r); }
+
+/**
+ * @brief Default resources of @p cmd: end-effector commands occupy the end effector,
+ *        anything else both arms (joint arrays span the whole robot).
+ */
+[[nodiscard]] inline ResourceMask DefaultResources(const RobotCommand& cmd) noexcept
+{
+  ResourceMask mask = 0;
+  for (const auto& c : cmd.commands) {
+    mask |= std::holds_alternative<EndEffectorCommand>(c) ? ToMask(CommandResource::kEndEffector)
+                                                          : CommandResource::kLeftArm | CommandResource::kRightArm;
+  }
+  return mask == 0 ? kAllResources : mask;
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                               In-flight Table
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Commands sent to the server and not yet finished, keyed by cmd_id.
+ *
+ * Entries are spread over kStripes independently locked buckets, so responses for
+ * different commands are routed in parallel and never wait on a global lock.
+ */
+class InFlightTable
+{
+public:
+  static constexpr std::size_t kStripes = 16;
+
+  struct Entry
+  {
+    std::shared_ptr<detail::CommandHandleState> state;
+    ResourceMask resources{0};
+  };
+
+  enum class RouteResult : uint8_t
+  {
+    kUnknown,    ///< No command with this cmd_id is in flight.
+    kProgress,   ///< Intermediate status applied.
+    kFinished    ///< Final status applied; the entry was removed.
+  };
+
+  /**
+   * @return false if a command with the same cmd_id is already in flight.
+   */
+  bool Insert(Entry entry)
+  {
+    const uint32_t id = entry.state->cmd->cmd_id;
+    Stripe& stripe = StripeFor(id);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    if (!stripe.entries.emplace(id, std::move(entry)).second) return false;
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Apply a response to its command.
+   * @param finished Receives the removed entry when the command finished.
+   */
+  RouteResult Route(uint32_t cmd_id, ResponseStatus status, Entry& finished)
+  {
+    Stripe& stripe = StripeFor(cmd_id);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.entries.find(cmd_id);
+    if (it == stripe.entries.end()) return RouteResult::kUnknown;
+
+    RobotCommand& cmd = *it->second.state->cmd;
+    CommandTimeline& timeline = it->second.state->timeline;
+    timeline.Mark(CommandStage::kAcked);
+    if (status == ResponseStatus::kSubSuccess) {
+      timeline.MarkWaypoint();
+      cmd.Advance();
+      return RouteResult::kProgress;
+    }
+    cmd.status = status;
+    if (!detail::IsActionFinished(status)) return RouteResult::kProgress;
+
+    cmd.finished = true;
+    finished = std::move(it->second);
+    stripe.entries.erase(it);
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return RouteResult::kFinished;
+  }
+
+  /**
+   * @brief Record @p stage of an in-flight command.
+   * @return false if @p cmd_id is not in flight.
+   */
+  bool Mark(uint32_t cmd_id, CommandStage stage, int64_t t_ns = timer::SteadyNowNs())
+  {
+    Stripe& stripe = StripeFor(cmd_id);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    auto it = stripe.entries.find(cmd_id);
+    if (it == stripe.entries.end()) return false;
+    it->second.state->timeline.Mark(stage, t_ns);
+    return true;
+  }
+
+  [[nodiscard]] bool Contains(uint32_t cmd_id)
+  {
+    Stripe& stripe = StripeFor(cmd_id);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    return stripe.entries.count(cmd_id) != 0;
+  }
+
+  /**
+   * @brief Remove one entry without completing it.
+   */
+  bool Erase(uint32_t cmd_id)
+  {
+    Stripe& stripe = StripeFor(cmd_id);
+    std::lock_guard<std::mutex> lock(stripe.mutex);
+    if (stripe.entries.erase(cmd_id) == 0) return false;
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Remove and return every entry.
+   */
+  std::vector<Entry> Drain()
+  {
+    std::vector<Entry> out;
+    for (auto& stripe : stripes_) {
+      std::lock_guard<std::mutex> lock(stripe.mutex);
+      for (auto& [id, e] : stripe.entries) out.push_back(std::move(e));
+      size_.fetch_sub(stripe.entries.size(), std::memory_order_relaxed);
+      stripe.entries.clear();
+    }
+    return out;
+  }
+
+  /**
+   * @brief Remove and return every entry occupying one of @p resources.
+   */
+  std::vector<Entry> Drain(ResourceMask resources)
+  {
+    std::vector<Entry> out;
+    for (auto& stripe : stripes_) {
+      std::lock_guard<std::mutex> lock(stripe.mutex);
+      for (auto it = stripe.entries.begin(); it != stripe.entries.end();) {
+        if ((it->second.resources & resources) == 0) {
+          ++it;
+          continue;
+        }
+        out.push_back(std::move(it->second));
+        it = stripe.entries.erase(it);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+    return out;
+  }
+
+  [[nodiscard]] std::size_t Size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+private:
+  struct alignas(64) Stripe
+  {
+    std::mutex mutex;
+    std::unordered_map<uint32_t, Entry> entries;
+  };
+
+  Stripe& StripeFor(uint32_t cmd_id) noexcept { return stripes_[cmd_id % kStripes]; }
+
+private:
+  std::array<Stripe, kStripes> stripes_;
+  std::atomic<std::size_t> size_{0};
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                            Command Multiplexer
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Per-resource command dispatch on one connection.
+ *
+ * A submitted command is sent as soon as none of its resources is occupied by a
+ * running command or claimed by an earlier waiting one. Submit() may be called
+ * from any thread, OnResponse() / Abort() from the io thread. The sender runs with
+ * the scheduling lock held and must not block (e.g. network::SendQueue::Submit).
+ *
+ * Every command carries a CommandTimeline. A TimedSender stamps kSerialized and
+ * kEnqueued itself; a plain Sender is timed as a whole, both stamped when it
+ * returns. The io thread reports kWritten through OnWritten(); responses stamp
+ * kAcked, the waypoints and kFinished. Commands finished by the server are
+ * aggregated into Stats().
+ */
+class CommandMultiplexer
+{
+public:
+  using Sender = std::function<bool(const RobotCommand& cmd)>;
+  using TimedSender = std::function<bool(const RobotCommand& cmd, CommandTimeline& timeline)>;
+
+  explicit CommandMultiplexer(TimedSender sender) : sender_(std::move(sender))
+  {
+    if (!sender_) {
+      throw wisson_SDK::ConstructorException("libperseus-CommandMultiplexer: sender is required.");
+    }
+  }
+
+  explicit CommandMultiplexer(Sender sender)
+    : CommandMultiplexer(sender ? TimedSender([s = std::move(sender)](const RobotCommand& cmd, CommandTimeline& timeline) {
+                                    if (!s(cmd)) return false;
+                                    const int64_t now = timer::SteadyNowNs();
+                                    timeline.Mark(CommandStage::kSerialized, now);
+                                    timeline.Mark(CommandStage::kEnqueued, now);
+                                    return true;
+                                  })
+                                : TimedSender{})
+  {}
+
+  CommandMultiplexer(const CommandMultiplexer&) = delete;
+  CommandMultiplexer& operator=(const CommandMultiplexer&) = delete;
+
+  /**
+   * @brief Queue @p cmd on @p resources; sent immediately if they are free.
+   * @throw InvalidOperationException on a null command or an empty resource mask.
+   * @throw CommandException if a command with the same cmd_id is waiting or in flight.
+   * @throw NetworkException if the multiplexer was aborted.
+   */
+  CommandHandle Submit(std::shared_ptr<RobotCommand> cmd, ResourceMask resources)
+  {
+    if (!cmd || resources == 0) {
+      throw wisson_SDK::InvalidOperationException("libperseus-CommandMultiplexer: null command or no resources.");
+    }
+    if (cmd->cmd_id == 0) cmd->cmd_id = Controller::GenerateCommandId();
+    cmd->status = ResponseStatus::kSending;
+
+    auto state = std::make_shared<detail::CommandHandleState>();
+    state->cmd = std::move(cmd);
+    CommandHandle handle(state);
+
+    std::vector<std::shared_ptr<detail::CommandHandleState>> failed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (aborted_) {
+        throw wisson_SDK::NetworkException("libperseus-CommandMultiplexer: multiplexer aborted.");
+      }
+      if (IsKnownLocked(state->cmd->cmd_id)) {
+        throw wisson_SDK::CommandException("libperseus-CommandMultiplexer: command " +
+                                           std::to_string(state->cmd->cmd_id) + " is already submitted.");
+      }
+      waiting_.push_back({std::move(state), resources});
+      PumpLocked(failed);
+    }
+    for (auto& s : failed) s->Complete(ResponseStatus::kFail);
+    return handle;
+  }
+
+  CommandHandle Submit(std::shared_ptr<RobotCommand> cmd, CommandResource resource)
+  {
+    return Submit(std::move(cmd), ToMask(resource));
+  }
+
+  /**
+   * @brief Report that the frame of @p cmd_id went out on the socket (io thread).
+   * @return false if @p cmd_id is not in flight.
+   */
+  bool OnWritten(uint32_t cmd_id, int64_t t_ns = timer::SteadyNowNs())
+  {
+    return table_.Mark(cmd_id, CommandStage::kWritten, t_ns);
+  }
+
+  /**
+   * @brief Feed a command response received from the server.
+   * @return false if @p cmd_id is not in flight.
+   */
+  bool OnResponse(uint32_t cmd_id, ResponseStatus status)
+  {
+    InFlightTable::Entry finished;
+    const auto result = table_.Route(cmd_id, status, finished);
+    if (result == InFlightTable::RouteResult::kUnknown) return false;
+    if (result == InFlightTable::RouteResult::kProgress) return true;
+
+    std::vector<std::shared_ptr<detail::CommandHandleState>> failed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_ &= ~finished.resources;
+      PumpLocked(failed);
+    }
+    finished.state->Complete(status);
+    stats_.Record(finished.state->timeline);
+    for (auto& s : failed) s->Complete(ResponseStatus::kFail);
+    return true;
+  }
+
+  /**
+   * @brief Fail every waiting and in-flight command, e.g. after the connection was lost.
+   */
+  void Abort(ResponseStatus status = ResponseStatus::kAbort)
+  {
+    std::deque<Pending> waiting;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      aborted_ = true;
+      busy_ = 0;
+      waiting.swap(waiting_);
+    }
+    for (auto& e : table_.Drain()) {
+      e.state->cmd->status = status;
+      e.state->Complete(status);
+    }
+    for (auto& w : waiting) {
+      w.state->cmd->status = status;
+      w.state->Complete(status);
+    }
+  }
+
+  /**
+   * @brief Finish every waiting and in-flight command on @p resources with @p status,
+   *        e.g. after a stop request for them went out (any thread).
+   *
+   * Unlike Abort() the multiplexer stays usable; commands on other resources keep
+   * running and may start on the freed resources.
+   * @return Number of commands preempted.
+   */
+  std::size_t Preempt(ResourceMask resources, ResponseStatus status = ResponseStatus::kUserStop)
+  {
+    std::vector<std::shared_ptr<detail::CommandHandleState>> preempted;
+    std::vector<std::shared_ptr<detail::CommandHandleState>> failed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto& e : table_.Drain(resources)) {
+        busy_ &= ~e.resources;
+        preempted.push_back(std::move(e.state));
+      }
+      for (auto it = waiting_.begin(); it != waiting_.end();) {
+        if ((it->resources & resources) == 0) {
+          ++it;
+          continue;
+        }
+        preempted.push_back(std::move(it->state));
+        it = waiting_.erase(it);
+      }
+      if (!aborted_) PumpLocked(failed);
+    }
+    for (auto& s : preempted) {
+      s->cmd->status = status;
+      s->cmd->finished = true;
+      s->Complete(status);
+    }
+    for (auto& s : failed) s->Complete(ResponseStatus::kFail);
+    return preempted.size();
+  }
+
+  [[nodiscard]] std::size_t InFlight() const noexcept { return table_.Size(); }
+
+  [[nodiscard]] std::size_t Waiting() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiting_.size();
+  }
+
+  /**
+   * @brief Largest number of commands that were in flight at the same time.
+   */
+  [[nodiscard]] std::size_t MaxConcurrent() const noexcept { return max_concurrent_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Lifecycle segments of every command finished by a server response.
+   */
+  [[nodiscard]] const LifecycleStats& Stats() const noexcept { return stats_; }
+  void ResetStats() noexcept { stats_.Reset(); }
+
+private:
+  struct Pending
+  {
+    std::shared_ptr<detail::CommandHandleState> state;
+    ResourceMask resources{0};
+  };
+
+  /**
+   * @brief Start every waiting command whose resources are free, in submission order.
+   */
+  void PumpLocked(std::vector<std::shared_ptr<detail::CommandHandleState>>& failed)
+  {
+    ResourceMask claimed = busy_;   // busy or reserved by an earlier waiting command
+    for (auto it = waiting_.begin(); it != waiting_.end() && claimed != kAllResources;) {
+      // Cancelled through its handle before being sent.
+      if (it->state->state.load() != CommandState::kQueued) {
+        it = waiting_.erase(it);
+        continue;
+      }
+      if ((it->resources & claimed) != 0) {
+        claimed |= it->resources;
+        ++it;
+        continue;
+      }
+
+      CommandState expected = CommandState::kQueued;
+      if (!it->state->state.compare_exchange_strong(expected, CommandState::kRunning)) {
+        it = waiting_.erase(it);
+        continue;
+      }
+      // In the table before the first response can arrive. From then on Route() owns
+      // the status, so it is set first; a fast final response must not be overwritten.
+      // A collision (cmd_id changed after Submit) fails this command and leaves the
+      // other entry alone.
+      it->state->cmd->status = ResponseStatus::kWaiting;
+      if (!table_.Insert({it->state, it->resources})) {
+        it->state->cmd->status = ResponseStatus::kFail;
+        failed.push_back(it->state);
+        it = waiting_.erase(it);
+        continue;
+      }
+      if (!sender_(*it->state->cmd, it->state->timeline)) {
+        // Nothing went out, so no response can have claimed it; reclaim it before writing.
+        if (table_.Erase(it->state->cmd->cmd_id)) {
+          it->state->cmd->status = ResponseStatus::kFail;
+          failed.push_back(it->state);
+        }
+        it = waiting_.erase(it);
+        continue;
+      }
+      busy_ |= it->resources;
+      claimed |= it->resources;
+      const std::size_t in_flight = table_.Size();
+      if (in_flight > max_concurrent_.load(std::memory_order_relaxed)) {
+        max_concurrent_.store(in_flight, std::memory_order_relaxed);
+      }
+      it = waiting_.erase(it);
+    }
+  }
+
+  bool IsKnownLocked(uint32_t cmd_id)
+  {
+    if (table_.Contains(cmd_id)) return true;
+    for (const auto& w : waiting_) {
+      if (w.state->cmd->cmd_id == cmd_id) return true;
+    }
+    return false;
+  }
+
+private:
+  TimedSender sender_;
+  InFlightTable table_;
+  LifecycleStats stats_;
+
+  mutable std::mutex mutex_;      ///< Guards scheduling only; responses route through table_.
+  std::deque<Pending> waiting_;
+  ResourceMask busy_{0};
+  bool aborted_{false};
+  std::atomic<std::size_t> max_concurrent_{0};
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,279 @@
+/**
+ * @file command_timeline.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Per-command lifecycle timestamps and their aggregation.
+ *
+ * This header contains:
+ *  - CommandStage    : milestones of one command, from submission to final status
+ *  - CommandTimeline : steady-clock timestamp of every milestone and waypoint
+ *  - LifecycleStats  : one LatencyHistogram per segment between milestones
+ *
+ * The segments tell where a slow cycle went: submitted -> written is spent in the
+ * SDK (encoding, queueing, io thread), written -> acked in the network and the
+ * server's command intake, acked -> finished on the robot.
+ *
+ * @example:
+ *   auto handle = mux.Submit(cmd, CommandResource::kLeftArm);
+ *   handle.Wait();
+ *   SPDLOG_INFO("{}", handle.Timeline().ToString());
+ *   SPDLOG_INFO("{}", mux.Stats().ToString());
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "perseuslib/common/clock_sync.hpp"
+#include "perseuslib/common/latency_histogram.hpp"
+#include "robot_command.hpp"
+
+
+namespace wisson_SDK::control {
+
+// -----------------------------------------------------------------------------------
+//                              Enum Definitions
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Milestones of one command, in the order they are reached.
+ */
+enum class CommandStage : uint8_t
+{
+  kSubmitted,    ///< Handle created (Submit / ControlAsync).
+  kSerialized,   ///< Frame encoded.
+  kEnqueued,     ///< Frame handed to the send queue.
+  kWritten,      ///< Frame written to the socket by the io thread.
+  kAcked,        ///< First response from the server (kWaiting).
+  kFinished,     ///< Final status received or assigned.
+};
+
+inline constexpr std::size_t kCommandStageCount = 6;
+
+/**
+ * @brief Intervals aggregated by LifecycleStats.
+ */
+enum class LifecycleSegment : uint8_t
+{
+  kSerialize,    ///< kSubmitted  -> kSerialized
+  kEnqueue,      ///< kSerialized -> kEnqueued
+  kIoWait,       ///< kEnqueued   -> kWritten
+  kAck,          ///< kWritten    -> kAcked
+  kExecute,      ///< kAcked      -> kFinished
+  kTotal,        ///< kSubmitted  -> kFinished
+  kWaypoint,     ///< Between consecutive kSubSuccess (first one counted from kAcked)
+};
+
+inline constexpr std::size_t kLifecycleSegmentCount = 7;
+
+
+namespace detail {
+
+[[nodiscard]] inline constexpr std::string_view CommandStageToString(CommandStage stage) noexcept
+{
+  switch (stage)
+  {
+    case CommandStage::kSubmitted:  return "Submitted";
+    case CommandStage::kSerialized: return "Serialized";
+    case CommandStage::kEnqueued:   return "Enqueued";
+    case CommandStage::kWritten:    return "Written";
+    case CommandStage::kAcked:      return "Acked";
+    case CommandStage::kFinished:   return "Finished";
+    default:                        return "Unknown";
+  }
+}
+
+[[nodiscard]] inline constexpr std::string_view LifecycleSegmentToString(LifecycleSegment segment) noexcept
+{
+  switch (segment)
+  {
+    case LifecycleSegment::kSerialize: return "Serialize";
+    case LifecycleSegment::kEnqueue:   return "Enqueue";
+    case LifecycleSegment::kIoWait:    return "IoWait";
+    case LifecycleSegment::kAck:       return "Ack";
+    case LifecycleSegment::kExecute:   return "Execute";
+    case LifecycleSegment::kTotal:     return "Total";
+    case LifecycleSegment::kWaypoint:  return "Waypoint";
+    default:                           return "Unknown";
+  }
+}
+
+} // namespace detail
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Command Timeline
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Steady-clock timestamps [ns] of one command; 0 marks a stage not reached.
+ *
+ * Stamped from the submitting thread and the io thread; every stage keeps its first
+ * timestamp. Lock-free and allocation-free.
+ */
+class CommandTimeline
+{
+public:
+  CommandTimeline() = default;
+  CommandTimeline(const CommandTimeline&) = delete;
+  CommandTimeline& operator=(const CommandTimeline&) = delete;
+
+  /**
+   * @brief Record @p stage at @p t_ns unless it was recorded before.
+   */
+  void Mark(CommandStage stage, int64_t t_ns = timer::SteadyNowNs()) noexcept
+  {
+    int64_t expected = 0;
+    stages_[static_cast<std::size_t>(stage)].compare_exchange_strong(expected, t_ns, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Record a kSubSuccess response (one per completed waypoint).
+   */
+  void MarkWaypoint(int64_t t_ns = timer::SteadyNowNs()) noexcept
+  {
+    const uint32_t i = waypoints_.load(std::memory_order_relaxed);
+    if (i >= waypoint_ns_.size()) return;
+    waypoint_ns_[i].store(t_ns, std::memory_order_relaxed);
+    waypoints_.store(i + 1, std::memory_order_release);
+  }
+
+  [[nodiscard]] int64_t At(CommandStage stage) const noexcept
+  {
+    return stages_[static_cast<std::size_t>(stage)].load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::size_t WaypointCount() const noexcept { return waypoints_.load(std::memory_order_acquire); }
+  [[nodiscard]] int64_t WaypointAt(std::size_t i) const noexcept { return waypoint_ns_[i].load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Time from @p from to @p to [ns], or -1 if either was not reached.
+   */
+  [[nodiscard]] int64_t Between(CommandStage from, CommandStage to) const noexcept
+  {
+    const int64_t a = At(from), b = At(to);
+    return (a == 0 || b == 0) ? -1 : b - a;
+  }
+
+  /**
+   * @brief Duration of @p segment [ns], or -1 if it is incomplete. kWaypoint is not a
+   *        single interval; use WaypointAt().
+   */
+  [[nodiscard]] int64_t Duration(LifecycleSegment segment) const noexcept
+  {
+    switch (segment)
+    {
+      case LifecycleSegment::kSerialize: return Between(CommandStage::kSubmitted, CommandStage::kSerialized);
+      case LifecycleSegment::kEnqueue:   return Between(CommandStage::kSerialized, CommandStage::kEnqueued);
+      case LifecycleSegment::kIoWait:    return Between(CommandStage::kEnqueued, CommandStage::kWritten);
+      case LifecycleSegment::kAck:       return Between(CommandStage::kWritten, CommandStage::kAcked);
+      case LifecycleSegment::kExecute:   return Between(CommandStage::kAcked, CommandStage::kFinished);
+      case LifecycleSegment::kTotal:     return Between(CommandStage::kSubmitted, CommandStage::kFinished);
+      default:                           return -1;
+    }
+  }
+
+  /**
+   * @brief One line with every segment in microseconds, "-" where incomplete.
+   */
+  [[nodiscard]] std::string ToString() const
+  {
+    std::string s;
+    for (std::size_t i = 0; i < kLifecycleSegmentCount - 1; ++i) {
+      const auto segment = static_cast<LifecycleSegment>(i);
+      const int64_t ns = Duration(segment);
+      char buf[48];
+      if (ns < 0) {
+        std::snprintf(buf, sizeof(buf), "%s = [-]", detail::LifecycleSegmentToString(segment).data());
+      } else {
+        std::snprintf(buf, sizeof(buf), "%s = [%.1f us]", detail::LifecycleSegmentToString(segment).data(), ns * 1e-3);
+      }
+      if (!s.empty()) s += ", ";
+      s += buf;
+    }
+    return s + ", Waypoints = [" + std::to_string(WaypointCount()) + "]";
+  }
+
+private:
+  std::array<std::atomic<int64_t>, kCommandStageCount> stages_{};
+  std::array<std::atomic<int64_t>, cmd_list_size> waypoint_ns_{};
+  std::atomic<uint32_t> waypoints_{0};
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Lifecycle Stats
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Histograms of every lifecycle segment over many commands. Record() is
+ *        lock-free and may run on the io thread while others read.
+ */
+class LifecycleStats
+{
+public:
+  /**
+   * @brief Add the complete segments of a finished command.
+   */
+  void Record(const CommandTimeline& t) noexcept
+  {
+    for (std::size_t i = 0; i < kLifecycleSegmentCount; ++i) {
+      const int64_t ns = t.Duration(static_cast<LifecycleSegment>(i));
+      if (ns >= 0) histograms_[i].RecordNs(static_cast<uint64_t>(ns));
+    }
+    int64_t prev = t.At(CommandStage::kAcked);
+    for (std::size_t i = 0; i < t.WaypointCount(); ++i) {
+      const int64_t w = t.WaypointAt(i);
+      if (prev != 0 && w >= prev) Of(LifecycleSegment::kWaypoint).RecordNs(static_cast<uint64_t>(w - prev));
+      prev = w;
+    }
+  }
+
+  [[nodiscard]] const timer::LatencyHistogram& Of(LifecycleSegment segment) const noexcept
+  {
+    return histograms_[static_cast<std::size_t>(segment)];
+  }
+
+  void Reset() noexcept
+  {
+    for (auto& h : histograms_) h.Reset();
+  }
+
+  /**
+   * @brief One line per segment with LatencyHistogram::SummaryUs().
+   */
+  [[nodiscard]] std::string ToString() const
+  {
+    std::string s;
+    for (std::size_t i = 0; i < kLifecycleSegmentCount; ++i) {
+      const auto segment = static_cast<LifecycleSegment>(i);
+      if (!s.empty()) s += "\n";
+      s += std::string(detail::LifecycleSegmentToString(segment)) + ": " + Of(segment).SummaryUs();
+    }
+    return s;
+  }
+
+private:
+  timer::LatencyHistogram& Of(LifecycleSegment segment) noexcept
+  {
+    return histograms_[static_cast<std::size_t>(segment)];
+  }
+
+private:
+  std::array<timer::LatencyHistogram, kLifecycleSegmentCount> histograms_;
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,274 @@
+/**
+ * @file command_validator.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Client-side pre-flight validation of RobotCommand.
+ *
+ * This header contains:
+ *  - CommandLimits     : joint position / velocity limits (see command_limits_loader.hpp)
+ *  - ValidationResult  : first offending entry and joint, if any
+ *  - ValidateCommand() : checks every entry before anything is sent
+ *
+ * Catches what the server would refuse with RefusedReason::InvalidRequest without
+ * paying a round trip: joint positions outside their limits, steps between
+ * consecutive waypoints that exceed velocity_max * timeout, non-positive or
+ * non-finite timeouts and end-effector transforms that are not rigid. The per-joint
+ * checks are branch-free and run two joints per SIMD lane pair (math::simd); the
+ * slow path that names the offending joint only runs once a waypoint failed.
+ *
+ * @example:
+ *   const auto limits = LoadCommandLimits(CONFIG_PATH "/config.yaml");   // command_limits_loader.hpp
+ *   if (auto r = ValidateCommand(*cmd, ControllerMode::JointPosition(), limits, &state->q); !r) {
+ *     SPDLOG_ERROR("{}", r.ToString());
+ *   }
+ */
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "perseuslib/common/simd_utils.hpp"
+#include "controller.h"
+
+
+namespace wisson_SDK::control {
+
+// -----------------------------------------------------------------------------------
+//                                  Limits
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Limits commands are checked against, in the units of MotionCommand
+ *        (joint 0 [m], joints 1-8 [deg]).
+ */
+struct CommandLimits
+{
+  std::array<double, JOINT_NUM> position_min;       ///< Lower joint limits.
+  std::array<double, JOINT_NUM> position_max;       ///< Upper joint limits.
+  std::array<double, JOINT_NUM> velocity_max;       ///< Largest joint speed [unit/s].
+  std::array<double, JOINT_NUM> acceleration_max;   ///< Largest joint acceleration [unit/s^2]; planners only.
+  double rigid_tolerance{1e-6};                     ///< Allowed deviation of R^T R from I and det(R) from 1.
+
+  /**
+   * @brief No joint limits; timeouts, finiteness and rigid transforms are still checked.
+   */
+  [[nodiscard]] static CommandLimits Unlimited() noexcept
+  {
+    CommandLimits l;
+    l.position_min.fill(-std::numeric_limits<double>::infinity());
+    l.position_max.fill(std::numeric_limits<double>::infinity());
+    l.velocity_max.fill(std::numeric_limits<double>::infinity());
+    l.acceleration_max.fill(std::numeric_limits<double>::infinity());
+    return l;
+  }
+};
+
+
+// -----------------------------------------------------------------------------------
+//                                Validation
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Why a command failed validation.
+ */
+enum class ValidationError : uint8_t
+{
+  kNone,              ///< Command is valid.
+  kJointLimit,        ///< Joint position outside its limits, or not finite.
+  kVelocityLimit,     ///< Step to the next waypoint (or joint velocity) too fast.
+  kInvalidTimeout,    ///< Timeout not positive or not finite.
+  kInvalidTransform   ///< ee_transform is not a rigid homogeneous transform.
+};
+
+[[nodiscard]] inline constexpr std::string_view ValidationErrorToString(ValidationError error) noexcept
+{
+  switch (error)
+  {
+    case ValidationError::kNone:             return "None";
+    case ValidationError::kJointLimit:       return "JointLimit";
+    case ValidationError::kVelocityLimit:    return "VelocityLimit";
+    case ValidationError::kInvalidTimeout:   return "InvalidTimeout";
+    case ValidationError::kInvalidTransform: return "InvalidTransform";
+    default:                                 return "Unknown";
+  }
+}
+
+/**
+ * @brief Outcome of ValidateCommand(); converts to true if the command is valid.
+ */
+struct ValidationResult
+{
+  ValidationError error{ValidationError::kNone};
+  std::size_t index{0};   ///< Offending entry of RobotCommand::commands.
+  std::size_t joint{0};   ///< Offending joint (joint checks only).
+
+  explicit operator bool() const noexcept { return error == ValidationError::kNone; }
+
+  [[nodiscard]] std::string ToString() const
+  {
+    if (error == ValidationError::kNone) return "valid";
+    std::string s = std::string(ValidationErrorToString(error)) + " at entry " + std::to_string(index);
+    if (error == ValidationError::kJointLimit || error == ValidationError::kVelocityLimit) {
+      s += ", joint " + std::to_string(joint);
+    }
+    return s;
+  }
+};
+
+
+namespace detail {
+
+[[nodiscard]] inline bool IsValidTimeout(double timeout) noexcept
+{
+  return timeout > 0.0 && std::isfinite(timeout);
+}
+
+/**
+ * @brief Branch-free check of one joint position waypoint reached from @p prev within @p timeout.
+ */
+[[nodiscard]] inline bool JointStepOk(const std::array<double, JOINT_NUM>& q, const std::array<double, JOINT_NUM>& prev,
+                                      double timeout, const CommandLimits& l) noexcept
+{
+  using namespace math::simd;
+  const Double2 t = Splat2(timeout);
+  Mask2 ok = kAllLanes;
+  std::size_t j = 0;
+  for (; j + 2 <= JOINT_NUM; j += 2) {
+    const Double2 qj = Load2(&q[j]);
+    ok &= Finite2(qj) & (qj >= Load2(&l.position_min[j])) & (qj <= Load2(&l.position_max[j])) &
+          (Abs2(qj - Load2(&prev[j])) <= Load2(&l.velocity_max[j]) * t);
+  }
+  bool tail = true;
+  for (; j < JOINT_NUM; ++j) {
+    tail &= std::isfinite(q[j]) & (q[j] >= l.position_min[j]) & (q[j] <= l.position_max[j]) &
+            (std::abs(q[j] - prev[j]) <= l.velocity_max[j] * timeout);
+  }
+  return All(ok) & tail;
+}
+
+/**
+ * @brief Branch-free check of one joint velocity setpoint.
+ */
+[[nodiscard]] inline bool JointVelocityOk(const std::array<double, JOINT_NUM>& v, const CommandLimits& l) noexcept
+{
+  using namespace math::simd;
+  Mask2 ok = kAllLanes;
+  std::size_t j = 0;
+  for (; j + 2 <= JOINT_NUM; j += 2) {
+    const Double2 vj = Load2(&v[j]);
+    ok &= Finite2(vj) & (Abs2(vj) <= Load2(&l.velocity_max[j]));
+  }
+  bool tail = true;
+  for (; j < JOINT_NUM; ++j) tail &= std::isfinite(v[j]) & (std::abs(v[j]) <= l.velocity_max[j]);
+  return All(ok) & tail;
+}
+
+/**
+ * @brief An all-zero ee_transform means "not set" (joint space entry).
+ */
+[[nodiscard]] inline bool HasTransform(const std::array<double, 16>& t) noexcept
+{
+  using namespace math::simd;
+  Mask2 any = {0, 0};
+  for (std::size_t i = 0; i < t.size(); i += 2) any |= Load2(&t[i]) != Splat2(0.0);
+  return Any(any);
+}
+
+/**
+ * @brief Row-major 4x4: orthonormal rotation with det +1, finite translation, last row [0 0 0 1].
+ */
+[[nodiscard]] inline bool IsRigidTransform(const std::array<double, 16>& t, double tol) noexcept
+{
+  bool ok = (t[12] == 0.0) & (t[13] == 0.0) & (t[14] == 0.0) & (t[15] == 1.0);
+  ok &= (t[3] - t[3] == 0.0) & (t[7] - t[7] == 0.0) & (t[11] - t[11] == 0.0);
+  // R R^T = I
+  for (std::size_t r = 0; r < 3; ++r) {
+    for (std::size_t c = r; c < 3; ++c) {
+      const double dot = t[4 * r] * t[4 * c] + t[4 * r + 1] * t[4 * c + 1] + t[4 * r + 2] * t[4 * c + 2];
+      ok &= std::abs(dot - (r == c ? 1.0 : 0.0)) <= tol;
+    }
+  }
+  const double det = t[0] * (t[5] * t[10] - t[6] * t[9]) - t[1] * (t[4] * t[10] - t[6] * t[8]) +
+                     t[2] * (t[4] * t[9] - t[5] * t[8]);
+  ok &= std::abs(det - 1.0) <= tol;
+  return ok;
+}
+
+/**
+ * @brief Slow path: first failing joint of a waypoint that failed JointStepOk().
+ */
+[[nodiscard]] inline ValidationResult LocateJointError(std::size_t index, const std::array<double, JOINT_NUM>& q,
+                                                       const std::array<double, JOINT_NUM>& prev, double timeout,
+                                                       const CommandLimits& l) noexcept
+{
+  for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+    if (!std::isfinite(q[j]) || q[j] < l.position_min[j] || q[j] > l.position_max[j]) {
+      return {ValidationError::kJointLimit, index, j};
+    }
+    if (!(std::abs(q[j] - prev[j]) <= l.velocity_max[j] * timeout)) {
+      return {ValidationError::kVelocityLimit, index, j};
+    }
+  }
+  return {};
+}
+
+} // namespace detail
+
+/**
+ * @brief Check every entry of @p cmd for @p mode against @p limits.
+ *
+ * Position paths are checked waypoint by waypoint: limits, and the step from the
+ * previous waypoint (or from @p start, usually RobotState::q) against
+ * velocity_max * timeout. Velocity commands are checked against velocity_max.
+ * Entries carrying an ee_transform are checked for rigidity instead of joint limits.
+ * @return First error found; converts to true if the command is valid.
+ */
+[[nodiscard]] inline ValidationResult ValidateCommand(const RobotCommand& cmd, const ControllerMode& mode,
+                                                      const CommandLimits& limits,
+                                                      const std::array<double, JOINT_NUM>* start = nullptr) noexcept
+{
+  const bool velocity = mode.type == ControlType::kVelocity;
+  const std::array<double, JOINT_NUM>* prev = start;
+
+  for (std::size_t i = 0; i < cmd.commands.size(); ++i) {
+    const auto& entry = cmd.commands[i];
+    if (const auto* m = std::get_if<MotionCommand>(&entry)) {
+      if (!detail::IsValidTimeout(m->timeout)) return {ValidationError::kInvalidTimeout, i, 0};
+      if (velocity) {
+        if (!detail::JointVelocityOk(m->joint_velocities, limits)) {
+          for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+            if (!(std::abs(m->joint_velocities[j]) <= limits.velocity_max[j])) return {ValidationError::kVelocityLimit, i, j};
+          }
+        }
+      } else if (detail::HasTransform(m->ee_transform)) {
+        if (!detail::IsRigidTransform(m->ee_transform, limits.rigid_tolerance)) {
+          return {ValidationError::kInvalidTransform, i, 0};
+        }
+      } else {
+        const auto& from = prev != nullptr ? *prev : m->joint_positions;
+        if (!detail::JointStepOk(m->joint_positions, from, m->timeout, limits)) {
+          return detail::LocateJointError(i, m->joint_positions, from, m->timeout, limits);
+        }
+        prev = &m->joint_positions;
+      }
+    } else if (const auto* t = std::get_if<TorqueCommand>(&entry)) {
+      if (!detail::IsValidTimeout(t->timeout)) return {ValidationError::kInvalidTimeout, i, 0};
+    } else if (const auto* e = std::get_if<EndEffectorCommand>(&entry)) {
+      if (!detail::IsValidTimeout(e->timeout)) return {ValidationError::kInvalidTimeout, i, 0};
+    }
+  }
+  return {};
+}
+
+}  // namespace wisson_SDK::control
@@ -136,9 +136,16 @@ struct ControllerMode
 
   /**
    * @brief Common predefined modes
+   *
+   * PerseusRobot::Control() executes JointPosition() and TaskCommand() only.
+   * JointVelocity(), JointTorque() and JointImpedance() run on setpoint streams
+   * (SetpointStreamer) and compact command frames (network/command_frame.hpp).
    */
-  static constexpr ControllerMode JointPosition() { return {ControlSpace::kJoint, ControlType::kPosition}; }
-  static constexpr ControllerMode TaskCommand()   { return {ControlSpace::kTask,  ControlType::kCommand}; }
+  static constexpr ControllerMode JointPosition()  { return {ControlSpace::kJoint, ControlType::kPosition}; }
+  static constexpr ControllerMode JointVelocity()  { return {ControlSpace::kJoint, ControlType::kVelocity}; }
+  static constexpr ControllerMode JointTorque()    { return {ControlSpace::kJoint, ControlType::kTorque}; }
+  static constexpr ControllerMode JointImpedance() { return {ControlSpace::kJoint, ControlType::kImpedance}; }
+  static constexpr ControllerMode TaskCommand()    { return {ControlSpace::kTask,  ControlType::kCommand}; }
 
   constexpr bool operator==(const ControllerMode&) const = default;
   constexpr bool is(ControlSpace s, ControlType t) const { return space == s && type == t; }
@@ -153,6 +160,67 @@ struct ControllerMode
 };
 
 
+namespace detail {
+
+/**
+ * @brief Check whether a command entry can be executed in @p mode.
+ *
+ * Joint position and velocity modes take MotionCommand (joint_positions or
+ * joint_velocities respectively), torque mode takes TorqueCommand, task command
+ * mode takes EndEffectorCommand. Other modes accept any entry.
+ */
+[[nodiscard]] inline constexpr bool IsCommandSupported(const ControllerMode& mode, const SDKCmdVariant& cmd) noexcept
+{
+  switch (mode.type)
+  {
+    case ControlType::kPosition:
+    case ControlType::kVelocity:
+    case ControlType::kImpedance: return std::holds_alternative<MotionCommand>(cmd);
+    case ControlType::kTorque:    return std::holds_alternative<TorqueCommand>(cmd);
+    case ControlType::kCommand:   return std::holds_alternative<EndEffectorCommand>(cmd) ||
+                                         std::holds_alternative<MotionCommand>(cmd);
+    default:                      return true;
+  }
+}
+
+/**
+ * @brief Check every entry of @p cmd against @p mode.
+ */
+[[nodiscard]] inline bool IsCommandSupported(const ControllerMode& mode, const RobotCommand& cmd) noexcept
+{
+  for (const auto& c : cmd.commands) {
+    if (!IsCommandSupported(mode, c)) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Check whether PerseusRobot::Control() can execute @p mode.
+ *
+ * The prebuilt Controller::SendCommand sends joint position and task command
+ * requests only. Any other mode is logged as undefined, and ExecuteMotion() then
+ * waits for a response that never comes.
+ */
+[[nodiscard]] inline constexpr bool IsControlModeSupported(const ControllerMode& mode) noexcept
+{
+  return mode == ControllerMode::JointPosition() || mode == ControllerMode::TaskCommand();
+}
+
+/**
+ * @brief Reject a mode Control() cannot execute, before anything is sent.
+ * @throw CommandException if IsControlModeSupported(@p mode) is false.
+ */
+inline void RequireControlMode(const ControllerMode& mode)
+{
+  if (!IsControlModeSupported(mode)) {
+    throw CommandException("libperseus-Controller: mode " + mode.ModeToString() +
+                           " is not executed by Control(); use a setpoint stream or command frames.");
+  }
+}
+
+} // namespace detail
+
+
 
 // -----------------------------------------------------------------------------------
 //                           Controller Class                            
@@ -0,0 +1,340 @@
+/**
+ * @file online_trajectory.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Online jerk-limited trajectory generation toward moving targets.
+ *
+ * This header contains:
+ *  - JerkLimits                : per-joint velocity, acceleration and jerk limits
+ *                                (joint 0 prismatic [m], joints 1-8 rotary [deg])
+ *  - TrajectoryPoint           : position, velocity and acceleration of one cycle
+ *  - OnlineTrajectoryGenerator : one setpoint per control cycle toward the latest
+ *                                target, e.g. for a SetpointStreamer callback
+ *
+ * Every cycle each joint picks the jerk that moves it toward the target as fast as
+ * the limits allow while it can still come to rest on the target: the jerk is the
+ * largest one (toward the target) whose predicted stopping position does not pass
+ * the target, where the stop is the shortest jerk-limited braking manoeuvre. This
+ * follows the bang-bang profile of a time-optimal rest-to-rest move to within one
+ * cycle and reacts to a new target in the next cycle. A target velocity (e.g. from
+ * a tracker) makes the joints converge onto the moving target instead of chasing
+ * it. Joints are not time-synchronized. No allocation after construction.
+ *
+ * @example:
+ *   OnlineTrajectoryGenerator otg(JerkLimits::FromVelocityLimits(velocity_max), 0.001);
+ *   otg.Reset(*robot->ReadOnce());
+ *   SetpointStreamer loop(ControllerMode::JointPosition(),
+ *       [&](const RobotState&, network::Setpoint& sp) {
+ *         otg.SetTarget(tracker.Position(), tracker.Velocity());
+ *         sp.values = otg.Step().position;
+ *         return true;
+ *       }, send_frame);
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+
+#include "perseuslib/common/robot_state.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+
+
+namespace wisson_SDK::control {
+
+using JointVector = std::array<double, JOINT_NUM>;
+
+/**
+ * @brief Kinematic limits of the online trajectory generator, in joint units.
+ */
+struct JerkLimits
+{
+  JointVector max_velocity{};       ///< > 0 [unit/s].
+  JointVector max_acceleration{};   ///< > 0 [unit/s^2].
+  JointVector max_jerk{};           ///< > 0 [unit/s^3].
+  JointVector position_min{};       ///< Targets are clamped to [position_min, position_max].
+  JointVector position_max{};
+
+  /**
+   * @brief Limits reaching @p max_velocity in @p ramp_s with a jerk phase of half of it.
+   */
+  [[nodiscard]] static JerkLimits FromVelocityLimits(const JointVector& max_velocity, double ramp_s = 0.25) noexcept
+  {
+    JerkLimits l;
+    l.max_velocity = max_velocity;
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      l.max_acceleration[j] = 2.0 * max_velocity[j] / ramp_s;
+      l.max_jerk[j] = 2.0 * l.max_acceleration[j] / ramp_s;
+    }
+    l.position_min.fill(-std::numeric_limits<double>::infinity());
+    l.position_max.fill(std::numeric_limits<double>::infinity());
+    return l;
+  }
+};
+
+
+/**
+ * @brief State of every joint at one cycle.
+ */
+struct TrajectoryPoint
+{
+  JointVector position{};
+  JointVector velocity{};
+  JointVector acceleration{};
+};
+
+
+namespace detail {
+
+/**
+ * @brief Final offset of a joint at relative state (e, w, a) after the shortest
+ *        braking manoeuvre that brings w and a to zero, for w + a|a|/2J >= 0.
+ *
+ * Jerk -J down to the peak deceleration, hold it (only if |peak| reaches A), jerk
+ * +J back to zero.
+ */
+[[nodiscard]] inline double StopOffsetDown(double e, double w, double a, double A, double J) noexcept
+{
+  double peak = -std::sqrt(std::max(0.5 * a * a + J * w, 0.0));
+  double t_hold = 0.0;
+  if (peak < -A) {
+    peak = -A;
+    t_hold = (w - (2.0 * A * A - a * a) / (2.0 * J)) / A;
+  }
+  auto phase = [&](double t, double jerk) {
+    e += t * (w + t * (0.5 * a + t * jerk / 6.0));
+    w += t * (a + 0.5 * jerk * t);
+    a += jerk * t;
+  };
+  phase(std::max((a - peak) / J, 0.0), -J);
+  phase(std::max(t_hold, 0.0), 0.0);
+  phase(-peak / J, J);
+  return e;
+}
+
+/**
+ * @brief Final offset after the shortest braking manoeuvre from (e, w, a).
+ */
+[[nodiscard]] inline double StopOffset(double e, double w, double a, double A, double J) noexcept
+{
+  if (w + a * std::abs(a) / (2.0 * J) >= 0.0) return StopOffsetDown(e, w, a, A, J);
+  return -StopOffsetDown(-e, -w, -a, A, J);
+}
+
+} // namespace detail
+
+
+
+// -----------------------------------------------------------------------------------
+//                        Online Trajectory Generator
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Jerk-limited setpoint generator for a fixed cycle time.
+ *
+ * Not thread-safe: SetTarget() and Step() are meant for the control loop thread.
+ */
+class OnlineTrajectoryGenerator
+{
+public:
+  /**
+   * @param cycle_s Time between two Step() calls [s].
+   * @throw ConstructorException if a limit or @p cycle_s is not positive and finite.
+   */
+  OnlineTrajectoryGenerator(const JerkLimits& limits, double cycle_s) : limits_(limits), dt_(cycle_s)
+  {
+    auto positive = [](double x) { return x > 0.0 && std::isfinite(x); };
+    bool ok = positive(cycle_s);
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      ok = ok && positive(limits.max_velocity[j]) && positive(limits.max_acceleration[j]) &&
+           positive(limits.max_jerk[j]) && limits.position_min[j] <= limits.position_max[j];
+    }
+    if (!ok) {
+      throw wisson_SDK::ConstructorException("libperseus-OnlineTrajectoryGenerator: limits and cycle time must be positive.");
+    }
+  }
+
+  /**
+   * @brief Start at rest at the measured joint positions; the target becomes the same.
+   */
+  void Reset(const RobotState& state) noexcept { Reset(state.q); }
+
+  void Reset(const JointVector& position, const JointVector& velocity = {},
+             const JointVector& acceleration = {}) noexcept
+  {
+    point_.position = position;
+    point_.velocity = velocity;
+    point_.acceleration = acceleration;
+    target_ = position;
+    target_velocity_ = {};
+  }
+
+  /**
+   * @brief New target; @p velocity is its current velocity (0 for a fixed target).
+   *        Between calls the target is extrapolated with @p velocity, up to the
+   *        position limits, where it stops.
+   */
+  void SetTarget(const JointVector& position, const JointVector& velocity = {}) noexcept
+  {
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      target_[j] = std::clamp(position[j], limits_.position_min[j], limits_.position_max[j]);
+      target_velocity_[j] = target_[j] == position[j] ? velocity[j] : 0.0;
+    }
+  }
+
+  /**
+   * @brief Advance one cycle.
+   * @return Setpoint of the new cycle, valid until the next Step() / Reset().
+   */
+  const TrajectoryPoint& Step() noexcept
+  {
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) StepJoint(j);
+    return point_;
+  }
+
+  /**
+   * @brief True once every joint sits on the target with the target's velocity.
+   */
+  [[nodiscard]] bool Reached() const noexcept
+  {
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      if (point_.position[j] != target_[j] || point_.velocity[j] != target_velocity_[j] ||
+          point_.acceleration[j] != 0.0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] const TrajectoryPoint& Current() const noexcept { return point_; }
+  [[nodiscard]] const JointVector& Target() const noexcept { return target_; }
+  [[nodiscard]] const JerkLimits& Limits() const noexcept { return limits_; }
+  [[nodiscard]] double CycleTime() const noexcept { return dt_; }
+
+private:
+  /// Root-finding limits per joint and cycle: iterations and jerk resolution relative to J.
+  static constexpr int kMaxIterations = 40;
+  static constexpr double kJerkResolution = 1e-9;
+
+  void StepJoint(std::size_t j) noexcept
+  {
+    double en = 0.0, wn = 0.0, an = 0.0;
+    Plan(j, en, wn, an);
+
+    // A moving target stops at the position limit. Switch to that fixed target as
+    // soon as the joint could no longer brake for it one cycle later, not only once
+    // the extrapolation crosses it.
+    if (const double vt = target_velocity_[j]; vt != 0.0) {
+      const double limit = vt > 0.0 ? limits_.position_max[j] : limits_.position_min[j];
+      const double moved = target_[j] + vt * dt_;
+      if (std::isfinite(limit)) {
+        const double beyond = detail::StopOffset(moved + en - limit, vt + wn, an, limits_.max_acceleration[j],
+                                                 limits_.max_jerk[j]);
+        if ((vt > 0.0 ? std::max(moved - limit, beyond) : std::max(limit - moved, -beyond)) > 0.0) {
+          target_[j] = limit;
+          target_velocity_[j] = 0.0;
+          Plan(j, en, wn, an);
+        }
+      }
+    }
+
+    const double vt = target_velocity_[j];
+    target_[j] += vt * dt_;
+    point_.position[j] = target_[j] + en;
+    point_.velocity[j] = vt + wn;
+    point_.acceleration[j] = an;
+  }
+
+  /**
+   * @brief Jerk of the next cycle toward the current target, applied to the state
+   *        relative to the target: offset @p en, velocity @p wn, acceleration @p an.
+   */
+  void Plan(std::size_t j, double& en, double& wn, double& an) const noexcept
+  {
+    const double V = limits_.max_velocity[j], A = limits_.max_acceleration[j], J = limits_.max_jerk[j];
+    const double dt = dt_;
+    const double vt = target_velocity_[j];
+    // Relative to the target, which moves at constant velocity within the cycle.
+    const double e = point_.position[j] - target_[j];
+    const double w = point_.velocity[j] - vt;
+    const double a = point_.acceleration[j];
+
+    auto next_e = [&](double u) { return e + dt * (w + dt * (0.5 * a + dt * u / 6.0)); };
+    auto next_w = [&](double u) { return w + dt * (a + 0.5 * u * dt); };
+    auto next_a = [&](double u) { return a + u * dt; };
+    // Velocity once the acceleration is ramped to zero; must stay within +-V.
+    auto coast_v = [&](double u) { const double an = next_a(u); return vt + next_w(u) + an * std::abs(an) / (2.0 * J); };
+    auto stop = [&](double u) { return detail::StopOffset(next_e(u), next_w(u), next_a(u), A, J); };
+
+    double lo = std::max(-J, std::min(J, (-A - a) / dt));
+    double hi = std::min(J, std::max(-J, (A - a) / dt));
+    const double tol = kJerkResolution * J;
+    if (const double f_hi = coast_v(hi) - V; f_hi > 0.0) {
+      const double f_lo = coast_v(lo) - V;
+      hi = f_lo > 0.0 ? lo : FindRoot(lo, hi, f_lo, f_hi, tol, [&](double u) { return coast_v(u) - V; });
+    }
+    if (const double f_lo = coast_v(lo) + V; f_lo < 0.0) {
+      const double f_hi = coast_v(hi) + V;
+      lo = f_hi < 0.0 ? hi : FindRoot(lo, hi, f_lo, f_hi, tol, [&](double u) { return coast_v(u) + V; });
+    }
+
+    double u = hi;
+    if (const double s_hi = stop(hi); s_hi > 0.0) {
+      const double s_lo = stop(lo);
+      u = s_lo >= 0.0 ? lo : FindRoot(lo, hi, s_lo, s_hi, tol, stop);
+    }
+
+    en = next_e(u);
+    wn = next_w(u);
+    an = next_a(u);
+    // Land exactly on the target once the remaining motion is below one cycle of jerk.
+    if (std::abs(en) <= J * dt * dt * dt && std::abs(wn) <= J * dt * dt && std::abs(a) <= J * dt) {
+      en = wn = an = 0.0;
+    }
+  }
+
+  /**
+   * @brief Root of an increasing @p f on [lo, hi] with f(lo) = f_lo <= 0 < f(hi) = f_hi,
+   *        by the Illinois variant of regula falsi.
+   * @return The end of the final bracket where f <= 0.
+   */
+  template <typename F>
+  static double FindRoot(double lo, double hi, double f_lo, double f_hi, double tol, F&& f) noexcept
+  {
+    int side = 0;
+    for (int i = 0; i < kMaxIterations && hi - lo > tol; ++i) {
+      double x = (lo * f_hi - hi * f_lo) / (f_hi - f_lo);
+      if (!(x > lo && x < hi)) x = 0.5 * (lo + hi);
+      const double fx = f(x);
+      if (fx <= 0.0) {
+        lo = x;
+        f_lo = fx;
+        if (side == -1) f_hi *= 0.5;
+        side = -1;
+      } else {
+        hi = x;
+        f_hi = fx;
+        if (side == 1) f_lo *= 0.5;
+        side = 1;
+      }
+      if (fx == 0.0) break;
+    }
+    return lo;
+  }
+
+  JerkLimits limits_;
+  double dt_;
+  TrajectoryPoint point_{};
+  JointVector target_{};
+  JointVector target_velocity_{};
+};
+
+}  // namespace wisson_SDK::control
@@ -17,12 +17,14 @@
 #include <atomic>
 #include <vector>
 #include <memory>
+#include <ranges>
 #include <string>
 #include <string_view>
 #include <variant>
 #include <stdexcept>
 
 #include "perseuslib/common/robot_state.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
 
 
 namespace wisson_SDK::control {
@@ -55,8 +57,8 @@ private:
     MotionCommand() = default;
 
 public:
-    std::array<double, JOINT_NUM> joint_positions{};   ///< Target joint positions [rad].
-    std::array<double, JOINT_NUM> joint_velocities{};  ///< Target joint velocities [rad/s].
+    std::array<double, JOINT_NUM> joint_positions{};   ///< Target joint positions [deg] (joint 0: [m]).
+    std::array<double, JOINT_NUM> joint_velocities{};  ///< Target joint velocities [deg/s] (joint 0: [m/s]).
     std::array<double, 16> ee_transform{};             ///< End-effector homogeneous transform (4x4 matrix, row-major).
     std::array<double, 6> ee_velocity{};               ///< End-effector velocity (linear + angular).
     std::array<double, 2> elbow{};                     ///< Optional elbow configuration.
@@ -77,6 +79,21 @@ public:
         cmd.timeout = timeout_s;
         return cmd;
     }
+
+    /**
+     * @brief Factory method to create a joint velocity command (ControlType::kVelocity).
+     * @param joint_velocities Desired joint velocities.
+     * @param timeout_s Duration the velocities are held, in seconds.
+     * @return Constructed MotionCommand.
+     */
+    static MotionCommand CreateVelocityCommand(const std::array<double, JOINT_NUM>& joint_velocities,
+                                               double timeout_s = 1.0)
+    {
+        MotionCommand cmd;
+        cmd.joint_velocities = joint_velocities;
+        cmd.timeout = timeout_s;
+        return cmd;
+    }
 };
 
 
@@ -87,6 +104,17 @@ struct TorqueCommand
 {
     std::array<double, JOINT_NUM> desired_torque{}; ///< Desired joint torques [Nm].
     double timeout{10.0};                           ///< Command timeout in seconds.
+
+    /**
+     * @brief Factory method to create a torque command (ControlType::kTorque).
+     * @param desired_torque Desired joint torques.
+     * @param timeout_s Duration the torques are held, in seconds.
+     * @return Constructed TorqueCommand.
+     */
+    static TorqueCommand CreateCommand(const std::array<double, JOINT_NUM>& desired_torque, double timeout_s = 1.0)
+    {
+        return TorqueCommand{desired_torque, timeout_s};
+    }
 };
 
 
@@ -284,11 +312,14 @@ namespace detail {
 // -----------------------------------------------------------------------------------
 using SDKCmdVariant = std::variant<MotionCommand, TorqueCommand, EndEffectorCommand>;
 
+class RobotCommandPool;
+
 struct alignas(16) RobotCommand 
 {
 private:
     // Private constructor to prevent direct instantiation from outside
     RobotCommand() = default;
+    friend class RobotCommandPool;
 
 public:
     uint32_t cmd_id{0};
@@ -361,6 +392,30 @@ public:
         return joints;
     }
 
+    std::vector<std::array<double, JOINT_NUM>> getJointVelocitiesVec() const {
+        std::vector<std::array<double, JOINT_NUM>> velocities;
+        velocities.reserve(commands.size());
+
+        for (const auto& cmd : commands) {
+            if (const auto* m = std::get_if<MotionCommand>(&cmd)) {
+                velocities.push_back(m->joint_velocities);
+            }
+        }
+        return velocities;
+    }
+
+    std::vector<std::array<double, JOINT_NUM>> getTorquesVec() const {
+        std::vector<std::array<double, JOINT_NUM>> torques;
+        torques.reserve(commands.size());
+
+        for (const auto& cmd : commands) {
+            if (const auto* t = std::get_if<TorqueCommand>(&cmd)) {
+                torques.push_back(t->desired_torque);
+            }
+        }
+        return torques;
+    }
+
     std::vector<double> getTimeoutVec() const {
         std::vector<double> timeouts;
         timeouts.reserve(commands.size());
@@ -382,6 +437,41 @@ public:
         }
         return actions;
     }
+
+    /* Range Helpers: lazy views over commands, no allocation (iterate, do not store) */
+    auto JointPositions() const {
+        return commands | std::views::filter([](const SDKCmdVariant& c) { return std::holds_alternative<MotionCommand>(c); })
+                        | std::views::transform([](const SDKCmdVariant& c) -> const std::array<double, JOINT_NUM>& {
+                              return std::get_if<MotionCommand>(&c)->joint_positions;
+                          });
+    }
+
+    auto JointVelocities() const {
+        return commands | std::views::filter([](const SDKCmdVariant& c) { return std::holds_alternative<MotionCommand>(c); })
+                        | std::views::transform([](const SDKCmdVariant& c) -> const std::array<double, JOINT_NUM>& {
+                              return std::get_if<MotionCommand>(&c)->joint_velocities;
+                          });
+    }
+
+    auto Torques() const {
+        return commands | std::views::filter([](const SDKCmdVariant& c) { return std::holds_alternative<TorqueCommand>(c); })
+                        | std::views::transform([](const SDKCmdVariant& c) -> const std::array<double, JOINT_NUM>& {
+                              return std::get_if<TorqueCommand>(&c)->desired_torque;
+                          });
+    }
+
+    auto Timeouts() const {
+        return commands | std::views::transform([](const SDKCmdVariant& c) {
+                              return std::visit([](const auto& e) { return e.timeout; }, c);
+                          });
+    }
+
+    auto EEActions() const {
+        return commands | std::views::filter([](const SDKCmdVariant& c) { return std::holds_alternative<EndEffectorCommand>(c); })
+                        | std::views::transform([](const SDKCmdVariant& c) {
+                              return detail::EndEffectorActionToString(std::get_if<EndEffectorCommand>(&c)->ee_action);
+                          });
+    }
 };
 
 }  // namespace wisson_SDK::control
\ No newline at end of file
@@ -0,0 +1,583 @@
+/**
+ * @file robot_task.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief C++20 coroutine support for composing multi-step robot tasks.
+ *
+ * This header contains:
+ *  - Task<T>         : lazily started coroutine returning T
+ *  - TaskExecutor    : single thread that resumes every task flow; blocking work
+ *                      (PerseusRobot::Control) stays on the per-robot dispatchers
+ *  - operator co_await(CommandHandle) : await a command submitted by ControlAsync()
+ *  - StateAwaitable  : await a predicate on the robot state (PerseusRobot::WaitState)
+ *
+ * @example:
+ *   control::Task<void> PickFlow(std::shared_ptr<PerseusRobot> robot) {
+ *     co_await robot->ControlAsync(mode, approach);
+ *     co_await robot->EndEffectorAsync(control::EndEffectorAction::Open);
+ *     co_await robot->WaitState([](const RobotState& s) { return s.pSource > 5000; });
+ *     co_await robot->ControlAsync(mode, retreat);
+ *   }
+ *   auto done = control::TaskExecutor::Default().Spawn(PickFlow(robot));
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "perseuslib/common/robot_state.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+#include "command_handle.hpp"
+
+
+namespace wisson_SDK::control {
+
+// -----------------------------------------------------------------------------------
+//                                    Task
+// -----------------------------------------------------------------------------------
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief Resumes the awaiting coroutine when a Task finishes (symmetric transfer).
+ */
+struct TaskFinalAwaiter
+{
+  bool await_ready() const noexcept { return false; }
+
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+  {
+    auto continuation = h.promise().continuation;
+    return continuation ? continuation : std::noop_coroutine();
+  }
+
+  void await_resume() const noexcept {}
+};
+
+struct TaskPromiseBase
+{
+  std::coroutine_handle<> continuation;
+  std::exception_ptr error;
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  TaskFinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase
+{
+  std::optional<T> value;
+
+  Task<T> get_return_object() noexcept;
+  void return_value(T v) { value.emplace(std::move(v)); }
+
+  T Result()
+  {
+    if (error) std::rethrow_exception(error);
+    return std::move(*value);
+  }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase
+{
+  Task<void> get_return_object() noexcept;
+  void return_void() const noexcept {}
+
+  void Result() const
+  {
+    if (error) std::rethrow_exception(error);
+  }
+};
+
+} // namespace detail
+
+
+/**
+ * @brief Lazily started coroutine. Runs when awaited or spawned on a TaskExecutor.
+ */
+template <typename T>
+class Task
+{
+public:
+  using promise_type = detail::TaskPromise<T>;
+
+  Task() = default;
+  explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task& operator=(Task&& other) noexcept
+  {
+    if (this != &other) {
+      if (handle_) handle_.destroy();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  ~Task() { if (handle_) handle_.destroy(); }
+
+  [[nodiscard]] bool Valid() const noexcept { return static_cast<bool>(handle_); }
+
+  bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+  {
+    handle_.promise().continuation = awaiting;
+    return handle_;
+  }
+
+  T await_resume()
+  {
+    if (!handle_) {
+      throw wisson_SDK::InvalidOperationException("libperseus-Task: awaiting an empty task.");
+    }
+    return handle_.promise().Result();
+  }
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+  return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief Resumption queue of a TaskExecutor, shared with completion callbacks.
+ *
+ * Outlives the executor, so a command completing after the executor was destroyed
+ * posts into a closed queue instead of a dangling executor.
+ */
+struct ReadyQueue
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::coroutine_handle<>> ready;
+  std::unordered_set<void*> spawned;   ///< Root frames of unfinished spawned flows.
+  bool closed{false};
+
+  /**
+   * @brief Queue @p h for resumption.
+   * @return false if the executor has stopped; @p h is then left alone.
+   */
+  bool Post(std::coroutine_handle<> h)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (closed) return false;
+      ready.push_back(h);
+    }
+    cv.notify_one();
+    return true;
+  }
+};
+
+/**
+ * @brief Fire-and-forget coroutine used by TaskExecutor::Spawn(); frees itself and
+ *        leaves ReadyQueue::spawned when it finishes.
+ */
+struct DetachedTask
+{
+  struct promise_type
+  {
+    std::shared_ptr<ReadyQueue> queue;
+
+    struct FinalAwaiter
+    {
+      bool await_ready() const noexcept { return false; }
+      bool await_suspend(std::coroutine_handle<promise_type> h) const noexcept
+      {
+        if (auto& queue = h.promise().queue) {
+          std::lock_guard<std::mutex> lock(queue->mutex);
+          queue->spawned.erase(h.address());
+        }
+        return false;  // run off the end: the frame is freed
+      }
+      void await_resume() const noexcept {}
+    };
+
+    DetachedTask get_return_object() noexcept
+      { return {std::coroutine_handle<promise_type>::from_promise(*this)}; }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+} // namespace detail
+
+
+
+// -----------------------------------------------------------------------------------
+//                                Task Executor
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Single-threaded scheduler for task flows.
+ *
+ * All coroutines spawned here are resumed on its thread, so hundreds of flows
+ * across robots share one thread. State predicates are evaluated once per sample
+ * period against one ReadOnce() per robot, however many flows wait on it.
+ *
+ * Destroying the executor destroys the flows that have not finished; their Spawn()
+ * futures then report std::future_errc::broken_promise.
+ */
+class TaskExecutor
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using StateSampler = std::function<std::shared_ptr<RobotState>()>;
+  using StatePredicate = std::function<bool(const RobotState&)>;
+
+  explicit TaskExecutor(std::string thread_name = "SDK_Tasks",
+                        Clock::duration state_period = std::chrono::milliseconds(1))
+    : queue_(std::make_shared<detail::ReadyQueue>()), state_period_(state_period)
+  {
+    thread_ = std::thread([this, name = std::move(thread_name)] {
+      pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+      Run();
+    });
+  }
+
+  ~TaskExecutor()
+  {
+    {
+      std::lock_guard<std::mutex> lock(queue_->mutex);
+      queue_->closed = true;
+    }
+    queue_->cv.notify_all();
+    if (thread_.joinable()) thread_.join();
+  }
+
+  TaskExecutor(const TaskExecutor&) = delete;
+  TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+  /**
+   * @brief Process-wide executor used when none is specified.
+   */
+  static TaskExecutor& Default()
+  {
+    static TaskExecutor executor;
+    return executor;
+  }
+
+  /**
+   * @brief Executor whose thread is the calling thread, or nullptr.
+   */
+  static TaskExecutor* Current() noexcept { return current_; }
+
+  /**
+   * @brief Queue @p h for resumption on the executor thread. Thread-safe.
+   * @return false if the executor is stopping; @p h is not resumed.
+   */
+  bool Post(std::coroutine_handle<> h) { return queue_->Post(h); }
+
+  /**
+   * @brief Resumption queue, for callbacks that may run after the executor is gone.
+   */
+  [[nodiscard]] const std::shared_ptr<detail::ReadyQueue>& Queue() const noexcept { return queue_; }
+
+  /**
+   * @brief Start @p task on this executor.
+   * @return Future holding the result or the exception thrown by the task, or
+   *         broken_promise if the executor is destroyed before the task finished.
+   */
+  template <typename T>
+  std::future<T> Spawn(Task<T> task)
+  {
+    auto promise = std::make_shared<std::promise<T>>();
+    auto future = promise->get_future();
+    Launch(Detach(std::move(task), std::move(promise)));
+    return future;
+  }
+
+  /**
+   * @brief Run a detached root coroutine (e.g. from Spawn()) on this executor. Thread-safe.
+   *
+   * The frame is destroyed, without being resumed, if the executor stops first.
+   */
+  void Launch(detail::DetachedTask task)
+  {
+    auto h = task.handle;
+    h.promise().queue = queue_;
+    {
+      std::lock_guard<std::mutex> lock(queue_->mutex);
+      if (!queue_->closed) {
+        queue_->spawned.insert(h.address());
+        queue_->ready.push_back(h);
+        h = nullptr;
+      }
+    }
+    if (h) h.destroy();
+    else queue_->cv.notify_one();
+  }
+
+  /**
+   * @brief Register a state wait (executor thread only, see StateAwaitable).
+   *
+   * An exception thrown by @p sampler or @p predicate is stored in @p error and
+   * resumes the waiting flow; it never reaches the executor thread.
+   */
+  void AddStateWait(const void* source, StateSampler sampler, StatePredicate predicate,
+                    std::optional<Clock::time_point> deadline, std::shared_ptr<RobotState>* result,
+                    std::exception_ptr* error, std::coroutine_handle<> h)
+  {
+    state_waits_.push_back({source, std::move(sampler), std::move(predicate), deadline, result, error, h});
+  }
+
+  /**
+   * @brief Number of flows currently waiting on a state predicate.
+   */
+  [[nodiscard]] std::size_t StateWaitCount() const noexcept { return state_wait_count_.load(); }
+
+private:
+  struct StateWait
+  {
+    const void* source;
+    StateSampler sampler;
+    StatePredicate predicate;
+    std::optional<Clock::time_point> deadline;
+    std::shared_ptr<RobotState>* result;
+    std::exception_ptr* error;
+    std::coroutine_handle<> handle;
+  };
+
+  struct StateSample
+  {
+    const void* source;
+    std::shared_ptr<RobotState> state;
+    std::exception_ptr error;  ///< Thrown by the sampler; fails every wait on the source.
+  };
+
+  template <typename T>
+  static detail::DetachedTask Detach(Task<T> task, std::shared_ptr<std::promise<T>> promise)
+  {
+    try {
+      if constexpr (std::is_void_v<T>) {
+        co_await task;
+        promise->set_value();
+      } else {
+        promise->set_value(co_await task);
+      }
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  }
+
+  void Run()
+  {
+    current_ = this;
+    std::deque<std::coroutine_handle<>> batch;
+    auto next_sample = Clock::now();
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(queue_->mutex);
+        auto ready = [this] { return queue_->closed || !queue_->ready.empty(); };
+        if (state_waits_.empty()) queue_->cv.wait(lock, ready);
+        else queue_->cv.wait_until(lock, next_sample, ready);
+        if (queue_->closed) break;
+        batch.swap(queue_->ready);
+      }
+      for (auto h : batch) h.resume();
+      batch.clear();
+
+      if (!state_waits_.empty() && Clock::now() >= next_sample) {
+        SampleStates();
+        next_sample = Clock::now() + state_period_;
+      }
+      state_wait_count_.store(state_waits_.size(), std::memory_order_relaxed);
+    }
+    Shutdown();
+  }
+
+  void Shutdown()
+  {
+    // Queued and parked resumption points belong to the frames destroyed below.
+    state_waits_.clear();
+    state_wait_count_.store(0, std::memory_order_relaxed);
+    std::unordered_set<void*> spawned;
+    {
+      std::lock_guard<std::mutex> lock(queue_->mutex);
+      queue_->ready.clear();
+      spawned.swap(queue_->spawned);
+    }
+    // Destroying a root frame destroys the tasks it awaits and its std::promise.
+    for (void* frame : spawned) std::coroutine_handle<>::from_address(frame).destroy();
+  }
+
+  void SampleStates()
+  {
+    // One sample per source per period, shared by all waits on that source.
+    std::vector<StateSample> samples;
+    const auto now = Clock::now();
+    std::vector<StateWait> resumable;
+    for (auto it = state_waits_.begin(); it != state_waits_.end();) {
+      auto cached = std::find_if(samples.begin(), samples.end(),
+                                 [&](const StateSample& s) { return s.source == it->source; });
+      if (cached == samples.end()) {
+        StateSample sample{it->source, nullptr, nullptr};
+        try {
+          sample.state = it->sampler();
+        } catch (...) {
+          sample.error = std::current_exception();
+        }
+        samples.push_back(std::move(sample));
+        cached = std::prev(samples.end());
+      }
+      const auto& state = cached->state;
+      bool matched = false;
+      if (cached->error) {
+        *it->error = cached->error;
+      } else if (state) {
+        try {
+          matched = it->predicate(*state);
+        } catch (...) {
+          *it->error = std::current_exception();
+        }
+      }
+      if (matched) {
+        *it->result = state;
+      } else if (!*it->error && !(it->deadline && now >= *it->deadline)) {
+        ++it;
+        continue;
+      }
+      resumable.push_back(std::move(*it));
+      it = state_waits_.erase(it);
+    }
+    // Resume after the scan: a resumed flow may register a new wait.
+    for (auto& w : resumable) w.handle.resume();
+  }
+
+private:
+  static inline thread_local TaskExecutor* current_{nullptr};
+
+  std::shared_ptr<detail::ReadyQueue> queue_;
+
+  const Clock::duration state_period_;
+  std::vector<StateWait> state_waits_;  ///< Executor thread only.
+  std::atomic<std::size_t> state_wait_count_{0};
+
+  std::thread thread_;
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                                 Awaitables
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Await a command submitted with ControlAsync(); yields its final status.
+ *
+ * The flow is resumed on the executor it runs on, or inline on the completing
+ * thread when awaited outside a TaskExecutor. A command completing after that
+ * executor was destroyed resumes nothing.
+ */
+inline auto operator co_await(CommandHandle handle)
+{
+  struct Awaiter
+  {
+    CommandHandle handle;
+
+    bool await_ready() const noexcept { return handle.Done(); }
+
+    void await_suspend(std::coroutine_handle<> h) const
+    {
+      TaskExecutor* executor = TaskExecutor::Current();
+      std::shared_ptr<detail::ReadyQueue> queue = executor ? executor->Queue() : nullptr;
+      handle.OnComplete([queue = std::move(queue), h](const CommandHandle&) {
+        if (queue) queue->Post(h);
+        else h.resume();
+      });
+    }
+
+    ResponseStatus await_resume() const { return handle.Status(); }
+  };
+  return Awaiter{std::move(handle)};
+}
+
+
+/**
+ * @brief Await a predicate on the robot state.
+ *
+ * Yields the first state satisfying the predicate, or nullptr on timeout. Must be
+ * awaited from a flow running on a TaskExecutor. If reading the state or evaluating
+ * the predicate throws, the exception is rethrown in the awaiting flow.
+ */
+class StateAwaitable
+{
+public:
+  StateAwaitable(const void* source, TaskExecutor::StateSampler sampler, TaskExecutor::StatePredicate predicate,
+                 std::optional<TaskExecutor::Clock::duration> timeout = std::nullopt)
+    : source_(source), sampler_(std::move(sampler)), predicate_(std::move(predicate)), timeout_(timeout)
+  {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> h)
+  {
+    TaskExecutor* executor = TaskExecutor::Current();
+    if (!executor) {
+      throw wisson_SDK::InvalidOperationException("libperseus-StateAwaitable: WaitState must be awaited on a TaskExecutor.");
+    }
+    std::optional<TaskExecutor::Clock::time_point> deadline;
+    if (timeout_) deadline = TaskExecutor::Clock::now() + *timeout_;
+    executor->AddStateWait(source_, std::move(sampler_), std::move(predicate_), deadline, &result_, &error_, h);
+  }
+
+  std::shared_ptr<RobotState> await_resume()
+  {
+    if (error_) std::rethrow_exception(error_);
+    return std::move(result_);
+  }
+
+private:
+  const void* source_;
+  TaskExecutor::StateSampler sampler_;
+  TaskExecutor::StatePredicate predicate_;
+  std::optional<TaskExecutor::Clock::duration> timeout_;
+  std::shared_ptr<RobotState> result_;
+  std::exception_ptr error_;
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,183 @@
+/**
+ * @file setpoint_stream.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Real-time streaming control loop: one setpoint per received state.
+ *
+ * SetpointStreamer runs the user callback on every state arrival (io thread),
+ * encodes the returned setpoint into a preallocated compact frame (88 bytes; 232
+ * for impedance, which also carries per-joint stiffness and damping) and sends it
+ * immediately. Nothing is allocated per cycle. Each cycle is timed from state
+ * arrival to send; cycles slower than the deadline are counted as misses, and
+ * gaps between states longer than 1.5 periods as missed states.
+ *
+ * @example:
+ *   SetpointStreamer loop(ControllerMode::Create(ControlSpace::kJoint, ControlType::kVelocity),
+ *       [&](const RobotState& s, network::Setpoint& sp) { sp.values = servo.Step(s); return true; },
+ *       send_frame);
+ *   // io thread, per state: loop.OnState(state, seq, arrival);
+ *   SPDLOG_INFO("{}", loop.Latency().SummaryUs());
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+#include <functional>
+
+#include "perseuslib/common/latency_histogram.hpp"
+#include "perseuslib/common/robot_state.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+#include "perseuslib/network/setpoint_frame.hpp"
+#include "controller.h"
+
+
+namespace wisson_SDK::control {
+
+/**
+ * @brief Timing parameters of a streaming loop.
+ */
+struct SetpointStreamConfig
+{
+  std::chrono::nanoseconds period{std::chrono::milliseconds(1)};        ///< Nominal state period.
+  std::chrono::nanoseconds deadline{std::chrono::microseconds(500)};    ///< Budget from state arrival to send.
+};
+
+
+/**
+ * @brief Loop counters. Readable from any thread.
+ */
+struct SetpointStreamStats
+{
+  std::atomic<uint64_t> cycles{0};           ///< Setpoints sent.
+  std::atomic<uint64_t> deadline_misses{0};  ///< Cycles slower than the deadline.
+  std::atomic<uint64_t> missed_states{0};    ///< Gaps > 1.5 periods between states.
+  std::atomic<uint64_t> send_failures{0};
+  std::atomic<uint64_t> callback_errors{0};  ///< Callback threw; the loop is stopped.
+};
+
+
+/**
+ * @brief Streams one setpoint per state for kPosition, kVelocity, kTorque and kImpedance modes.
+ *
+ * OnState() must be called from one thread (normally the state io thread). The
+ * callback returns false to end the stream; Stop() may be called from any thread.
+ */
+class SetpointStreamer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using Callback = std::function<bool(const RobotState& state, network::Setpoint& setpoint)>;
+  using Sender = std::function<bool(const uint8_t* data, std::size_t size)>;
+
+  /**
+   * @throw InvalidOperationException if @p mode cannot be streamed or an argument is empty.
+   */
+  SetpointStreamer(ControllerMode mode, Callback callback, Sender sender, SetpointStreamConfig config = {})
+    : mode_(mode), callback_(std::move(callback)), sender_(std::move(sender)), config_(config)
+  {
+    const auto kind = network::SetpointKindFor(mode.type);
+    if (!kind.has_value()) {
+      throw wisson_SDK::InvalidOperationException("libperseus-SetpointStreamer: mode " + mode.ModeToString() +
+                                                  " cannot be streamed.");
+    }
+    if (!callback_ || !sender_) {
+      throw wisson_SDK::InvalidOperationException("libperseus-SetpointStreamer: callback and sender are required.");
+    }
+    kind_ = *kind;
+    setpoint_.kind = kind_;
+  }
+
+  SetpointStreamer(const SetpointStreamer&) = delete;
+  SetpointStreamer& operator=(const SetpointStreamer&) = delete;
+
+  /**
+   * @brief Run one cycle for a newly arrived state.
+   * @param state     Latest robot state.
+   * @param state_seq Sequence number of @p state, echoed in the frame.
+   * @param arrival   Time the state frame was received.
+   * @return false once the stream has ended.
+   */
+  bool OnState(const RobotState& state, uint64_t state_seq, Clock::time_point arrival = Clock::now())
+  {
+    if (!active_.load(std::memory_order_acquire)) return false;
+
+    if (last_arrival_ != Clock::time_point{}) {
+      const auto gap = arrival - last_arrival_;
+      period_.Record(gap);
+      if (gap * 2 > config_.period * 3) stats_.missed_states.fetch_add(1, std::memory_order_relaxed);
+    }
+    last_arrival_ = arrival;
+
+    bool keep_going = false;
+    try {
+      keep_going = callback_(state, setpoint_);
+    } catch (...) {
+      stats_.callback_errors.fetch_add(1, std::memory_order_relaxed);
+      active_.store(false, std::memory_order_release);
+      return false;
+    }
+    if (!keep_going) {
+      active_.store(false, std::memory_order_release);
+      return false;
+    }
+
+    setpoint_.kind = kind_;
+    const std::size_t size = network::EncodeSetpoint(setpoint_, mode_.space, sequence_++, state_seq, frame_);
+    if (!sender_(frame_.data(), size)) {
+      stats_.send_failures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const auto latency = Clock::now() - arrival;
+    latency_.Record(latency);
+    if (latency > config_.deadline) stats_.deadline_misses.fetch_add(1, std::memory_order_relaxed);
+    stats_.cycles.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief End the stream; subsequent states are ignored.
+   */
+  void Stop() noexcept { active_.store(false, std::memory_order_release); }
+
+  [[nodiscard]] bool Active() const noexcept { return active_.load(std::memory_order_acquire); }
+  [[nodiscard]] const ControllerMode& Mode() const noexcept { return mode_; }
+  [[nodiscard]] const SetpointStreamConfig& Config() const noexcept { return config_; }
+  [[nodiscard]] const SetpointStreamStats& Stats() const noexcept { return stats_; }
+
+  /**
+   * @brief State arrival to setpoint sent.
+   */
+  [[nodiscard]] const timer::LatencyHistogram& Latency() const noexcept { return latency_; }
+
+  /**
+   * @brief Interval between consecutive state arrivals.
+   */
+  [[nodiscard]] const timer::LatencyHistogram& Period() const noexcept { return period_; }
+
+private:
+  const ControllerMode mode_;
+  Callback callback_;
+  Sender sender_;
+  const SetpointStreamConfig config_;
+  network::SetpointKind kind_{network::SetpointKind::kPosition};
+
+  network::Setpoint setpoint_{};
+  network::SetpointFrameBuffer frame_{};
+  uint32_t sequence_{0};
+  Clock::time_point last_arrival_{};
+  std::atomic<bool> active_{true};
+
+  SetpointStreamStats stats_;
+  timer::LatencyHistogram latency_;
+  timer::LatencyHistogram period_;
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,254 @@
+/**
+ * @file stop_channel.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Preemptive stop on a priority channel, confirmed by the server.
+ *
+ * This header contains:
+ *  - StopResult  : acknowledgement and issue-to-ack latency of one stop request
+ *  - StopChannel : sends stop frames ahead of queued traffic, waits for the server
+ *                  acknowledgement, then finishes the local commands on the stopped
+ *                  resources
+ *
+ * Stop frames bypass the regular output queue (network::SendQueue::SubmitUrgent), so
+ * a queue saturated with motion or setpoint frames does not delay them. Requires
+ * CapabilityFlag::kPriorityStop on the server.
+ *
+ * Local commands are finished only once the server has accepted the stop: before
+ * that the robot may still be moving. A blocking PerseusRobot::Control() on another
+ * thread is ended by passing its command to Stop(); see detail::PreemptCommand().
+ *
+ * @example:
+ *   StopChannel stop(
+ *     [&](const uint8_t* data, std::size_t size) { return send_queue.SubmitUrgent(data, size); },
+ *     [&](ResourceMask resources) { mux.Preempt(resources); });
+ *   // io thread: if (!mux.OnResponse(id, status)) stop.OnResponse(id, status);
+ *   auto result = stop.Stop();   // all resources, throws if unacknowledged
+ *   stop.Stop(*cmd);             // also returns the Control(mode, cmd) running elsewhere
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "perseuslib/common/latency_histogram.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+#include "perseuslib/network/command_frame.hpp"
+#include "command_table.hpp"
+#include "controller.h"
+
+
+namespace wisson_SDK::control {
+
+/**
+ * @brief Default time a stop request waits for its acknowledgement.
+ */
+inline constexpr std::chrono::milliseconds kDefaultStopAckTimeout{100};
+
+
+/**
+ * @brief Outcome of one acknowledged stop request.
+ */
+struct StopResult
+{
+  uint32_t stop_id{0};
+  ResponseStatus status{ResponseStatus::kUnknown};   ///< Status reported by the server.
+  std::chrono::nanoseconds latency{0};               ///< Stop issued -> acknowledgement received.
+};
+
+
+namespace detail {
+
+/**
+ * @brief Mark a RobotCommand finished so loops polling RobotCommand::finished (the
+ *        Control() loop) return.
+ *
+ * Only the atomic flag is written: RobotCommand::status belongs to the thread that
+ * applies server responses. A command finished this way may keep a non-final
+ * status; treat that as kUserStop.
+ */
+inline void PreemptCommand(RobotCommand& cmd) noexcept
+{
+  cmd.finished.store(true);
+}
+
+} // namespace detail
+
+
+
+// -----------------------------------------------------------------------------------
+//                                Stop Channel
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Issues stop requests and matches their acknowledgements.
+ *
+ * Stop() may be called from any thread, also concurrently; OnResponse() and Abort()
+ * from the io thread. The sender must not block and must not queue behind regular
+ * frames (e.g. network::SendQueue::SubmitUrgent).
+ */
+class StopChannel
+{
+public:
+  using Sender = std::function<bool(const uint8_t* data, std::size_t size)>;
+  using Preempter = std::function<void(ResourceMask resources)>;
+
+  /**
+   * @param preempt Optional hook finishing the local commands on the stopped resources,
+   *                called once the server has accepted the stop request.
+   */
+  explicit StopChannel(Sender sender, Preempter preempt = {})
+    : sender_(std::move(sender)), preempt_(std::move(preempt))
+  {
+    if (!sender_) {
+      throw wisson_SDK::ConstructorException("libperseus-StopChannel: sender is required.");
+    }
+  }
+
+  StopChannel(const StopChannel&) = delete;
+  StopChannel& operator=(const StopChannel&) = delete;
+
+  /**
+   * @brief Stop every command on @p resources and wait for the acknowledgement.
+   * @throw InvalidOperationException on an empty resource mask.
+   * @throw CommandException if the server rejects the stop request.
+   * @throw NetworkException if the frame cannot be queued, the channel was aborted or
+   *        no acknowledgement arrives within @p timeout.
+   */
+  StopResult Stop(ResourceMask resources = kAllResources,
+                  std::chrono::nanoseconds timeout = kDefaultStopAckTimeout)
+  {
+    if (resources == 0) {
+      throw wisson_SDK::InvalidOperationException("libperseus-StopChannel: no resources to stop.");
+    }
+
+    Pending pending{Controller::GenerateCommandId()};
+    std::array<uint8_t, network::kStopFrameSize> frame;
+    network::EncodeStopFrame({pending.stop_id, resources}, frame);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (aborted_) {
+        throw wisson_SDK::NetworkException("libperseus-StopChannel: channel aborted.");
+      }
+      // Registered before sending: the acknowledgement may beat the wait below.
+      pending_.push_back(&pending);
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (!sender_(frame.data(), frame.size())) {
+      Unregister(pending);
+      throw wisson_SDK::NetworkException("libperseus-StopChannel: stop frame " + std::to_string(pending.stop_id) +
+                                         " could not be queued.");
+    }
+
+    bool acknowledged = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      acknowledged = cv_.wait_until(lock, t0 + timeout, [&] { return pending.done || aborted_; }) && pending.done;
+      pending_.erase(std::find(pending_.begin(), pending_.end(), &pending));
+    }
+    if (!acknowledged) {
+      throw wisson_SDK::NetworkException("libperseus-StopChannel: stop " + std::to_string(pending.stop_id) +
+                                         " was not acknowledged.");
+    }
+
+    StopResult result{pending.stop_id, pending.status, pending.acked_at - t0};
+    ack_latency_.Record(result.latency);
+    if (result.status != ResponseStatus::kUserStop && result.status != ResponseStatus::kSuccess) {
+      throw wisson_SDK::CommandException("libperseus-StopChannel: stop " + std::to_string(result.stop_id) +
+                                         " rejected: " + std::string(detail::ResponseStatusToString(result.status)) + ".");
+    }
+    if (preempt_) preempt_(resources);
+    return result;
+  }
+
+  /**
+   * @brief Stop(), then finish @p in_flight so the Control() executing it returns.
+   *
+   * @p in_flight is finished only once the server accepted the stop; on any exception
+   * it is left running, as the robot may be.
+   * @throw see Stop().
+   */
+  StopResult Stop(RobotCommand& in_flight, ResourceMask resources = kAllResources,
+                  std::chrono::nanoseconds timeout = kDefaultStopAckTimeout)
+  {
+    StopResult result = Stop(resources, timeout);
+    detail::PreemptCommand(in_flight);
+    return result;
+  }
+
+  /**
+   * @brief Feed a response received from the server.
+   * @return false if @p cmd_id is not a pending stop request.
+   */
+  bool OnResponse(uint32_t cmd_id, ResponseStatus status)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = std::find_if(pending_.begin(), pending_.end(), [&](const Pending* p) { return p->stop_id == cmd_id; });
+      if (it == pending_.end() || (*it)->done) return false;
+      (*it)->status = status;
+      (*it)->acked_at = now;
+      (*it)->done = true;
+    }
+    cv_.notify_all();
+    return true;
+  }
+
+  /**
+   * @brief Fail every pending and later stop request, e.g. after the connection was lost.
+   */
+  void Abort()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      aborted_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  /**
+   * @brief Issue-to-acknowledgement latency of every acknowledged stop.
+   */
+  [[nodiscard]] const timer::LatencyHistogram& AckLatency() const noexcept { return ack_latency_; }
+
+private:
+  struct Pending
+  {
+    uint32_t stop_id{0};
+    ResponseStatus status{ResponseStatus::kUnknown};
+    std::chrono::steady_clock::time_point acked_at{};
+    bool done{false};
+  };
+
+  void Unregister(Pending& pending)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(std::find(pending_.begin(), pending_.end(), &pending));
+  }
+
+private:
+  Sender sender_;
+  Preempter preempt_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Pending*> pending_;   ///< Stops waiting for their acknowledgement (few at a time).
+  bool aborted_{false};
+  timer::LatencyHistogram ack_latency_;
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,381 @@
+/**
+ * @file sync_start.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Barrier-synchronized start of commands on several robots or arms.
+ *
+ * This header contains:
+ *  - StartReport : achieved start times and skew of one group
+ *  - StartGroup  : stages commands on every target, waits until all of them are
+ *                  acknowledged, then releases them with one trigger per target
+ *
+ * Separate Control() calls start whenever each frame happens to be sent and
+ * acknowledged. A StartGroup moves all of that before the barrier: only a 16 byte
+ * trigger per target remains after it. When every target has a synchronized clock
+ * (timer::ClockSync fed by clock probes), the trigger carries a start time on the
+ * server clock a short lead ahead, so transport jitter no longer shows up as skew.
+ * Otherwise servers start on receipt of the trigger. Any failure before or during
+ * the release withdraws the whole group from every target. Requires
+ * CapabilityFlag::kSyncStart; two arms of one robot additionally need kConcurrentCmds.
+ *
+ * @example:
+ *   StartGroup group;
+ *   auto left  = group.AddTarget(send_queue_a, &clock_a);
+ *   auto right = group.AddTarget(send_queue_b, &clock_b);
+ *   group.Stage(left, *cmd_a, ControllerMode::JointPosition());
+ *   group.Stage(right, *cmd_b, ControllerMode::JointPosition());
+ *   group.Trigger();                       // barrier + release
+ *   auto report = group.WaitStarted();     // report.skew_ns
+ *   // io threads: group.OnResponse(id, status); group.OnStarted(started);
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "perseuslib/common/clock_sync.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+#include "perseuslib/network/command_frame.hpp"
+#include "perseuslib/network/send_queue.hpp"
+#include "perseuslib/network/sync_frame.hpp"
+#include "controller.h"
+
+
+namespace wisson_SDK::control {
+
+/**
+ * @brief Default distance between sending the triggers and the synchronized start.
+ */
+inline constexpr std::chrono::milliseconds kDefaultStartLead{20};
+
+/**
+ * @brief Default time to wait for staging acknowledgements and start reports.
+ */
+inline constexpr std::chrono::seconds kDefaultStartTimeout{1};
+
+
+/**
+ * @brief Achieved start of one StartGroup. Times on the local steady clock [ns].
+ */
+struct StartReport
+{
+  bool clock_synchronized{false};   ///< Timed start; otherwise started on receipt of the trigger.
+  int64_t planned_ns{0};            ///< Planned start (timed start only).
+  std::vector<int64_t> started_ns;  ///< Per staged command, in Stage() order.
+  int64_t skew_ns{0};               ///< Latest minus earliest start; see skew_measured.
+  int64_t clock_error_ns{0};        ///< Bound on the error of skew_ns from the clock offsets.
+  /// Every start time is the server's, converted through a valid clock offset. Otherwise
+  /// some are arrival times of the start reports: skew_ns then includes the return-path
+  /// jitter and is not the start skew, which stays unknown.
+  bool skew_measured{false};
+};
+
+
+// -----------------------------------------------------------------------------------
+//                                Start Group
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief One set of commands that start together.
+ *
+ * AddTarget() / Stage() / Trigger() / WaitStarted() from one user thread,
+ * OnResponse() / OnStarted() from the io threads of the targets. Senders must not
+ * block (e.g. network::SendQueue::Submit). A group is triggered or withdrawn once.
+ *
+ * Targets added with their network::SendQueue get their trigger buffer reserved
+ * before the first trigger leaves, so their release cannot fail. A plain sender can;
+ * those targets are released first, and a failure withdraws the group again.
+ */
+class StartGroup
+{
+public:
+  using Sender = std::function<bool(const uint8_t* data, std::size_t size)>;
+
+  explicit StartGroup(uint32_t group_id = Controller::GenerateCommandId()) : group_id_(group_id) {}
+
+  StartGroup(const StartGroup&) = delete;
+  StartGroup& operator=(const StartGroup&) = delete;
+
+  /**
+   * @brief Add one connection (robot).
+   * @param clock Offset to the clock of this server, or nullptr if it has none; must
+   *              outlive the group.
+   * @return Target index for Stage().
+   */
+  std::size_t AddTarget(Sender sender, const timer::ClockSync* clock = nullptr)
+  {
+    if (!sender) {
+      throw wisson_SDK::InvalidOperationException("libperseus-StartGroup: sender is required.");
+    }
+    targets_.push_back({std::move(sender), nullptr, clock});
+    return targets_.size() - 1;
+  }
+
+  /**
+   * @brief Add one connection whose frames go through @p queue; must outlive the group.
+   */
+  std::size_t AddTarget(network::SendQueue& queue, const timer::ClockSync* clock = nullptr)
+  {
+    targets_.push_back({[&queue](const uint8_t* data, std::size_t size) { return queue.Submit(data, size); },
+                        &queue, clock});
+    return targets_.size() - 1;
+  }
+
+  /**
+   * @brief Send @p cmd to @p target, held by the server until the trigger.
+   * @throw InvalidOperationException on an unknown target or after Trigger() / Withdraw().
+   * @throw CommandException if @p cmd has no compact frame for @p mode.
+   * @throw NetworkException if the frame cannot be queued; the group is withdrawn.
+   */
+  void Stage(std::size_t target, RobotCommand& cmd, const ControllerMode& mode,
+             const network::ImpedanceGains* gains = nullptr)
+  {
+    if (target >= targets_.size() || triggered_) {
+      throw wisson_SDK::InvalidOperationException("libperseus-StartGroup: unknown target or group already triggered or withdrawn.");
+    }
+    if (cmd.cmd_id == 0) cmd.cmd_id = Controller::GenerateCommandId();
+    network::EncodeCommandFrame(cmd, mode, command_frame_, gains);
+    network::EncodeStageFrame(group_id_, command_frame_, stage_frame_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entries_.push_back({cmd.cmd_id, target});
+    }
+    if (!targets_[target].sender(stage_frame_.data(), stage_frame_.size())) {
+      Withdraw();
+      throw wisson_SDK::NetworkException("libperseus-StartGroup: stage frame for command " +
+                                         std::to_string(cmd.cmd_id) + " could not be queued.");
+    }
+    cmd.status = ResponseStatus::kSending;
+  }
+
+  /**
+   * @brief Wait until every staged command is acknowledged, then release all of them.
+   * @param lead Distance of the synchronized start from now; unused when a target has
+   *             no synchronized clock.
+   * @return Planned start on the local clock [ns], or 0 if targets start on receipt.
+   * @throw CommandException if a target refused a staged command.
+   * @throw NetworkException on acknowledgement timeout, if no trigger buffer can be
+   *        reserved or a trigger cannot be queued.
+   * On every failure the group is withdrawn from all targets before throwing.
+   */
+  int64_t Trigger(std::chrono::nanoseconds lead = kDefaultStartLead,
+                  std::chrono::nanoseconds stage_timeout = kDefaultStartTimeout)
+  {
+    if (triggered_ || entries_.empty()) {
+      throw wisson_SDK::InvalidOperationException("libperseus-StartGroup: nothing staged or group already triggered or withdrawn.");
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      const bool all_acked = cv_.wait_for(lock, stage_timeout, [&] {
+        return std::all_of(entries_.begin(), entries_.end(), [](const Entry& e) { return e.acked; });
+      });
+      const auto refused = std::find_if(entries_.begin(), entries_.end(), [](const Entry& e) { return e.refused; });
+      if (refused != entries_.end()) {
+        const uint32_t cmd_id = refused->cmd_id;
+        lock.unlock();
+        Withdraw();
+        throw wisson_SDK::CommandException("libperseus-StartGroup: command " + std::to_string(cmd_id) +
+                                           " was refused while staging.");
+      }
+      if (!all_acked) {
+        lock.unlock();
+        Withdraw();
+        throw wisson_SDK::NetworkException("libperseus-StartGroup: staging was not acknowledged by every target.");
+      }
+    }
+
+    const bool synchronized = std::all_of(targets_.begin(), targets_.end(),
+                                          [](const Target& t) { return t.clock != nullptr && t.clock->Valid(); });
+    // Encode and reserve everything first so the triggers leave back to back.
+    const int64_t planned = synchronized ? timer::SteadyNowNs() + lead.count() : 0;
+    std::vector<std::array<uint8_t, network::kTriggerSize>> frames(targets_.size());
+    std::vector<network::FrameBuffer*> reserved(targets_.size(), nullptr);
+    bool all_reserved = true;
+    for (std::size_t i = 0; i < targets_.size(); ++i) {
+      const int64_t start = synchronized ? targets_[i].clock->ToRemote(planned) : 0;
+      network::EncodeTrigger({group_id_, start}, frames[i]);
+      if (targets_[i].queue == nullptr) continue;
+      reserved[i] = targets_[i].queue->Acquire();
+      if (reserved[i] == nullptr || !reserved[i]->Assign(frames[i].data(), frames[i].size())) all_reserved = false;
+    }
+    if (!all_reserved) {
+      for (std::size_t i = 0; i < targets_.size(); ++i) {
+        if (reserved[i] != nullptr) targets_[i].queue->Discard(reserved[i]);
+      }
+      Withdraw();
+      throw wisson_SDK::NetworkException("libperseus-StartGroup: no send buffer for every trigger.");
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      synchronized_ = synchronized;
+      planned_ns_ = planned;
+      triggered_ = true;
+    }
+    // Plain senders may fail, so they go first: a failure there leaves fewer started.
+    for (std::size_t i = 0; i < targets_.size(); ++i) {
+      if (reserved[i] != nullptr) continue;
+      if (!targets_[i].sender(frames[i].data(), frames[i].size())) {
+        for (std::size_t j = 0; j < targets_.size(); ++j) {
+          if (reserved[j] != nullptr) targets_[j].queue->Discard(reserved[j]);
+        }
+        Withdraw();
+        throw wisson_SDK::NetworkException("libperseus-StartGroup: trigger could not be queued.");
+      }
+    }
+    for (std::size_t i = 0; i < targets_.size(); ++i) {
+      if (reserved[i] != nullptr) targets_[i].queue->Submit(reserved[i]);
+    }
+    return planned;
+  }
+
+  /**
+   * @brief Drop the staged commands of the group on every target and stop those
+   *        already started (best effort; called by Stage() / Trigger() on failure).
+   *
+   * The group can no longer be triggered afterwards.
+   */
+  void Withdraw()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      triggered_ = true;
+    }
+    std::array<uint8_t, network::kWithdrawSize> frame;
+    network::EncodeWithdraw(group_id_, frame);
+    for (auto& t : targets_) t.sender(frame.data(), frame.size());
+  }
+
+  /**
+   * @brief Wait for the start report of every staged command.
+   * @throw NetworkException if a report is missing after @p timeout.
+   */
+  StartReport WaitStarted(std::chrono::nanoseconds timeout = kDefaultStartTimeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const bool all_started = cv_.wait_for(lock, timeout, [&] {
+      return std::all_of(entries_.begin(), entries_.end(), [](const Entry& e) { return e.started; });
+    });
+    if (!all_started) {
+      throw wisson_SDK::NetworkException("libperseus-StartGroup: missing start report.");
+    }
+
+    StartReport report;
+    report.clock_synchronized = synchronized_;
+    report.planned_ns = planned_ns_;
+    int64_t earliest = std::numeric_limits<int64_t>::max();
+    int64_t latest = std::numeric_limits<int64_t>::min();
+    report.skew_measured = true;
+    for (const auto& e : entries_) {
+      report.started_ns.push_back(e.started_ns);
+      earliest = std::min(earliest, e.started_ns);
+      latest = std::max(latest, e.started_ns);
+      report.skew_measured = report.skew_measured && e.clock_rtt_ns >= 0;
+      report.clock_error_ns = std::max(report.clock_error_ns, e.clock_rtt_ns);
+    }
+    report.skew_ns = latest - earliest;
+    return report;
+  }
+
+  /**
+   * @brief Feed a command response (io thread).
+   * @return false if @p cmd_id is not a staged command awaiting its acknowledgement.
+   */
+  bool OnResponse(uint32_t cmd_id, ResponseStatus status)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Entry* e = Find(cmd_id);
+      if (e == nullptr || e->acked) return false;
+      e->acked = true;
+      e->refused = detail::IsActionFinished(status);
+    }
+    cv_.notify_all();
+    return true;
+  }
+
+  /**
+   * @brief Feed a start report (io thread).
+   *
+   * The server's start time is converted to the local clock whenever the target's
+   * clock is synchronized, also for a group started on receipt of the trigger.
+   * @param arrival_ns Arrival on the local clock; used as the start time when the
+   *                   target has no synchronized clock (StartReport::skew_measured
+   *                   is then false).
+   * @return false if the report does not belong to this group.
+   */
+  bool OnStarted(const network::Started& s, int64_t arrival_ns = timer::SteadyNowNs())
+  {
+    if (s.group_id != group_id_) return false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Entry* e = Find(s.cmd_id);
+      if (e == nullptr || e->started) return false;
+      const timer::ClockSync* clock = targets_[e->target].clock;
+      if (clock != nullptr && clock->Valid()) {
+        e->started_ns = clock->ToLocal(s.started_ns);
+        e->clock_rtt_ns = clock->RttNs();
+      } else {
+        e->started_ns = arrival_ns;
+      }
+      e->started = true;
+    }
+    cv_.notify_all();
+    return true;
+  }
+
+  [[nodiscard]] uint32_t GroupId() const noexcept { return group_id_; }
+
+private:
+  struct Target
+  {
+    Sender sender;
+    network::SendQueue* queue{nullptr};   ///< Set when trigger buffers can be reserved.
+    const timer::ClockSync* clock{nullptr};
+  };
+
+  struct Entry
+  {
+    uint32_t cmd_id{0};
+    std::size_t target{0};
+    bool acked{false};
+    bool refused{false};
+    bool started{false};
+    int64_t started_ns{0};
+    int64_t clock_rtt_ns{-1};   ///< Of the clock converting started_ns; -1 for an arrival time.
+  };
+
+  Entry* Find(uint32_t cmd_id) noexcept
+  {
+    auto it = std::find_if(entries_.begin(), entries_.end(), [&](const Entry& e) { return e.cmd_id == cmd_id; });
+    return it == entries_.end() ? nullptr : &*it;
+  }
+
+private:
+  const uint32_t group_id_;
+  std::vector<Target> targets_;
+  std::vector<uint8_t> command_frame_;
+  std::vector<uint8_t> stage_frame_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Entry> entries_;
+  bool triggered_{false};
+  bool synchronized_{false};
+  int64_t planned_ns_{0};
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,405 @@
+/**
+ * @file task_graph.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Dependency-graph execution of work-cell programs across arms and robots.
+ *
+ * This header contains:
+ *  - CellResource    : part of one robot (arms, end effector) a node occupies
+ *  - TaskGraphReport : per-node timing, makespan and the critical path
+ *  - TaskGraph       : DAG of commands, state waits and user functions; runs every
+ *                      node as soon as its dependencies finished and its resources
+ *                      are free, so independent branches overlap
+ *
+ * Nodes run as flows on a TaskExecutor: commands are awaited through their
+ * CommandHandle (ControlAsync, EndEffectorAsync, CommandMultiplexer::Submit),
+ * state waits through StateAwaitable, user functions on their own thread. Among
+ * startable nodes the one with the longest remaining path (by the expected
+ * durations given to Add*) goes first. A node that does not succeed skips its
+ * dependents; independent branches keep running.
+ *
+ * Commands of one robot sent through ControlAsync / EndEffectorAsync never overlap:
+ * they share the robot's single CommandDispatcher thread and the controller's single
+ * in-flight command, so the graph only gains across robots and from waits and user
+ * functions. Give such nodes the whole robot (RobotResource(robot)). Per-arm masks
+ * only pay off for commands submitted through a CommandMultiplexer whose sender
+ * keeps several commands in flight on one connection.
+ *
+ * @example:
+ *   TaskGraph cell;
+ *   auto a = cell.AddCommand("A pick", {RobotResource(robot_a.get())},
+ *                            [&] { return robot_a->ControlAsync(mode, pick); }, {}, 2.0);
+ *   auto b = cell.AddCommand("B inspect", {RobotResource(robot_b.get())},
+ *                            [&] { return robot_b->ControlAsync(mode, inspect); });   // overlaps A
+ *   cell.AddCommand("A close", {RobotResource(robot_a.get())},
+ *                   [&] { return robot_a->EndEffectorAsync(EndEffectorAction::Close); }, {a});
+ *   auto report = cell.Run().get();
+ *   SPDLOG_INFO("{}", report.ToString());
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "command_handle.hpp"
+#include "command_table.hpp"
+#include "robot_task.hpp"
+
+
+namespace wisson_SDK::control {
+
+// -----------------------------------------------------------------------------------
+//                                 Resources
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Parts of one robot held by a node. Two nodes conflict if they name the
+ *        same owner and their masks overlap.
+ * @note Disjoint masks on one robot are only honest for commands that can run
+ *       concurrently (CommandMultiplexer); ControlAsync executes one at a time.
+ */
+struct CellResource
+{
+  const void* owner{nullptr};       ///< Robot (or any other shared object).
+  ResourceMask parts{kAllResources};
+
+  [[nodiscard]] constexpr bool Conflicts(const CellResource& other) const noexcept
+  {
+    return owner == other.owner && (parts & other.parts) != 0;
+  }
+};
+
+/**
+ * @brief @p parts of @p robot; the whole robot by default.
+ */
+[[nodiscard]] inline constexpr CellResource RobotResource(const void* robot, ResourceMask parts = kAllResources) noexcept
+{
+  return {robot, parts};
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                                   Report
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Outcome of one TaskGraph::Run(). Times in milliseconds since the start.
+ */
+struct TaskGraphReport
+{
+  struct Node
+  {
+    std::string name;
+    ResponseStatus status{ResponseStatus::kIdle};
+    bool skipped{false};     ///< Not run because a dependency did not succeed.
+    double start_ms{0.0};
+    double end_ms{0.0};
+  };
+
+  std::vector<Node> nodes;
+  double makespan_ms{0.0};
+  double dependency_bound_ms{0.0};      ///< Longest dependency chain of measured durations.
+  std::vector<std::size_t> critical_path;  ///< Nodes whose completion released the next, ending last.
+
+  [[nodiscard]] bool Succeeded() const noexcept
+  {
+    return std::all_of(nodes.begin(), nodes.end(), [](const Node& n) { return n.status == ResponseStatus::kSuccess; });
+  }
+
+  /**
+   * @brief Makespan, bound and critical path on one line.
+   */
+  [[nodiscard]] std::string ToString() const
+  {
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "Makespan = [%.1f ms], DependencyBound = [%.1f ms], CriticalPath = [",
+                  makespan_ms, dependency_bound_ms);
+    std::string s = buf;
+    for (std::size_t i = 0; i < critical_path.size(); ++i) {
+      if (i > 0) s += " -> ";
+      s += nodes[critical_path[i]].name;
+    }
+    return s + "]";
+  }
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                                 Task Graph
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief DAG of cell operations. Dependencies must be added before their dependents,
+ *        which keeps every graph acyclic by construction.
+ */
+class TaskGraph
+{
+public:
+  using NodeId = std::size_t;
+  using Action = std::function<Task<ResponseStatus>()>;
+
+  /**
+   * @brief Add a node running @p action; it counts as successful if it yields kSuccess.
+   * @param expected_s Expected duration, used to prioritize the longest remaining path.
+   * @throw InvalidOperationException if a dependency does not exist yet.
+   */
+  NodeId AddTask(std::string name, std::vector<CellResource> resources, Action action,
+                 std::vector<NodeId> deps = {}, double expected_s = 0.0)
+  {
+    const NodeId id = nodes_.size();
+    for (NodeId d : deps) {
+      if (d >= id) {
+        throw wisson_SDK::InvalidOperationException("libperseus-TaskGraph: node " + name +
+                                                    " depends on unknown node " + std::to_string(d) + ".");
+      }
+    }
+    if (!action) {
+      throw wisson_SDK::InvalidOperationException("libperseus-TaskGraph: node " + name + " has no action.");
+    }
+    nodes_.push_back({std::move(name), std::move(resources), std::move(action), std::move(deps), expected_s});
+    return id;
+  }
+
+  /**
+   * @brief Motion or end-effector command: @p submit is called when the node starts
+   *        (e.g. robot->ControlAsync(mode, cmd)) and the node finishes with the handle.
+   */
+  NodeId AddCommand(std::string name, std::vector<CellResource> resources, std::function<CommandHandle()> submit,
+                    std::vector<NodeId> deps = {}, double expected_s = 0.0)
+  {
+    return AddTask(std::move(name), std::move(resources), [submit = std::move(submit)] { return AwaitCommand(submit); },
+                   std::move(deps), expected_s);
+  }
+
+  /**
+   * @brief Wait on the robot state, e.g. [&] { return robot->WaitState(pred, timeout); }.
+   *        Finishes with kTimeout if no matching state arrived.
+   */
+  NodeId AddWait(std::string name, std::function<StateAwaitable()> wait, std::vector<NodeId> deps = {},
+                 double expected_s = 0.0)
+  {
+    return AddTask(std::move(name), {}, [wait = std::move(wait)] { return AwaitState(wait); }, std::move(deps),
+                   expected_s);
+  }
+
+  /**
+   * @brief User function, run on its own thread so it may block. Finishes with kFail
+   *        if it throws.
+   */
+  NodeId AddFunction(std::string name, std::vector<CellResource> resources, std::function<void()> fn,
+                     std::vector<NodeId> deps = {}, double expected_s = 0.0)
+  {
+    return AddCommand(std::move(name), std::move(resources), [fn = std::move(fn)] { return RunOnThread(fn); },
+                      std::move(deps), expected_s);
+  }
+
+  [[nodiscard]] std::size_t Size() const noexcept { return nodes_.size(); }
+
+  /**
+   * @brief Execute the graph on @p executor. The graph may be run again afterwards.
+   * @return Future of the report, ready once every node finished or was skipped.
+   */
+  std::future<TaskGraphReport> Run(TaskExecutor& executor = TaskExecutor::Default()) const
+  {
+    auto run = std::make_shared<RunState>(nodes_, executor);
+    auto future = run->done.get_future();
+    executor.Spawn(Start(run));
+    return future;
+  }
+
+private:
+  struct Node
+  {
+    std::string name;
+    std::vector<CellResource> resources;
+    Action action;
+    std::vector<NodeId> deps;
+    double expected_s{0.0};
+  };
+
+  static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+  /**
+   * @brief Scheduling state of one run. Touched only on the executor thread.
+   */
+  struct RunState : std::enable_shared_from_this<RunState>
+  {
+    RunState(const std::vector<Node>& graph, TaskExecutor& exec)
+      : nodes(graph), executor(exec), remaining_deps(graph.size()), dependents(graph.size()),
+        rank(graph.size(), 0.0), enabler(graph.size(), kNone), state(graph.size(), kPending)
+    {
+      for (std::size_t i = 0; i < nodes.size(); ++i) {
+        remaining_deps[i] = nodes[i].deps.size();
+        for (NodeId d : nodes[i].deps) dependents[d].push_back(i);
+      }
+      for (std::size_t i = nodes.size(); i-- > 0;) {
+        double tail = 0.0;
+        for (NodeId c : dependents[i]) tail = std::max(tail, rank[c]);
+        rank[i] = nodes[i].expected_s + tail;
+      }
+      report.nodes.resize(nodes.size());
+      for (std::size_t i = 0; i < nodes.size(); ++i) report.nodes[i].name = nodes[i].name;
+    }
+
+    /**
+     * @brief Start every node whose dependencies finished and whose resources are free.
+     */
+    void Pump(std::size_t released_by)
+    {
+      std::vector<std::size_t> ready;
+      for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (state[i] == kPending && remaining_deps[i] == 0) ready.push_back(i);
+      }
+      std::stable_sort(ready.begin(), ready.end(), [&](std::size_t a, std::size_t b) { return rank[a] > rank[b]; });
+      for (std::size_t i : ready) {
+        const bool blocked = std::any_of(nodes[i].resources.begin(), nodes[i].resources.end(), [&](const CellResource& r) {
+          return std::any_of(held.begin(), held.end(), [&](const auto& h) { return r.Conflicts(h.second); });
+        });
+        if (blocked) continue;
+        for (const auto& r : nodes[i].resources) held.emplace_back(i, r);
+        state[i] = kRunning;
+        enabler[i] = released_by;
+        report.nodes[i].start_ms = ElapsedMs();
+        executor.Launch(Execute(shared_from_this(), i));
+      }
+      if (finished == nodes.size()) Finish();
+    }
+
+    void OnFinished(std::size_t i, ResponseStatus status)
+    {
+      report.nodes[i].status = status;
+      report.nodes[i].end_ms = ElapsedMs();
+      state[i] = kDone;
+      ++finished;
+      std::erase_if(held, [i](const auto& h) { return h.first == i; });
+      for (NodeId c : dependents[i]) {
+        --remaining_deps[c];
+        if (status != ResponseStatus::kSuccess) Skip(c);
+      }
+      Pump(i);
+    }
+
+    void Skip(std::size_t i)
+    {
+      if (state[i] != kPending) return;
+      state[i] = kDone;
+      ++finished;
+      report.nodes[i].skipped = true;
+      report.nodes[i].status = ResponseStatus::kAbort;
+      for (NodeId c : dependents[i]) {
+        --remaining_deps[c];
+        Skip(c);
+      }
+    }
+
+    void Finish()
+    {
+      double end = 0.0;
+      std::size_t last = kNone;
+      std::vector<double> chain(nodes.size(), 0.0);
+      for (std::size_t i = 0; i < nodes.size(); ++i) {
+        const auto& n = report.nodes[i];
+        if (n.skipped) continue;
+        double before = 0.0;
+        for (NodeId d : nodes[i].deps) before = std::max(before, chain[d]);
+        chain[i] = before + (n.end_ms - n.start_ms);
+        report.dependency_bound_ms = std::max(report.dependency_bound_ms, chain[i]);
+        if (n.end_ms >= end) {
+          end = n.end_ms;
+          last = i;
+        }
+      }
+      report.makespan_ms = end;
+      for (std::size_t i = last; i != kNone; i = enabler[i]) report.critical_path.push_back(i);
+      std::reverse(report.critical_path.begin(), report.critical_path.end());
+      done.set_value(std::move(report));
+    }
+
+    [[nodiscard]] double ElapsedMs() const
+    {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    enum NodeState : uint8_t { kPending, kRunning, kDone };
+
+    const std::vector<Node> nodes;
+    TaskExecutor& executor;
+    std::vector<std::size_t> remaining_deps;
+    std::vector<std::vector<NodeId>> dependents;
+    std::vector<double> rank;               ///< Longest expected path from the node to a sink.
+    std::vector<std::size_t> enabler;       ///< Node whose completion started this one.
+    std::vector<NodeState> state;
+    std::vector<std::pair<std::size_t, CellResource>> held;
+    std::size_t finished{0};
+    std::chrono::steady_clock::time_point t0{std::chrono::steady_clock::now()};
+    TaskGraphReport report;
+    std::promise<TaskGraphReport> done;
+  };
+
+  static Task<void> Start(std::shared_ptr<RunState> run)
+  {
+    run->t0 = std::chrono::steady_clock::now();
+    run->Pump(kNone);
+    co_return;
+  }
+
+  static detail::DetachedTask Execute(std::shared_ptr<RunState> run, std::size_t i)
+  {
+    ResponseStatus status = ResponseStatus::kFail;
+    try {
+      status = co_await run->nodes[i].action();
+    } catch (...) {
+      status = ResponseStatus::kFail;
+    }
+    run->OnFinished(i, status);
+  }
+
+  static Task<ResponseStatus> AwaitCommand(std::function<CommandHandle()> submit)
+  {
+    co_return co_await submit();
+  }
+
+  static Task<ResponseStatus> AwaitState(std::function<StateAwaitable()> wait)
+  {
+    auto state = co_await wait();
+    co_return state ? ResponseStatus::kSuccess : ResponseStatus::kTimeout;
+  }
+
+  static CommandHandle RunOnThread(const std::function<void()>& fn)
+  {
+    auto state = std::make_shared<detail::CommandHandleState>();
+    state->state = CommandState::kRunning;
+    std::thread([state, fn] {
+      try {
+        fn();
+        state->Complete(ResponseStatus::kSuccess);
+      } catch (...) {
+        state->Complete(ResponseStatus::kFail, std::current_exception());
+      }
+    }).detach();
+    return CommandHandle(state);
+  }
+
+private:
+  std::vector<Node> nodes_;
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,342 @@
+/**
+ * @file time_optimal.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Time-optimal path parameterization (TOPP) under joint velocity and acceleration limits.
+ *
+ * The geometric path is the C2 cubic spline through the waypoints (the path of
+ * SegmentProfile::kCubicSpline), with path parameter s. Along the path every joint
+ * satisfies
+ *
+ *   qdot = q'(s) sdot,   qddot = q'(s) sddot + q''(s) sdot^2,
+ *
+ * so with x = sdot^2 the joint limits become linear constraints on (x, sddot).
+ * On a grid of s the planner computes the controllable sets backward from rest at
+ * the end (largest x from which the end is still reachable), then the greedy
+ * maximal x forward from rest at the start (reachability analysis, as in TOPP-RA).
+ * The result is the minimum-time traversal of the path to within the grid
+ * resolution: at every instant one joint is on its velocity or acceleration limit.
+ *
+ * This header contains:
+ *  - TimeOptimalPath, planned from waypoints and BlendLimits
+ *  - TimeOptimalLimits reading the limits from CommandLimits (config.yaml)
+ *  - PlanTimeOptimal for RobotCommand inputs, SampleTimeOptimal for streaming
+ *
+ * @example:
+ *   const auto limits = TimeOptimalLimits(LoadCommandLimits(CONFIG_PATH "/config.yaml"));
+ *   auto path = PlanTimeOptimal(*cmd, limits);
+ *   robot->Control(ControllerMode::JointPosition(), path.ToCommand());   // tightened timeouts
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "command_validator.hpp"
+#include "robot_command.hpp"
+#include "trajectory_sampler.hpp"
+#include "trajectory_stream.hpp"
+
+
+namespace wisson_SDK::control {
+
+/**
+ * @brief Planner limits from the CommandLimits section of config.yaml.
+ * @throw InvalidOperationException if a velocity or acceleration limit is missing or not positive.
+ */
+[[nodiscard]] inline BlendLimits<JOINT_NUM> TimeOptimalLimits(const CommandLimits& limits)
+{
+  BlendLimits<JOINT_NUM> l;
+  for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+    const double v = limits.velocity_max[j], a = limits.acceleration_max[j];
+    if (!(v > 0.0 && std::isfinite(v) && a > 0.0 && std::isfinite(a))) {
+      throw wisson_SDK::InvalidOperationException("libperseus-TimeOptimalPath: joint " + std::to_string(j) +
+                                                  " needs finite positive velocity and acceleration limits.");
+    }
+    l.max_velocity[j] = v;
+    l.max_acceleration[j] = a;
+  }
+  return l;
+}
+
+
+// -----------------------------------------------------------------------------------
+//                              TimeOptimalPath
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Minimum-time traversal of the spline through a list of waypoints, from rest to rest.
+ *
+ * Built once by Plan(); the const members may be called from any thread.
+ */
+class TimeOptimalPath
+{
+public:
+  static constexpr std::size_t kDefaultGridSize = 2000;
+
+  TimeOptimalPath() = default;
+
+  /**
+   * @brief Plan the minimum-time parameterization of the path through @p waypoints.
+   * @param grid Intervals of the path parameter; the time error shrinks with 1 / grid.
+   * @throw InvalidOperationException on empty waypoints, non-positive limits or grid < 2.
+   */
+  static TimeOptimalPath Plan(std::span<const JointVector> waypoints, const BlendLimits<JOINT_NUM>& limits,
+                              std::size_t grid = kDefaultGridSize)
+  {
+    if (grid < 2) {
+      throw wisson_SDK::InvalidOperationException("libperseus-TimeOptimalPath: the grid needs at least 2 intervals.");
+    }
+    TimeOptimalPath path;
+    path.geometry_ = PiecewiseTrajectory::Plan(waypoints, SegmentProfile::kCubicSpline, limits);
+    const double length = path.geometry_.Duration();
+    if (length <= 0.0) {
+      path.x_ = {0.0};
+      path.t_ = {0.0};
+      return path;
+    }
+
+    const std::size_t n = grid;
+    path.ds_ = length / static_cast<double>(n);
+    std::vector<TrajectoryPoint> geo(n + 1);
+    path.geometry_.SampleUniform(0.0, path.ds_, geo);
+
+    // Velocity limit curve x <= (V / |q'|)^2; where q' vanishes only the acceleration bounds x.
+    std::vector<double> x_max(n + 1, std::numeric_limits<double>::infinity());
+    for (std::size_t i = 0; i <= n; ++i) {
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+        const double dq = std::abs(geo[i].velocity[j]), ddq = std::abs(geo[i].acceleration[j]);
+        if (dq > kTinyDerivative) x_max[i] = std::min(x_max[i], std::pow(limits.max_velocity[j] / dq, 2));
+        else if (ddq > kTinyDerivative) x_max[i] = std::min(x_max[i], limits.max_acceleration[j] / ddq);
+      }
+      x_max[i] = std::min(x_max[i], kMaxX);
+    }
+
+    // Range of y = x[i + 1] reachable from x[i] = x with sddot = (y - x) / 2ds, where the
+    // acceleration q' sddot + q'' sdot^2 stays within +-A at both ends of the interval
+    // (one end alone leaves sddot free where q' vanishes, e.g. at the start).
+    struct Range { double lo; double hi; };
+    auto next_range = [&](std::size_t i, double x) {
+      Range r{0.0, x_max[i + 1]};
+      // k y + m in [-A, A]
+      auto bound = [&](double k, double m, double A) {
+        if (std::abs(k) <= kTinyDerivative) {
+          if (std::abs(m) > A) r = Range{1.0, 0.0};
+          return;
+        }
+        const double b1 = (-A - m) / k, b2 = (A - m) / k;
+        r.lo = std::max(r.lo, std::min(b1, b2));
+        r.hi = std::min(r.hi, std::max(b1, b2));
+      };
+      const double h = 0.5 / path.ds_;
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+        const double A = limits.max_acceleration[j];
+        const double dq0 = geo[i].velocity[j], ddq0 = geo[i].acceleration[j];
+        const double dq1 = geo[i + 1].velocity[j], ddq1 = geo[i + 1].acceleration[j];
+        bound(dq0 * h, (ddq0 - dq0 * h) * x, A);
+        bound(dq1 * h + ddq1, -dq1 * h * x, A);
+      }
+      return r;
+    };
+
+    // Backward: controllable sets [0, c[i]], the end at rest.
+    std::vector<double> c(n + 1, 0.0);
+    for (std::size_t i = n; i-- > 0;) {
+      auto controllable = [&](double x) {
+        const Range r = next_range(i, x);
+        return r.lo <= std::min(r.hi, c[i + 1]);
+      };
+      if (controllable(x_max[i])) {
+        c[i] = x_max[i];
+        continue;
+      }
+      double lo = 0.0, hi = x_max[i];
+      for (int k = 0; k < kBisections; ++k) {
+        const double mid = 0.5 * (lo + hi);
+        (controllable(mid) ? lo : hi) = mid;
+      }
+      c[i] = lo;
+    }
+
+    // Forward: greedy largest x inside the controllable sets, the start at rest.
+    path.x_.assign(n + 1, 0.0);
+    path.t_.assign(n + 1, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+      const Range r = next_range(i, path.x_[i]);
+      path.x_[i + 1] = std::max(0.0, std::min(r.hi, c[i + 1]));
+      const double speed = std::sqrt(path.x_[i]) + std::sqrt(path.x_[i + 1]);
+      path.t_[i + 1] = path.t_[i] + (speed > 0.0 ? 2.0 * path.ds_ / speed : 0.0);
+    }
+    return path;
+  }
+
+  /**
+   * @brief Minimum traversal time [s].
+   */
+  [[nodiscard]] double Duration() const noexcept { return t_.empty() ? 0.0 : t_.back(); }
+
+  /**
+   * @brief The geometric path; its time axis is the path parameter s.
+   */
+  [[nodiscard]] const PiecewiseTrajectory& Geometry() const noexcept { return geometry_; }
+
+  /**
+   * @brief Time [s] at which each (distinct) waypoint is passed; front() = 0, back() = Duration().
+   */
+  [[nodiscard]] std::vector<double> WaypointTimes() const
+  {
+    std::vector<double> times;
+    for (const auto& piece : geometry_.Pieces()) times.push_back(TimeAt(piece.t0));
+    if (geometry_.Duration() > 0.0) times.push_back(Duration());
+    return times;
+  }
+
+  /**
+   * @brief Position, velocity and acceleration at time @p t (clamped to [0, Duration()]).
+   */
+  void At(double t, TrajectoryPoint& out) const noexcept
+  {
+    if (t_.size() < 2) {
+      geometry_.At(0.0, out);
+      return;
+    }
+    t = std::clamp(t, 0.0, Duration());
+    const std::size_t i = std::min<std::size_t>(
+      static_cast<std::size_t>(std::upper_bound(t_.begin(), t_.end(), t) - t_.begin()) - 1, t_.size() - 2);
+    const double tau = t - t_[i];
+    const double u = (x_[i + 1] - x_[i]) / (2.0 * ds_);
+    const double sd = std::max(0.0, std::sqrt(x_[i]) + u * tau);
+    const double s = std::min(static_cast<double>(i) * ds_ + tau * (std::sqrt(x_[i]) + 0.5 * u * tau),
+                              geometry_.Duration());
+    Compose(s, sd, u, out);
+  }
+
+  [[nodiscard]] TrajectoryPoint At(double t) const noexcept
+  {
+    TrajectoryPoint p;
+    At(t, p);
+    return p;
+  }
+
+  /**
+   * @brief One MotionCommand per waypoint after the first, which is the start.
+   *
+   * Each carries the waypoint, the path velocity there as feed-forward joint
+   * velocity, and a timeout of its planned segment time * (1 + @p margin) + @p slack_s
+   * instead of a hand-picked one.
+   * @throw ConstructorException if the path has more than cmd_list_size segments.
+   */
+  [[nodiscard]] std::shared_ptr<RobotCommand> ToCommand(double margin = 0.1, double slack_s = 0.02) const
+  {
+    const auto times = WaypointTimes();
+    const auto pieces = geometry_.Pieces();
+    std::vector<MotionCommand> commands;
+    for (std::size_t k = 1; k < times.size(); ++k) {
+      const double s = k < pieces.size() ? pieces[k].t0 : geometry_.Duration();
+      TrajectoryPoint p;
+      Compose(s, std::sqrt(XAt(s)), 0.0, p);
+      auto m = MotionCommand::CreateCommand(p.position, (times[k] - times[k - 1]) * (1.0 + margin) + slack_s);
+      m.joint_velocities = p.velocity;
+      commands.push_back(m);
+    }
+    if (commands.empty()) commands.push_back(MotionCommand::CreateCommand(geometry_.At(0.0).position, slack_s));
+    return RobotCommand::CreateCommands(commands, Duration() * (1.0 + margin) + slack_s * commands.size());
+  }
+
+private:
+  static constexpr double kTinyDerivative = 1e-12;
+  static constexpr double kMaxX = 1e12;   ///< Bound on sdot^2 where no limit applies.
+  static constexpr int kBisections = 60;
+
+  /**
+   * @brief Joint state at path parameter @p s with path speed @p sd and path acceleration @p sdd.
+   */
+  void Compose(double s, double sd, double sdd, TrajectoryPoint& out) const noexcept
+  {
+    TrajectoryPoint g;
+    geometry_.At(s, g);
+    out.position = g.position;
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      out.velocity[j] = g.velocity[j] * sd;
+      out.acceleration[j] = g.velocity[j] * sdd + g.acceleration[j] * sd * sd;
+    }
+  }
+
+  /**
+   * @brief sdot^2 at @p s; linear in s within a grid interval (constant sddot).
+   */
+  [[nodiscard]] double XAt(double s) const noexcept
+  {
+    if (x_.size() < 2) return 0.0;
+    const std::size_t i = std::min(static_cast<std::size_t>(std::max(s, 0.0) / ds_), x_.size() - 2);
+    const double r = std::clamp(s / ds_ - static_cast<double>(i), 0.0, 1.0);
+    return x_[i] + (x_[i + 1] - x_[i]) * r;
+  }
+
+  /**
+   * @brief Time at which the path parameter reaches @p s.
+   */
+  [[nodiscard]] double TimeAt(double s) const noexcept
+  {
+    if (x_.size() < 2) return 0.0;
+    const std::size_t i = std::min(static_cast<std::size_t>(std::max(s, 0.0) / ds_), x_.size() - 2);
+    const double r = std::max(0.0, s - static_cast<double>(i) * ds_);
+    // s - s_i = sqrt(x_i) tau + u tau^2 / 2, in the form that stays exact for u -> 0.
+    const double speed = std::sqrt(x_[i]) + std::sqrt(std::max(0.0, XAt(s)));
+    return t_[i] + (speed > 0.0 ? 2.0 * r / speed : 0.0);
+  }
+
+  PiecewiseTrajectory geometry_;
+  double ds_{0.0};
+  std::vector<double> x_;   ///< sdot^2 on the grid s_i = i * ds_.
+  std::vector<double> t_;   ///< Time at s_i.
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                           RobotCommand Helpers
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Plan the time-optimal traversal of the MotionCommand joint targets of @p cmd.
+ */
+[[nodiscard]] inline TimeOptimalPath PlanTimeOptimal(const RobotCommand& cmd, const BlendLimits<JOINT_NUM>& limits,
+                                                     std::size_t grid = TimeOptimalPath::kDefaultGridSize)
+{
+  const auto joints = cmd.getJointPositionsVec();
+  return TimeOptimalPath::Plan(joints, limits, grid);
+}
+
+/**
+ * @brief Lazily sample a time-optimal path every @p period seconds.
+ *
+ * Each MotionCommand carries the position and the feed-forward joint velocity;
+ * its timeout is @p period. The last sample is the final waypoint at rest.
+ */
+[[nodiscard]] inline WaypointSource SampleTimeOptimal(std::shared_ptr<const TimeOptimalPath> path, double period)
+{
+  const std::size_t samples = static_cast<std::size_t>(std::ceil(path->Duration() / period));
+  return [path, period, samples, i = std::size_t{0}]() mutable -> std::optional<MotionCommand> {
+    if (i > samples) return std::nullopt;
+    const auto p = path->At(std::min(static_cast<double>(i++) * period, path->Duration()));
+    auto m = MotionCommand::CreateCommand(p.position, period);
+    m.joint_velocities = p.velocity;
+    return m;
+  };
+}
+
+}  // namespace wisson_SDK::control
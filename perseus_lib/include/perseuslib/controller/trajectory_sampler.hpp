@@ -0,0 +1,448 @@
+/**
+ * @file trajectory_sampler.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Offline time parameterization of waypoint lists and fast dense sampling.
+ *
+ * PiecewiseTrajectory turns the waypoints of a RobotCommand into a trajectory that
+ * starts and ends at rest and is synchronized across joints (all joints of a
+ * segment start and arrive together):
+ *  - kTrapezoidal : stop at every waypoint, linear segments with parabolic ramps
+ *  - kQuintic     : stop at every waypoint, minimum-jerk quintic (zero velocity and
+ *                   acceleration at both ends)
+ *  - kCubicSpline : pass every via point at speed, C2 cubic spline with zero end
+ *                   velocities, time-scaled onto the limits
+ *
+ * Every profile is stored as the same table of polynomial pieces (degree <= 5) with
+ * the joints as the inner dimension, so At() / Sample() evaluate position, velocity
+ * and acceleration with one Horner chain per two joints (simd_utils.hpp). Batches
+ * of ascending times locate their piece with a moving cursor instead of a search.
+ * Meant for dense path preview, collision checking and streaming (SampleTrajectory
+ * with TrajectoryStream).
+ *
+ * This header contains:
+ *  - SegmentProfile, TrajectoryPiece and PiecewiseTrajectory
+ *  - PlanTrajectory for RobotCommand inputs
+ *  - SampleTrajectory producing MotionCommands
+ *
+ * @example:
+ *   auto traj = PlanTrajectory(*cmd, SegmentProfile::kQuintic, limits);
+ *   std::vector<TrajectoryPoint> preview(1000);
+ *   traj.SampleUniform(0.0, traj.Duration() / 999, preview);
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "perseuslib/common/simd_utils.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+#include "online_trajectory.hpp"
+#include "robot_command.hpp"
+#include "trajectory_stream.hpp"
+#include "waypoint_blend.hpp"
+
+
+namespace wisson_SDK::control {
+
+enum class SegmentProfile : uint8_t
+{
+  kTrapezoidal,
+  kQuintic,
+  kCubicSpline,
+};
+
+/**
+ * @brief Joints rounded up to whole Double2 lanes.
+ */
+inline constexpr std::size_t kTrajectoryLanes = (JOINT_NUM + 1) / 2 * 2;
+
+/**
+ * @brief One polynomial piece: q_j(t) = sum_k coeff[k][j] * (t - t0)^k on [t0, t0 + duration].
+ *
+ * Padding lanes (j >= JOINT_NUM) are zero.
+ */
+struct TrajectoryPiece
+{
+  double t0{0.0};
+  double duration{0.0};
+  std::array<std::array<double, kTrajectoryLanes>, 6> coeff{};
+};
+
+
+// -----------------------------------------------------------------------------------
+//                             PiecewiseTrajectory
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Time-parameterized joint trajectory through waypoints.
+ *
+ * Built once by Plan(); the evaluation functions are const, allocation-free and may
+ * be called from any thread.
+ */
+class PiecewiseTrajectory
+{
+public:
+  PiecewiseTrajectory() = default;
+
+  /**
+   * @brief Plan a trajectory through @p waypoints; consecutive duplicates are merged.
+   * @throw InvalidOperationException on empty waypoints or non-positive limits.
+   */
+  static PiecewiseTrajectory Plan(std::span<const JointVector> waypoints, SegmentProfile profile,
+                                  const BlendLimits<JOINT_NUM>& limits)
+  {
+    if (waypoints.empty()) {
+      throw wisson_SDK::InvalidOperationException("libperseus-PiecewiseTrajectory: no waypoints.");
+    }
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      if (!(limits.max_velocity[j] > 0.0) || !(limits.max_acceleration[j] > 0.0)) {
+        throw wisson_SDK::InvalidOperationException("libperseus-PiecewiseTrajectory: limits must be positive.");
+      }
+    }
+
+    std::vector<JointVector> points;
+    for (const auto& w : waypoints) {
+      if (points.empty() || points.back() != w) points.push_back(w);
+    }
+
+    PiecewiseTrajectory traj;
+    traj.profile_ = profile;
+    traj.waypoint_count_ = points.size();
+    if (points.size() == 1) {
+      traj.AddPiece(0.0).coeff[0] = Pad(points[0]);
+    } else if (profile == SegmentProfile::kCubicSpline) {
+      traj.PlanCubicSpline(points, limits);
+    } else {
+      for (std::size_t k = 0; k + 1 < points.size(); ++k) {
+        if (profile == SegmentProfile::kTrapezoidal) traj.AddTrapezoid(points[k], points[k + 1], limits);
+        else traj.AddQuintic(points[k], points[k + 1], limits);
+      }
+    }
+    traj.duration_ = traj.pieces_.back().t0 + traj.pieces_.back().duration;
+    return traj;
+  }
+
+  /**
+   * @brief Total execution time [s], from rest at the first waypoint to rest at the last.
+   */
+  [[nodiscard]] double Duration() const noexcept { return duration_; }
+
+  [[nodiscard]] std::size_t WaypointCount() const noexcept { return waypoint_count_; }
+
+  [[nodiscard]] SegmentProfile Profile() const noexcept { return profile_; }
+
+  /**
+   * @brief The polynomial pieces, ordered by t0 (e.g. for analytic collision checks).
+   */
+  [[nodiscard]] std::span<const TrajectoryPiece> Pieces() const noexcept { return pieces_; }
+
+  /**
+   * @brief Position, velocity and acceleration at time @p t (clamped to [0, Duration()]).
+   */
+  void At(double t, TrajectoryPoint& out) const noexcept
+  {
+    if (pieces_.empty()) {
+      out = {};
+      return;
+    }
+    t = std::clamp(t, 0.0, duration_);
+    Evaluate(pieces_[Locate(t)], t, out);
+  }
+
+  [[nodiscard]] TrajectoryPoint At(double t) const noexcept
+  {
+    TrajectoryPoint p;
+    At(t, p);
+    return p;
+  }
+
+  /**
+   * @brief Evaluate at @p times into @p out (sizes must match; the shorter one wins).
+   *
+   * Ascending times cost no search; any order is correct.
+   */
+  void Sample(std::span<const double> times, std::span<TrajectoryPoint> out) const noexcept
+  {
+    const std::size_t n = std::min(times.size(), out.size());
+    if (pieces_.empty()) {
+      std::fill_n(out.begin(), n, TrajectoryPoint{});
+      return;
+    }
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      const double t = std::clamp(times[i], 0.0, duration_);
+      k = Advance(k, t);
+      Evaluate(pieces_[k], t, out[i]);
+    }
+  }
+
+  /**
+   * @brief Evaluate at t_begin + i * period for every element of @p out.
+   */
+  void SampleUniform(double t_begin, double period, std::span<TrajectoryPoint> out) const noexcept
+  {
+    if (pieces_.empty()) {
+      std::fill(out.begin(), out.end(), TrajectoryPoint{});
+      return;
+    }
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      const double t = std::clamp(t_begin + static_cast<double>(i) * period, 0.0, duration_);
+      k = Advance(k, t);
+      Evaluate(pieces_[k], t, out[i]);
+    }
+  }
+
+private:
+  using Lanes = std::array<double, kTrajectoryLanes>;
+
+  [[nodiscard]] static Lanes Pad(const JointVector& v) noexcept
+  {
+    Lanes l{};
+    std::copy(v.begin(), v.end(), l.begin());
+    return l;
+  }
+
+  TrajectoryPiece& AddPiece(double duration)
+  {
+    TrajectoryPiece& p = pieces_.emplace_back();
+    p.t0 = end_;
+    p.duration = duration;
+    end_ += duration;
+    return p;
+  }
+
+  /**
+   * @brief Rest-to-rest trapezoid; every joint uses the ramp fraction of the slowest one.
+   */
+  void AddTrapezoid(const JointVector& from, const JointVector& to, const BlendLimits<JOINT_NUM>& limits)
+  {
+    // Slowest joint alone, then the shortest duration with its ramp fraction that fits every joint.
+    double t_slow = 0.0, alpha = 0.5;
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      const double d = std::abs(to[j] - from[j]), V = limits.max_velocity[j], A = limits.max_acceleration[j];
+      const double ta = d * A >= V * V ? V / A : std::sqrt(d / A);
+      const double t = d * A >= V * V ? d / V + V / A : 2.0 * ta;
+      if (t > t_slow) {
+        t_slow = t;
+        alpha = ta / t;
+      }
+    }
+    double T = 0.0;
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      const double d = std::abs(to[j] - from[j]);
+      T = std::max({T, d / (limits.max_velocity[j] * (1.0 - alpha)),
+                    std::sqrt(d / (limits.max_acceleration[j] * alpha * (1.0 - alpha)))});
+    }
+    const double ta = alpha * T;
+
+    Lanes v{}, a{};
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      v[j] = (to[j] - from[j]) / (T - ta);
+      a[j] = v[j] / ta;
+    }
+    TrajectoryPiece& up = AddPiece(ta);
+    up.coeff[0] = Pad(from);
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) up.coeff[2][j] = 0.5 * a[j];
+    if (T - 2.0 * ta > 0.0) {
+      TrajectoryPiece& cruise = AddPiece(T - 2.0 * ta);
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) cruise.coeff[0][j] = from[j] + 0.5 * v[j] * ta;
+      cruise.coeff[1] = v;
+    }
+    TrajectoryPiece& down = AddPiece(ta);
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      down.coeff[0][j] = to[j] - 0.5 * v[j] * ta;
+      down.coeff[2][j] = -0.5 * a[j];
+    }
+    down.coeff[1] = v;
+  }
+
+  /**
+   * @brief Rest-to-rest minimum-jerk quintic: peak velocity 15/8 d/T, peak acceleration 10/sqrt(3) d/T^2.
+   */
+  void AddQuintic(const JointVector& from, const JointVector& to, const BlendLimits<JOINT_NUM>& limits)
+  {
+    double T = 0.0;
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      const double d = std::abs(to[j] - from[j]);
+      T = std::max({T, 1.875 * d / limits.max_velocity[j], std::sqrt(10.0 / std::sqrt(3.0) * d / limits.max_acceleration[j])});
+    }
+    TrajectoryPiece& p = AddPiece(T);
+    p.coeff[0] = Pad(from);
+    for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+      const double d = to[j] - from[j];
+      p.coeff[3][j] = 10.0 * d / (T * T * T);
+      p.coeff[4][j] = -15.0 * d / (T * T * T * T);
+      p.coeff[5][j] = 6.0 * d / (T * T * T * T * T);
+    }
+  }
+
+  /**
+   * @brief Clamped C2 cubic spline; segment durations start at the rest-to-rest cubic
+   *        times and are scaled uniformly until the tightest limit is met exactly.
+   */
+  void PlanCubicSpline(const std::vector<JointVector>& points, const BlendLimits<JOINT_NUM>& limits)
+  {
+    const std::size_t segments = points.size() - 1;
+    std::vector<double> h(segments, 0.0);
+    for (std::size_t k = 0; k < segments; ++k) {
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+        const double d = std::abs(points[k + 1][j] - points[k][j]);
+        h[k] = std::max({h[k], 1.5 * d / limits.max_velocity[j], std::sqrt(6.0 * d / limits.max_acceleration[j])});
+      }
+    }
+
+    // Knot velocities per joint: C2 continuity gives a tridiagonal system (Thomas algorithm).
+    std::vector<JointVector> vel(points.size(), JointVector{});
+    std::vector<double> diag(points.size()), rhs(points.size());
+    auto solve = [&] {
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+        for (std::size_t i = 1; i < segments; ++i) {
+          diag[i] = 2.0 * (h[i - 1] + h[i]);
+          rhs[i] = 3.0 * (h[i] * (points[i][j] - points[i - 1][j]) / h[i - 1] +
+                          h[i - 1] * (points[i + 1][j] - points[i][j]) / h[i]);
+          if (i > 1) {
+            const double m = h[i] / diag[i - 1];
+            diag[i] -= m * h[i - 2];
+            rhs[i] -= m * rhs[i - 1];
+          }
+        }
+        vel[0][j] = vel[segments][j] = 0.0;
+        for (std::size_t i = segments - 1; i >= 1; --i) {
+          const double next = i + 1 < segments ? vel[i + 1][j] : 0.0;
+          vel[i][j] = (rhs[i] - h[i - 1] * next) / diag[i];
+        }
+      }
+    };
+
+    // Peak |v| / V and |a| / A over the spline; time scaling by f divides them by f and f^2.
+    solve();
+    double ratio = 0.0;
+    for (std::size_t k = 0; k < segments; ++k) {
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+        const auto c = Hermite(points[k][j], points[k + 1][j], vel[k][j], vel[k + 1][j], h[k]);
+        double v_peak = std::max(std::abs(vel[k][j]), std::abs(vel[k + 1][j]));
+        if (c[3] != 0.0) {
+          const double s = -c[2] / (3.0 * c[3]);
+          if (s > 0.0 && s < h[k]) v_peak = std::max(v_peak, std::abs(c[1] + s * (2.0 * c[2] + 3.0 * c[3] * s)));
+        }
+        const double a_peak = std::max(std::abs(2.0 * c[2]), std::abs(2.0 * c[2] + 6.0 * c[3] * h[k]));
+        ratio = std::max({ratio, v_peak / limits.max_velocity[j], std::sqrt(a_peak / limits.max_acceleration[j])});
+      }
+    }
+    for (double& hk : h) hk *= ratio;
+    solve();
+
+    for (std::size_t k = 0; k < segments; ++k) {
+      TrajectoryPiece& p = AddPiece(h[k]);
+      for (std::size_t j = 0; j < JOINT_NUM; ++j) {
+        const auto c = Hermite(points[k][j], points[k + 1][j], vel[k][j], vel[k + 1][j], h[k]);
+        for (std::size_t i = 0; i < 4; ++i) p.coeff[i][j] = c[i];
+      }
+    }
+  }
+
+  [[nodiscard]] static std::array<double, 4> Hermite(double p0, double p1, double v0, double v1, double h) noexcept
+  {
+    const double slope = (p1 - p0) / h;
+    return {p0, v0, (3.0 * slope - 2.0 * v0 - v1) / h, (v0 + v1 - 2.0 * slope) / (h * h)};
+  }
+
+  /**
+   * @brief Index of the last piece with t0 <= t.
+   */
+  [[nodiscard]] std::size_t Locate(double t) const noexcept
+  {
+    auto it = std::upper_bound(pieces_.begin(), pieces_.end(), t,
+                               [](double value, const TrajectoryPiece& p) { return value < p.t0; });
+    return it == pieces_.begin() ? 0 : static_cast<std::size_t>(std::prev(it) - pieces_.begin());
+  }
+
+  /**
+   * @brief Locate() starting from piece @p k; constant time for ascending times.
+   */
+  [[nodiscard]] std::size_t Advance(std::size_t k, double t) const noexcept
+  {
+    if (t < pieces_[k].t0) return Locate(t);
+    while (k + 1 < pieces_.size() && t >= pieces_[k + 1].t0) ++k;
+    return k;
+  }
+
+  static void Evaluate(const TrajectoryPiece& piece, double t, TrajectoryPoint& out) noexcept
+  {
+    using namespace math::simd;
+    const Double2 s = Splat2(t - piece.t0);
+    const auto& c = piece.coeff;
+    for (std::size_t g = 0; g < kTrajectoryLanes; g += 2) {
+      const Double2 c0 = Load2(&c[0][g]), c1 = Load2(&c[1][g]), c2 = Load2(&c[2][g]);
+      const Double2 c3 = Load2(&c[3][g]), c4 = Load2(&c[4][g]), c5 = Load2(&c[5][g]);
+      const Double2 q = ((((c5 * s + c4) * s + c3) * s + c2) * s + c1) * s + c0;
+      const Double2 v = (((Splat2(5.0) * c5 * s + Splat2(4.0) * c4) * s + Splat2(3.0) * c3) * s + Splat2(2.0) * c2) * s + c1;
+      const Double2 a = ((Splat2(20.0) * c5 * s + Splat2(12.0) * c4) * s + Splat2(6.0) * c3) * s + Splat2(2.0) * c2;
+      if (g + 2 <= JOINT_NUM) {
+        Store2(&out.position[g], q);
+        Store2(&out.velocity[g], v);
+        Store2(&out.acceleration[g], a);
+      } else {
+        out.position[g] = q[0];
+        out.velocity[g] = v[0];
+        out.acceleration[g] = a[0];
+      }
+    }
+  }
+
+  std::vector<TrajectoryPiece> pieces_;
+  double end_{0.0};
+  double duration_{0.0};
+  std::size_t waypoint_count_{0};
+  SegmentProfile profile_{SegmentProfile::kTrapezoidal};
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                           RobotCommand Helpers
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Plan a trajectory through the MotionCommand joint targets of @p cmd.
+ */
+[[nodiscard]] inline PiecewiseTrajectory PlanTrajectory(const RobotCommand& cmd, SegmentProfile profile,
+                                                        const BlendLimits<JOINT_NUM>& limits)
+{
+  const auto joints = cmd.getJointPositionsVec();
+  return PiecewiseTrajectory::Plan(joints, profile, limits);
+}
+
+/**
+ * @brief Lazily sample a trajectory every @p period seconds.
+ *
+ * Each MotionCommand carries the position and the feed-forward joint velocity;
+ * its timeout is @p period. The last sample is the final waypoint at rest.
+ */
+[[nodiscard]] inline WaypointSource SampleTrajectory(std::shared_ptr<const PiecewiseTrajectory> traj, double period)
+{
+  const std::size_t samples = static_cast<std::size_t>(std::ceil(traj->Duration() / period));
+  return [traj, period, samples, i = std::size_t{0}]() mutable -> std::optional<MotionCommand> {
+    if (i > samples) return std::nullopt;
+    const auto p = traj->At(std::min(static_cast<double>(i++) * period, traj->Duration()));
+    auto m = MotionCommand::CreateCommand(p.position, period);
+    m.joint_velocities = p.velocity;
+    return m;
+  };
+}
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,322 @@
+/**
+ * @file trajectory_stream.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Windowed streaming of trajectories longer than cmd_list_size.
+ *
+ * A RobotCommand holds at most cmd_list_size waypoints. TrajectoryStream pulls
+ * waypoints lazily from a source, packs them into chunks and keeps at most
+ * `window` unreached waypoints on the server. Every kSubSuccess (waypoint
+ * reached) returns one credit, so the next chunk is on the server long before
+ * the current one runs out and execution continues across chunk boundaries
+ * (requires CapabilityFlag::kTrajStreaming). Client memory is bounded by the
+ * window, independent of the path length.
+ *
+ * @example:
+ *   TrajectoryStream stream(send_chunk);           // io thread: stream.OnResponse(id, status)
+ *   ResponseStatus st = stream.Run(WaypointsFrom(taught_path));
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <json/json.h>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "controller.h"
+#include "robot_command.hpp"
+
+
+namespace wisson_SDK::control {
+
+// -----------------------------------------------------------------------------------
+//                                Constants
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Waypoints per chunk (one RobotCommand).
+ */
+inline constexpr std::size_t kDefaultStreamChunk = cmd_list_size / 2;
+
+/**
+ * @brief Unreached waypoints allowed on the server.
+ */
+inline constexpr std::size_t kDefaultStreamWindow = cmd_list_size * 2;
+
+
+
+// -----------------------------------------------------------------------------------
+//                               Stream Chunks
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Position of a chunk inside its stream; sent along with the chunk.
+ */
+struct StreamChunkInfo
+{
+  uint32_t stream_id{0};  ///< Identifies the stream on the server.
+  uint32_t seq{0};        ///< Chunk number, starting at 0.
+  bool last{false};       ///< No further chunks follow.
+};
+
+namespace detail {
+
+inline constexpr char kStreamIdKey[]   = "StreamId";
+inline constexpr char kStreamSeqKey[]  = "StreamSeq";
+inline constexpr char kStreamLastKey[] = "StreamLast";
+
+} // namespace detail
+
+/**
+ * @brief Add the stream fields to the body of a chunk's command frame.
+ */
+inline void AppendStreamChunkInfo(Json::Value& body, const StreamChunkInfo& info)
+{
+  body[detail::kStreamIdKey] = Json::UInt(info.stream_id);
+  body[detail::kStreamSeqKey] = Json::UInt(info.seq);
+  body[detail::kStreamLastKey] = info.last;
+}
+
+
+/**
+ * @brief Lazily produces the waypoints of a trajectory; std::nullopt at the end.
+ */
+using WaypointSource = std::function<std::optional<MotionCommand>()>;
+
+/**
+ * @brief Source over an existing container. @p path must outlive the stream.
+ */
+[[nodiscard]] inline WaypointSource WaypointsFrom(std::span<const MotionCommand> path)
+{
+  return [path, i = std::size_t{0}]() mutable -> std::optional<MotionCommand> {
+    if (i >= path.size()) return std::nullopt;
+    return path[i++];
+  };
+}
+
+
+/**
+ * @brief Stream counters. Readable from any thread.
+ */
+struct StreamStats
+{
+  std::atomic<uint64_t> chunks_sent{0};
+  std::atomic<uint64_t> waypoints_sent{0};
+  std::atomic<uint64_t> waypoints_reached{0};
+  std::atomic<uint64_t> max_outstanding{0};   ///< Largest number of unreached waypoints sent.
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                             Trajectory Stream
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Sends one trajectory in chunks with credit-based flow control.
+ *
+ * Run() produces and sends chunks on the calling thread and returns once the last
+ * chunk finished or the stream failed. OnResponse() is fed by the io thread; the
+ * sender must not block. It is called without the internal lock held, so it may
+ * deliver OnResponse() synchronously (e.g. a loopback transport).
+ */
+class TrajectoryStream
+{
+public:
+  using Sender = std::function<bool(const RobotCommand& chunk, const StreamChunkInfo& info)>;
+
+  /**
+   * @throw ConstructorException if chunk is 0 or above cmd_list_size, or window < chunk.
+   */
+  explicit TrajectoryStream(Sender sender, std::size_t chunk = kDefaultStreamChunk,
+                            std::size_t window = kDefaultStreamWindow)
+    : sender_(std::move(sender)), chunk_(chunk), window_(window)
+  {
+    if (!sender_ || chunk_ == 0 || chunk_ > cmd_list_size || window_ < chunk_) {
+      throw wisson_SDK::ConstructorException("libperseus-TrajectoryStream: invalid sender, chunk or window size.");
+    }
+  }
+
+  TrajectoryStream(const TrajectoryStream&) = delete;
+  TrajectoryStream& operator=(const TrajectoryStream&) = delete;
+
+  /**
+   * @brief Stream all waypoints of @p source and wait for completion.
+   * @return kSuccess, the failure status reported by the server, kUserStop after
+   *         Cancel(), or kFail if a chunk could not be sent.
+   * @throw InvalidOperationException if the stream is already running. Exceptions
+   *        thrown by @p source propagate; the stream can be run again afterwards.
+   */
+  ResponseStatus Run(WaypointSource source)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (running_) {
+        throw wisson_SDK::InvalidOperationException("libperseus-TrajectoryStream: stream already running.");
+      }
+      running_ = true;
+      done_ = false;
+      result_ = ResponseStatus::kSuccess;
+      credits_ = window_;
+      chunks_.clear();
+    }
+    // Re-arms the stream however Run() exits, including when source() throws.
+    struct RunGuard
+    {
+      TrajectoryStream& self;
+      ~RunGuard()
+      {
+        std::lock_guard<std::mutex> lock(self.mutex_);
+        self.done_ = true;
+        self.running_ = false;
+        self.chunks_.clear();
+      }
+    } guard{*this};
+
+    StreamChunkInfo info{.stream_id = Controller::GenerateCommandId()};
+    std::vector<MotionCommand> waypoints;
+    waypoints.reserve(chunk_);
+    std::optional<MotionCommand> next = source();
+
+    while (next) {
+      waypoints.clear();
+      double timeout = 0.0;
+      while (waypoints.size() < chunk_ && next) {
+        timeout += next->timeout;
+        waypoints.push_back(*next);
+        next = source();
+      }
+      info.last = !next.has_value();
+
+      auto cmd = RobotCommand::CreateCommands(waypoints, timeout);
+      cmd->cmd_id = Controller::GenerateCommandId();
+
+      uint64_t outstanding = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return done_ || credits_ >= waypoints.size(); });
+        if (done_) break;
+        // Registered before sending: the first response may arrive before sender_ returns.
+        credits_ -= waypoints.size();
+        chunks_.push_back({cmd, waypoints.size(), 0, info.last});
+        outstanding = window_ - credits_;
+      }
+      if (!sender_(*cmd, info)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!done_) Finish(ResponseStatus::kFail);
+        break;
+      }
+      ++info.seq;
+      stats_.chunks_sent.fetch_add(1, std::memory_order_relaxed);
+      stats_.waypoints_sent.fetch_add(waypoints.size(), std::memory_order_relaxed);
+      if (outstanding > stats_.max_outstanding.load(std::memory_order_relaxed)) {
+        stats_.max_outstanding.store(outstanding, std::memory_order_relaxed);
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (info.seq == 0 && !done_) Finish(ResponseStatus::kSuccess);  // empty trajectory
+    cv_.wait(lock, [this] { return done_; });
+    return result_;
+  }
+
+  /**
+   * @brief Feed a command response received from the server.
+   * @return false if @p cmd_id does not belong to this stream.
+   */
+  bool OnResponse(uint32_t cmd_id, ResponseStatus status)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(chunks_.begin(), chunks_.end(),
+                           [cmd_id](const Chunk& c) { return c.cmd->cmd_id == cmd_id; });
+    if (it == chunks_.end()) return false;
+
+    if (status == ResponseStatus::kSubSuccess) {
+      if (it->reached < it->size) {
+        it->cmd->Advance();
+        ++it->reached;
+        ++credits_;
+        stats_.waypoints_reached.fetch_add(1, std::memory_order_relaxed);
+        cv_.notify_all();
+      }
+      return true;
+    }
+    if (!detail::IsActionFinished(status)) return true;
+
+    it->cmd->status = status;
+    it->cmd->finished = true;
+    if (status != ResponseStatus::kSuccess) {
+      Finish(status);
+      return true;
+    }
+    // Waypoints not acknowledged individually are released with the chunk.
+    credits_ += it->size - it->reached;
+    stats_.waypoints_reached.fetch_add(it->size - it->reached, std::memory_order_relaxed);
+    const bool last = it->last;
+    chunks_.erase(it);
+    if (last) Finish(ResponseStatus::kSuccess);
+    cv_.notify_all();
+    return true;
+  }
+
+  /**
+   * @brief Stop feeding the server; Run() returns kUserStop.
+   *
+   * Chunks already sent are not recalled; stopping the robot is up to the caller.
+   */
+  void Cancel()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ && !done_) Finish(ResponseStatus::kUserStop);
+  }
+
+  [[nodiscard]] const StreamStats& Stats() const noexcept { return stats_; }
+
+private:
+  struct Chunk
+  {
+    std::shared_ptr<RobotCommand> cmd;
+    std::size_t size{0};
+    std::size_t reached{0};
+    bool last{false};
+  };
+
+  void Finish(ResponseStatus status)
+  {
+    done_ = true;
+    result_ = status;
+    cv_.notify_all();
+  }
+
+private:
+  Sender sender_;
+  const std::size_t chunk_;
+  const std::size_t window_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Chunk> chunks_;   ///< Sent, unfinished chunks; bounded through the credits.
+  std::size_t credits_{0};
+  bool running_{false};
+  bool done_{false};
+  ResponseStatus result_{ResponseStatus::kIdle};
+
+  StreamStats stats_;
+};
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,415 @@
+/**
+ * @file waypoint_blend.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Blended waypoint paths: via points are passed at speed instead of at rest.
+ *
+ * A multi-waypoint RobotCommand stops at every via point. BlendedPath plans the
+ * same waypoints as straight segments joined by parabolic blends (linear segments
+ * with parabolic blends, LSPB). Every via point has a blend radius: the largest
+ * per-axis distance from the via point at which the blend may start. Radius 0
+ * keeps an exact stop. Segment speeds are lowered where the velocity / acceleration
+ * limits, a radius or a short segment require it.
+ *
+ * The plan is executed either client-side, by sampling it into dense MotionCommands
+ * carrying position and feed-forward velocity (stream them with TrajectoryStream),
+ * or server-side, by sending the radii with the original command (AppendBlendRadii,
+ * requires CapabilityFlag::kWaypointBlending).
+ *
+ * This header contains:
+ *  - BlendLimits and the BlendedPath<N> planner (joint space N = JOINT_NUM,
+ *    Cartesian translation N = 3)
+ *  - PlanJointBlend / PlanCartesianBlend for RobotCommand inputs
+ *  - Samplers producing MotionCommands
+ *
+ * @example:
+ *   auto path = PlanJointBlend(*cmd, std::vector<double>{5.0}, limits);   // 5 deg radius everywhere
+ *   TrajectoryStream(send_chunk).Run(SampleJointBlend(path, 0.01));
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <json/json.h>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "robot_command.hpp"
+#include "trajectory_stream.hpp"
+
+
+namespace wisson_SDK::control {
+
+/**
+ * @brief Per-axis kinematic limits used by the blend planner.
+ */
+template <std::size_t N>
+struct BlendLimits
+{
+  std::array<double, N> max_velocity{};       ///< > 0 for every axis.
+  std::array<double, N> max_acceleration{};   ///< > 0 for every axis.
+};
+
+
+// -----------------------------------------------------------------------------------
+//                                BlendedPath
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Time-parameterized path through waypoints with parabolic blends.
+ *
+ * Built once by Plan(); Position() / Velocity() may then be evaluated from any
+ * thread. Segment velocities never exceed max_velocity and blend accelerations
+ * never exceed max_acceleration.
+ */
+template <std::size_t N>
+class BlendedPath
+{
+public:
+  using Vector = std::array<double, N>;
+
+  BlendedPath() = default;
+
+  /**
+   * @brief Plan a path through @p waypoints.
+   * @param waypoints At least one point; consecutive duplicates are merged.
+   * @param radii     Blend radius per waypoint (first and last are ignored), or a
+   *                  single radius for every via point. 0 = exact stop.
+   * @param limits    Per-axis velocity and acceleration limits.
+   * @throw InvalidOperationException on empty waypoints, mismatching radii or non-positive limits.
+   */
+  static BlendedPath Plan(std::span<const Vector> waypoints, std::span<const double> radii,
+                          const BlendLimits<N>& limits)
+  {
+    if (waypoints.empty() || (radii.size() != 1 && radii.size() != waypoints.size())) {
+      throw wisson_SDK::InvalidOperationException("libperseus-BlendedPath: expected one radius, or one per waypoint.");
+    }
+    for (std::size_t j = 0; j < N; ++j) {
+      if (!(limits.max_velocity[j] > 0.0) || !(limits.max_acceleration[j] > 0.0)) {
+        throw wisson_SDK::InvalidOperationException("libperseus-BlendedPath: limits must be positive.");
+      }
+    }
+
+    // Distinct points and their radii.
+    std::vector<Vector> points;
+    std::vector<double> point_radii;
+    for (std::size_t i = 0; i < waypoints.size(); ++i) {
+      if (!points.empty() && points.back() == waypoints[i]) continue;
+      points.push_back(waypoints[i]);
+      point_radii.push_back(std::max(0.0, radii.size() == 1 ? radii[0] : radii[i]));
+    }
+
+    BlendedPath path;
+    path.waypoint_count_ = points.size();
+    const std::size_t segments = points.size() - 1;
+
+    // Fastest synchronized velocity of each segment (the slowest axis sets the duration).
+    std::vector<Vector> v_max(segments);
+    std::vector<double> t_min(segments, 0.0);
+    for (std::size_t k = 0; k < segments; ++k) {
+      for (std::size_t j = 0; j < N; ++j) {
+        t_min[k] = std::max(t_min[k], std::abs(points[k + 1][j] - points[k][j]) / limits.max_velocity[j]);
+      }
+      for (std::size_t j = 0; j < N; ++j) v_max[k][j] = (points[k + 1][j] - points[k][j]) / t_min[k];
+    }
+
+    std::vector<double> scale(segments, 1.0);
+    auto velocity = [&](int seg) {
+      Vector v{};
+      if (seg >= 0) for (std::size_t j = 0; j < N; ++j) v[j] = v_max[seg][j] * scale[seg];
+      return v;
+    };
+    auto blend_time = [&](const Vector& a, const Vector& b) {
+      double tb = 0.0;
+      for (std::size_t j = 0; j < N; ++j) tb = std::max(tb, std::abs(b[j] - a[j]) / limits.max_acceleration[j]);
+      return tb;
+    };
+    auto inf_norm = [](const Vector& v) {
+      double m = 0.0;
+      for (double x : v) m = std::max(m, std::abs(x));
+      return m;
+    };
+
+    // Junctions: the start, every via point (two junctions for an exact stop), the end.
+    // A via point is blended only if that beats stopping: a radius too small for the
+    // corner at full speed slows both adjacent segments along their whole length.
+    struct Slot { std::size_t point; int in; int out; double radius; };   // in / out: segment, -1 = at rest
+    std::vector<Slot> slots;
+    slots.push_back({0, -1, segments > 0 ? 0 : -1, 0.0});
+    for (std::size_t i = 1; i < points.size(); ++i) {
+      const int in = static_cast<int>(i) - 1;
+      const int out = i < segments ? static_cast<int>(i) : -1;
+      bool blend = out >= 0 && point_radii[i] > 0.0;
+      if (blend) {
+        const Vector v_in = velocity(in);
+        const Vector v_out = velocity(out);
+        const double reach = 0.5 * blend_time(v_in, v_out) * std::max(inf_norm(v_in), inf_norm(v_out));
+        const double f = reach > point_radii[i] ? std::sqrt(point_radii[i] / reach) : 1.0;
+        const double blend_cost = (1.0 / f - 1.0) * (t_min[in] + t_min[out]);
+        const double stop_cost = 0.5 * (blend_time(v_in, Vector{}) + blend_time(Vector{}, v_out));
+        blend = blend_cost < stop_cost;
+      }
+      if (blend) {
+        slots.push_back({i, in, out, point_radii[i]});
+      } else {
+        slots.push_back({i, in, -1, 0.0});
+        if (out >= 0) slots.push_back({i, -1, out, 0.0});
+      }
+    }
+
+    // Lower segment speeds until every blend respects its radius and no two blends overlap.
+
+    std::vector<double> tb(slots.size(), 0.0);
+    for (int iteration = 0; iteration < 100; ++iteration) {
+      for (std::size_t s = 0; s < slots.size(); ++s) tb[s] = blend_time(velocity(slots[s].in), velocity(slots[s].out));
+
+      bool changed = false;
+      auto shrink = [&](int seg, double factor) {
+        if (seg >= 0 && factor < 1.0) { scale[seg] *= std::max(factor, 0.5); changed = true; }
+      };
+      for (std::size_t s = 0; s < slots.size(); ++s) {
+        if (slots[s].radius <= 0.0) continue;
+        const double reach = 0.5 * tb[s] * std::max(inf_norm(velocity(slots[s].in)), inf_norm(velocity(slots[s].out)));
+        if (reach > slots[s].radius) {
+          // Both adjacent speeds scaled by f scale the reach by f^2.
+          const double f = std::sqrt(slots[s].radius / reach) * 0.999;
+          shrink(slots[s].in, f);
+          shrink(slots[s].out, f);
+        }
+      }
+      for (std::size_t s = 0; s + 1 < slots.size(); ++s) {
+        const int seg = slots[s].out;
+        if (seg < 0) continue;
+        const double duration = t_min[seg] / scale[seg];
+        const double needed = 0.5 * (tb[s] + tb[s + 1]);
+        if (needed > duration) {
+          const double f = std::sqrt(duration / needed) * 0.999;
+          shrink(slots[s].in, f);
+          shrink(seg, f);
+          shrink(slots[s + 1].out, f);
+        }
+      }
+      if (!changed) break;
+    }
+
+    // Junction times: segment k lasts t_min / scale; stop junctions are spaced by their blends.
+    path.junctions_.reserve(slots.size());
+    double t = tb.empty() ? 0.0 : 0.5 * tb[0];
+    for (std::size_t s = 0; s < slots.size(); ++s) {
+      if (s > 0) {
+        const int seg = slots[s - 1].out;
+        t += seg >= 0 ? t_min[seg] / scale[seg] : 0.5 * (tb[s - 1] + tb[s]);
+      }
+      path.junctions_.push_back({points[slots[s].point], velocity(slots[s].in), velocity(slots[s].out), t, tb[s]});
+    }
+    path.duration_ = path.junctions_.back().t + 0.5 * path.junctions_.back().tb;
+    return path;
+  }
+
+  /**
+   * @brief Total execution time [s], from rest at the first waypoint to rest at the last.
+   */
+  [[nodiscard]] double Duration() const noexcept { return duration_; }
+
+  [[nodiscard]] std::size_t WaypointCount() const noexcept { return waypoint_count_; }
+
+  /**
+   * @brief Position at time @p t (clamped to [0, Duration()]).
+   */
+  [[nodiscard]] Vector Position(double t) const noexcept
+  {
+    Vector q{};
+    if (junctions_.empty()) return q;
+    const Junction& jn = Locate(t);
+    const double dt = std::clamp(t, 0.0, duration_) - jn.t;
+    if (InBlend(jn, dt)) {
+      const double u = dt + 0.5 * jn.tb;
+      for (std::size_t j = 0; j < N; ++j) {
+        q[j] = jn.point[j] + jn.v_in[j] * dt + (jn.v_out[j] - jn.v_in[j]) * u * u / (2.0 * jn.tb);
+      }
+    } else {
+      for (std::size_t j = 0; j < N; ++j) q[j] = jn.point[j] + (dt < 0.0 ? jn.v_in[j] : jn.v_out[j]) * dt;
+    }
+    return q;
+  }
+
+  /**
+   * @brief Velocity at time @p t.
+   */
+  [[nodiscard]] Vector Velocity(double t) const noexcept
+  {
+    Vector v{};
+    if (junctions_.empty() || t <= 0.0 || t >= duration_) return v;
+    const Junction& jn = Locate(t);
+    const double dt = t - jn.t;
+    if (InBlend(jn, dt)) {
+      const double u = dt + 0.5 * jn.tb;
+      for (std::size_t j = 0; j < N; ++j) v[j] = jn.v_in[j] + (jn.v_out[j] - jn.v_in[j]) * u / jn.tb;
+    } else {
+      v = dt < 0.0 ? jn.v_in : jn.v_out;
+    }
+    return v;
+  }
+
+private:
+  struct Junction
+  {
+    Vector point;   ///< Via point the blend rounds off.
+    Vector v_in;    ///< Velocity of the incoming segment (0 at rest).
+    Vector v_out;   ///< Velocity of the outgoing segment (0 at rest).
+    double t;       ///< Time the unblended path would pass the via point.
+    double tb;      ///< Blend duration, centred on t.
+  };
+
+  [[nodiscard]] static bool InBlend(const Junction& jn, double dt) noexcept
+  {
+    return jn.tb > 0.0 && std::abs(dt) <= 0.5 * jn.tb;
+  }
+
+  /**
+   * @brief Junction whose blend or outgoing segment contains @p t.
+   */
+  [[nodiscard]] const Junction& Locate(double t) const noexcept
+  {
+    auto it = std::upper_bound(junctions_.begin(), junctions_.end(), t,
+                               [](double value, const Junction& jn) { return value < jn.t - 0.5 * jn.tb; });
+    return it == junctions_.begin() ? junctions_.front() : *std::prev(it);
+  }
+
+private:
+  std::vector<Junction> junctions_;
+  double duration_{0.0};
+  std::size_t waypoint_count_{0};
+};
+
+using JointBlendedPath = BlendedPath<JOINT_NUM>;
+using CartesianBlendedPath = BlendedPath<3>;
+
+
+
+// -----------------------------------------------------------------------------------
+//                           RobotCommand Helpers
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Plan a joint-space blend through the MotionCommand targets of @p cmd.
+ */
+[[nodiscard]] inline JointBlendedPath PlanJointBlend(const RobotCommand& cmd, std::span<const double> radii,
+                                                     const BlendLimits<JOINT_NUM>& limits)
+{
+  const auto joints = cmd.getJointPositionsVec();
+  return JointBlendedPath::Plan(joints, radii, limits);
+}
+
+/**
+ * @brief Plan a Cartesian blend through the end-effector positions of @p cmd.
+ *
+ * Only the translation is blended; all waypoints must share the orientation of
+ * the first one.
+ * @throw InvalidOperationException if the orientations differ.
+ */
+[[nodiscard]] inline CartesianBlendedPath PlanCartesianBlend(const RobotCommand& cmd, std::span<const double> radii,
+                                                             const BlendLimits<3>& limits)
+{
+  std::vector<std::array<double, 3>> points;
+  const MotionCommand* first = nullptr;
+  for (const auto& c : cmd.commands) {
+    const auto* m = std::get_if<MotionCommand>(&c);
+    if (m == nullptr) continue;
+    if (first == nullptr) first = m;
+    for (std::size_t i : {0, 1, 2, 4, 5, 6, 8, 9, 10}) {
+      if (std::abs(m->ee_transform[i] - first->ee_transform[i]) > 1e-9) {
+        throw wisson_SDK::InvalidOperationException(
+          "libperseus-BlendedPath: Cartesian blending requires a constant orientation.");
+      }
+    }
+    points.push_back({m->ee_transform[3], m->ee_transform[7], m->ee_transform[11]});
+  }
+  return CartesianBlendedPath::Plan(points, radii, limits);
+}
+
+
+/**
+ * @brief Lazily sample a joint blend every @p period seconds.
+ *
+ * Each MotionCommand carries the position and the feed-forward joint velocity;
+ * its timeout is @p period. The last sample is the final waypoint at rest.
+ */
+[[nodiscard]] inline WaypointSource SampleJointBlend(std::shared_ptr<const JointBlendedPath> path, double period)
+{
+  const std::size_t samples = static_cast<std::size_t>(std::ceil(path->Duration() / period));
+  return [path, period, samples, i = std::size_t{0}]() mutable -> std::optional<MotionCommand> {
+    if (i > samples) return std::nullopt;
+    const double t = std::min(static_cast<double>(i++) * period, path->Duration());
+    auto m = MotionCommand::CreateCommand(path->Position(t), period);
+    m.joint_velocities = path->Velocity(t);
+    return m;
+  };
+}
+
+[[nodiscard]] inline WaypointSource SampleJointBlend(JointBlendedPath path, double period)
+{
+  return SampleJointBlend(std::make_shared<const JointBlendedPath>(std::move(path)), period);
+}
+
+/**
+ * @brief Lazily sample a Cartesian blend every @p period seconds.
+ *
+ * @p orientation supplies the rotation part of every ee_transform (row-major 4x4);
+ * ee_velocity carries the linear feed-forward velocity.
+ */
+[[nodiscard]] inline WaypointSource SampleCartesianBlend(std::shared_ptr<const CartesianBlendedPath> path,
+                                                         const std::array<double, 16>& orientation, double period)
+{
+  const std::size_t samples = static_cast<std::size_t>(std::ceil(path->Duration() / period));
+  return [path, orientation, period, samples, i = std::size_t{0}]() mutable -> std::optional<MotionCommand> {
+    if (i > samples) return std::nullopt;
+    const double t = std::min(static_cast<double>(i++) * period, path->Duration());
+    const auto p = path->Position(t);
+    const auto v = path->Velocity(t);
+    auto m = MotionCommand::CreateCommand({}, period);
+    m.ee_transform = orientation;
+    m.ee_transform[3] = p[0];
+    m.ee_transform[7] = p[1];
+    m.ee_transform[11] = p[2];
+    m.ee_velocity = {v[0], v[1], v[2], 0.0, 0.0, 0.0};
+    return m;
+  };
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                          Server-side Blending
+// -----------------------------------------------------------------------------------
+namespace detail {
+
+inline constexpr char kBlendRadiiKey[] = "BlendRadii";
+
+} // namespace detail
+
+/**
+ * @brief Add per-waypoint blend radii to the body of a command frame.
+ *
+ * Only for servers that advertise CapabilityFlag::kWaypointBlending; older servers
+ * ignore the field and stop at every via point.
+ */
+inline void AppendBlendRadii(Json::Value& body, std::span<const double> radii)
+{
+  Json::Value list(Json::arrayValue);
+  for (double r : radii) list.append(r);
+  body[detail::kBlendRadiiKey] = std::move(list);
+}
+
+}  // namespace wisson_SDK::control
@@ -0,0 +1,312 @@
+/**
+ * @file capabilities.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Capability bitmasks exchanged during the SDK handshake.
+ *
+ * This header contains:
+ *  - CapabilityFlag enum and Capabilities struct
+ *  - NegotiatedCapabilities and NegotiateCapabilities()
+ *  - JSON helpers to append / parse capabilities on the handshake frames
+ *
+ * Both sides advertise what they support; the fastest mutually supported option
+ * is picked. Servers that predate the handshake extension (no capability fields
+ * in their test answer, or a version below kMinCapabilityServerVersion) are
+ * treated as legacy JSON-only servers.
+ *
+ * Not wired into the shipped transport yet: its handshake neither sends nor parses
+ * these fields, and PerseusRobot does not expose a negotiated result. The helpers
+ * are the building block for a transport that does.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <algorithm>
+
+#include <json/json.h>
+
+#include "perseuslib/controller/robot_command.hpp"
+
+
+namespace wisson_SDK::network {
+
+// -----------------------------------------------------------------------------------
+//                                Constants
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief First server version that answers the handshake with capability fields.
+ *
+ * Uses the PERSEUSSDK_TO_VERSION encoding (major * 10000 + minor * 100 + patch).
+ */
+inline constexpr uint32_t kMinCapabilityServerVersion = 10100;
+
+/**
+ * @brief Frame and waypoint limits assumed for legacy servers.
+ */
+inline constexpr uint32_t kLegacyMaxFrameSize = 4096;
+inline constexpr uint32_t kLegacyMaxWaypoints = static_cast<uint32_t>(control::cmd_list_size);
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Capability Flags
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Individual capability bits. Values are part of the wire protocol.
+ */
+enum class CapabilityFlag : uint32_t
+{
+  kJsonCodec        = 1u << 0,  ///< JSON frame bodies (always supported).
+  kBinaryCodec      = 1u << 1,  ///< Compact binary frame bodies.
+  kStateDelta       = 1u << 4,  ///< Keyframe + delta encoded state stream.
+  kCmdPipelining    = 1u << 5,  ///< Server queues a RobotCommand received while one executes.
+  kTrajStreaming    = 1u << 6,  ///< Server appends stream chunks without stopping in between.
+  kDirectModes      = 1u << 7,  ///< Compact velocity / torque / impedance command and setpoint frames.
+  kFieldSubset      = 1u << 8,  ///< Field-subset / rate-controlled state subscription.
+  kWaypointBlending = 1u << 9,  ///< Server blends via points using per-waypoint radii.
+  kConcurrentCmds   = 1u << 10, ///< Commands on disjoint resources execute concurrently.
+  kPriorityStop     = 1u << 11, ///< Stop frames preempt running commands and are acknowledged.
+  kSyncStart        = 1u << 12, ///< Staged commands, clock probes and timed start triggers.
+  kSealedFrames     = 1u << 13, ///< Command frames carrying a sequence number and CRC-32.
+  kMixedSequences   = 1u << 14, ///< Sequence frames with a controller mode per step, chained by the server.
+};
+
+[[nodiscard]] inline constexpr uint32_t operator|(CapabilityFlag a, CapabilityFlag b) noexcept
+  { return static_cast<uint32_t>(a) | static_cast<uint32_t>(b); }
+[[nodiscard]] inline constexpr uint32_t operator|(uint32_t a, CapabilityFlag b) noexcept
+  { return a | static_cast<uint32_t>(b); }
+
+
+/**
+ * @brief Codecs that can be negotiated for frame bodies.
+ */
+enum class FrameCodec : uint8_t
+{
+  kJson,    ///< Legacy JSON bodies.
+  kBinary   ///< Compact binary bodies.
+};
+
+
+/**
+ * @brief Encodings that can be negotiated for the state stream.
+ */
+enum class StateEncoding : uint8_t
+{
+  kFull,    ///< Every frame carries every field.
+  kDelta    ///< Periodic keyframes and compact deltas.
+};
+
+
+/**
+ * @brief Capabilities advertised by one side of the connection.
+ */
+struct Capabilities
+{
+  uint32_t flags{static_cast<uint32_t>(CapabilityFlag::kJsonCodec)};
+  uint32_t max_frame_size{kLegacyMaxFrameSize};   ///< Largest accepted frame [bytes].
+  uint32_t max_waypoints{kLegacyMaxWaypoints};    ///< Largest accepted RobotCommand list.
+
+  [[nodiscard]] constexpr bool Has(CapabilityFlag f) const noexcept
+    { return (flags & static_cast<uint32_t>(f)) != 0; }
+
+  constexpr bool operator==(const Capabilities&) const = default;
+
+  /**
+   * @brief Capabilities of a server that predates the handshake extension.
+   */
+  [[nodiscard]] static constexpr Capabilities Legacy() noexcept { return {}; }
+};
+
+
+/**
+ * @brief Capabilities implemented by the transport of this SDK build.
+ *
+ * Only what the shipped TcpClient can actually send and decode is advertised.
+ * The remaining flags describe frames that this SDK can build (e.g. the state
+ * delta codec or sequence frames) but that the prebuilt transport does not carry
+ * yet; they are added here once it does.
+ */
+[[nodiscard]] inline constexpr Capabilities ClientCapabilities() noexcept
+{
+  return Capabilities{
+    .flags = static_cast<uint32_t>(CapabilityFlag::kJsonCodec),
+    .max_frame_size = kLegacyMaxFrameSize,
+    .max_waypoints = kLegacyMaxWaypoints,
+  };
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                               Negotiation
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Result of the handshake: the options both sides agreed on.
+ */
+struct NegotiatedCapabilities
+{
+  Capabilities common{};                            ///< Intersection of both sides.
+  FrameCodec codec{FrameCodec::kJson};              ///< Selected frame body codec.
+  StateEncoding state_encoding{StateEncoding::kFull}; ///< Selected state stream encoding.
+  bool field_subset{false};                         ///< Field-subset subscriptions usable.
+  bool cmd_pipelining{false};                       ///< Next command may be sent ahead.
+  bool traj_streaming{false};                       ///< Trajectories may be streamed in chunks.
+  bool direct_modes{false};                         ///< Velocity/torque/impedance frames usable.
+  bool waypoint_blending{false};                    ///< Blend radii honoured by the server.
+  bool concurrent_cmds{false};                      ///< Several commands may be in flight.
+  bool priority_stop{false};                        ///< Stop() preempts and is acknowledged.
+  bool sync_start{false};                           ///< Barrier-synchronized starts usable.
+  bool sealed_frames{false};                        ///< Sealed (CompiledCommand) frames usable.
+  bool mixed_sequences{false};                      ///< Mixed-mode sequence frames usable.
+  bool legacy_server{true};                         ///< Server did not take part in negotiation.
+
+  [[nodiscard]] constexpr uint32_t MaxFrameSize() const noexcept { return common.max_frame_size; }
+  [[nodiscard]] constexpr uint32_t MaxWaypoints() const noexcept { return common.max_waypoints; }
+};
+
+
+/**
+ * @brief Choose the fastest mutually supported options.
+ *
+ * @param local          Capabilities of this client.
+ * @param server_version Version reported by the server.
+ * @param remote         Capabilities parsed from the server answer, if any.
+ * @return Negotiated options; legacy JSON-only defaults for old servers.
+ */
+[[nodiscard]] inline constexpr NegotiatedCapabilities NegotiateCapabilities(
+    const Capabilities& local, uint32_t server_version,
+    const std::optional<Capabilities>& remote = std::nullopt) noexcept
+{
+  NegotiatedCapabilities result{};
+  if (!remote.has_value() || server_version < kMinCapabilityServerVersion) {
+    result.common = Capabilities::Legacy();
+    return result;
+  }
+
+  result.legacy_server = false;
+  result.common.flags = (local.flags & remote->flags) | static_cast<uint32_t>(CapabilityFlag::kJsonCodec);
+  result.common.max_frame_size = std::min(local.max_frame_size, remote->max_frame_size);
+  result.common.max_waypoints = std::min(local.max_waypoints, remote->max_waypoints);
+
+  result.codec = result.common.Has(CapabilityFlag::kBinaryCodec) ? FrameCodec::kBinary : FrameCodec::kJson;
+  result.state_encoding = result.common.Has(CapabilityFlag::kStateDelta) ? StateEncoding::kDelta : StateEncoding::kFull;
+  result.field_subset = result.common.Has(CapabilityFlag::kFieldSubset);
+  result.cmd_pipelining = result.common.Has(CapabilityFlag::kCmdPipelining);
+  result.traj_streaming = result.common.Has(CapabilityFlag::kTrajStreaming);
+  result.direct_modes = result.common.Has(CapabilityFlag::kDirectModes);
+  result.waypoint_blending = result.common.Has(CapabilityFlag::kWaypointBlending);
+  result.concurrent_cmds = result.common.Has(CapabilityFlag::kConcurrentCmds);
+  result.priority_stop = result.common.Has(CapabilityFlag::kPriorityStop);
+  result.sync_start = result.common.Has(CapabilityFlag::kSyncStart);
+  result.sealed_frames = result.common.Has(CapabilityFlag::kSealedFrames);
+  result.mixed_sequences = result.common.Has(CapabilityFlag::kMixedSequences);
+  return result;
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                            Handshake JSON Fields
+// -----------------------------------------------------------------------------------
+namespace detail {
+
+inline constexpr char kCapFlagsKey[]        = "CapFlags";
+inline constexpr char kCapMaxFrameSizeKey[] = "CapMaxFrameSize";
+inline constexpr char kCapMaxWaypointsKey[] = "CapMaxWaypoints";
+
+} // namespace detail
+
+/**
+ * @brief Add the capability fields to an outgoing handshake (test) frame body.
+ */
+inline void AppendCapabilities(Json::Value& body, const Capabilities& caps)
+{
+  body[detail::kCapFlagsKey] = Json::UInt(caps.flags);
+  body[detail::kCapMaxFrameSizeKey] = Json::UInt(caps.max_frame_size);
+  body[detail::kCapMaxWaypointsKey] = Json::UInt(caps.max_waypoints);
+}
+
+/**
+ * @brief Read the capability fields from a handshake answer.
+ * @return Capabilities, or std::nullopt if the server did not send them.
+ */
+[[nodiscard]] inline std::optional<Capabilities> ParseCapabilities(const Json::Value& body)
+{
+  if (!body.isObject() || !body.isMember(detail::kCapFlagsKey) || !body[detail::kCapFlagsKey].isUInt()) {
+    return std::nullopt;
+  }
+
+  Capabilities caps{};
+  caps.flags = body[detail::kCapFlagsKey].asUInt();
+  if (body.isMember(detail::kCapMaxFrameSizeKey) && body[detail::kCapMaxFrameSizeKey].isUInt()) {
+    caps.max_frame_size = body[detail::kCapMaxFrameSizeKey].asUInt();
+  }
+  if (body.isMember(detail::kCapMaxWaypointsKey) && body[detail::kCapMaxWaypointsKey].isUInt()) {
+    caps.max_waypoints = body[detail::kCapMaxWaypointsKey].asUInt();
+  }
+  return caps;
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                                   Utils
+// -----------------------------------------------------------------------------------
+namespace detail {
+
+[[nodiscard]] inline constexpr std::string_view FrameCodecToString(FrameCodec codec) noexcept
+{
+  switch (codec)
+  {
+    case FrameCodec::kJson:   return "Json";
+    case FrameCodec::kBinary: return "Binary";
+    default:                  return "Unknown";
+  }
+}
+
+[[nodiscard]] inline constexpr std::string_view StateEncodingToString(StateEncoding enc) noexcept
+{
+  switch (enc)
+  {
+    case StateEncoding::kFull:  return "Full";
+    case StateEncoding::kDelta: return "Delta";
+    default:                    return "Unknown";
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Human-readable summary for logging.
+ */
+[[nodiscard]] inline std::string CapabilitiesToString(const NegotiatedCapabilities& caps)
+{
+  return std::string("Codec = [") + std::string(detail::FrameCodecToString(caps.codec)) +
+         "], State = [" + std::string(detail::StateEncodingToString(caps.state_encoding)) +
+         "], FieldSubset = [" + (caps.field_subset ? "on" : "off") +
+         "], Pipelining = [" + (caps.cmd_pipelining ? "on" : "off") +
+         "], Streaming = [" + (caps.traj_streaming ? "on" : "off") +
+         "], DirectModes = [" + (caps.direct_modes ? "on" : "off") +
+         "], Blending = [" + (caps.waypoint_blending ? "on" : "off") +
+         "], Concurrent = [" + (caps.concurrent_cmds ? "on" : "off") +
+         "], PriorityStop = [" + (caps.priority_stop ? "on" : "off") +
+         "], SyncStart = [" + (caps.sync_start ? "on" : "off") +
+         "], Sealed = [" + (caps.sealed_frames ? "on" : "off") +
+         "], Mixed = [" + (caps.mixed_sequences ? "on" : "off") +
+         "], MaxFrame = [" + std::to_string(caps.MaxFrameSize()) +
+         "B], MaxWaypoints = [" + std::to_string(caps.MaxWaypoints()) +
+         "]" + (caps.legacy_server ? " (legacy server)" : "");
+}
+
+}  // namespace wisson_SDK::network
@@ -0,0 +1,282 @@
+/**
+ * @file command_frame.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Compact binary frames for joint position, velocity, torque and impedance commands.
+ *
+ * Command frame (little-endian):
+ *
+ *   u8   kind            SetpointKind of the mode (P / V / T / I)
+ *   u8   space           control::ControlSpace
+ *   u16  count           number of entries (<= cmd_list_size)
+ *   u32  cmd_id
+ *   f64  total_timeout   [s]
+ *   f64  stiffness[JOINT_NUM], damping[JOINT_NUM]      kImpedance only
+ *   count x { f64 values[JOINT_NUM]; f64 timeout }
+ *
+ * Response frame: u8 'R', u8[3] reserved, u32 cmd_id, u32 status (ResponseStatus), u32 index.
+ *
+ * Stop frame: u8 'S', u8[3] reserved, u32 stop_id, u32 resources (bitmask of
+ * control::CommandResource). The server preempts every command on those resources
+ * and answers with a response frame {stop_id, kUserStop}. Sent on the priority
+ * lane when the server advertises CapabilityFlag::kPriorityStop.
+ *
+ * The kind byte selects which command field travels: MotionCommand::joint_positions
+ * (position, impedance), MotionCommand::joint_velocities (velocity) or
+ * TorqueCommand::desired_torque (torque). Used when the server advertises
+ * CapabilityFlag::kDirectModes.
+ *
+ * @example:
+ *   std::vector<uint8_t> frame;
+ *   EncodeCommandFrame(*cmd, ControllerMode::JointTorque(), frame);
+ *   ...
+ *   if (auto r = DecodeCommandResponse(data, size)) ApplyCommandResponse(*cmd, *r);
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "perseuslib/controller/controller.h"
+#include "perseuslib/network/setpoint_frame.hpp"
+
+
+namespace wisson_SDK::network {
+
+/**
+ * @brief Per-joint gains sent with impedance commands.
+ */
+struct ImpedanceGains
+{
+  std::array<double, JOINT_NUM> stiffness{};   ///< [Nm/deg] (joint 0: [N/m]).
+  std::array<double, JOINT_NUM> damping{};     ///< [Nms/deg] (joint 0: [Ns/m]).
+};
+
+
+inline constexpr std::size_t kCommandHeaderSize = 1 + 1 + 2 + 4 + 8;
+inline constexpr std::size_t kCommandGainsSize = 2 * JOINT_NUM * sizeof(double);
+inline constexpr std::size_t kCommandEntrySize = (JOINT_NUM + 1) * sizeof(double);
+inline constexpr std::size_t kCommandResponseSize = 16;
+inline constexpr std::size_t kStopFrameSize = 12;
+inline constexpr uint8_t kResponseFrameTag = 'R';
+inline constexpr uint8_t kStopFrameTag = 'S';
+
+
+/**
+ * @brief Encoded size of a command frame of @p kind with @p count entries.
+ */
+[[nodiscard]] inline constexpr std::size_t CommandFrameSize(SetpointKind kind, std::size_t count) noexcept
+{
+  return kCommandHeaderSize + (kind == SetpointKind::kImpedance ? kCommandGainsSize : 0) + count * kCommandEntrySize;
+}
+
+
+// -----------------------------------------------------------------------------------
+//                                Command Frame
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Encode @p cmd for @p mode into @p out (resized; reuse it to avoid reallocation).
+ * @param gains Required for impedance mode, ignored otherwise.
+ * @throw CommandException if the mode has no compact frame, is not joint-space, or an entry does not fit the mode.
+ */
+inline void EncodeCommandFrame(const control::RobotCommand& cmd, const control::ControllerMode& mode,
+                               std::vector<uint8_t>& out, const ImpedanceGains* gains = nullptr)
+{
+  const auto kind = SetpointKindFor(mode.type);
+  if (!kind.has_value()) {
+    throw wisson_SDK::CommandException("libperseus-CommandFrame: mode " + mode.ModeToString() +
+                                       " has no compact command frame.");
+  }
+  if (mode.space != control::ControlSpace::kJoint) {
+    throw wisson_SDK::CommandException("libperseus-CommandFrame: mode " + mode.ModeToString() +
+                                       " is not a joint-space mode; only joint values travel in a command frame.");
+  }
+  if (!control::detail::IsCommandSupported(mode, cmd) || cmd.commands.size() > control::cmd_list_size) {
+    throw wisson_SDK::CommandException("libperseus-CommandFrame: command " + std::to_string(cmd.cmd_id) +
+                                       " does not match mode " + mode.ModeToString() + ".");
+  }
+  if (*kind == SetpointKind::kImpedance && gains == nullptr) {
+    throw wisson_SDK::CommandException("libperseus-CommandFrame: impedance commands require gains.");
+  }
+
+  const auto count = static_cast<uint16_t>(cmd.commands.size());
+  out.resize(CommandFrameSize(*kind, count));
+  uint8_t* p = out.data();
+  p[0] = static_cast<uint8_t>(*kind);
+  p[1] = static_cast<uint8_t>(mode.space);
+  std::memcpy(p + 2, &count, sizeof(count));
+  std::memcpy(p + 4, &cmd.cmd_id, sizeof(cmd.cmd_id));
+  std::memcpy(p + 8, &cmd.total_timeout, sizeof(cmd.total_timeout));
+  p += kCommandHeaderSize;
+
+  if (*kind == SetpointKind::kImpedance) {
+    std::memcpy(p, gains->stiffness.data(), sizeof(gains->stiffness));
+    std::memcpy(p + sizeof(gains->stiffness), gains->damping.data(), sizeof(gains->damping));
+    p += kCommandGainsSize;
+  }
+
+  for (const auto& entry : cmd.commands) {
+    const std::array<double, JOINT_NUM>* values = nullptr;
+    double timeout = 0.0;
+    if (const auto* m = std::get_if<control::MotionCommand>(&entry)) {
+      values = (*kind == SetpointKind::kVelocity) ? &m->joint_velocities : &m->joint_positions;
+      timeout = m->timeout;
+    } else if (const auto* t = std::get_if<control::TorqueCommand>(&entry)) {
+      values = &t->desired_torque;
+      timeout = t->timeout;
+    }
+    std::memcpy(p, values->data(), sizeof(*values));
+    std::memcpy(p + sizeof(*values), &timeout, sizeof(timeout));
+    p += kCommandEntrySize;
+  }
+}
+
+
+/**
+ * @brief Fields of a decoded command frame.
+ */
+struct DecodedCommandFrame
+{
+  SetpointKind kind{SetpointKind::kPosition};
+  control::ControlSpace space{control::ControlSpace::kUnknown};
+  uint32_t cmd_id{0};
+  double total_timeout{0.0};
+  ImpedanceGains gains{};                                  ///< kImpedance only.
+  std::vector<std::array<double, JOINT_NUM>> values;
+  std::vector<double> timeouts;
+};
+
+/**
+ * @brief Decode a command frame.
+ * @return std::nullopt if the frame is truncated or of an unknown kind.
+ */
+[[nodiscard]] inline std::optional<DecodedCommandFrame> DecodeCommandFrame(const uint8_t* data, std::size_t size)
+{
+  if (data == nullptr || size < kCommandHeaderSize) return std::nullopt;
+  DecodedCommandFrame d;
+  d.kind = static_cast<SetpointKind>(data[0]);
+  if (SetpointFrameSize(d.kind) == 0) return std::nullopt;
+  uint16_t count = 0;
+  std::memcpy(&count, data + 2, sizeof(count));
+  if (count > control::cmd_list_size || size < CommandFrameSize(d.kind, count)) return std::nullopt;
+
+  d.space = static_cast<control::ControlSpace>(data[1]);
+  std::memcpy(&d.cmd_id, data + 4, sizeof(d.cmd_id));
+  std::memcpy(&d.total_timeout, data + 8, sizeof(d.total_timeout));
+  const uint8_t* p = data + kCommandHeaderSize;
+  if (d.kind == SetpointKind::kImpedance) {
+    std::memcpy(d.gains.stiffness.data(), p, sizeof(d.gains.stiffness));
+    std::memcpy(d.gains.damping.data(), p + sizeof(d.gains.stiffness), sizeof(d.gains.damping));
+    p += kCommandGainsSize;
+  }
+  d.values.resize(count);
+  d.timeouts.resize(count);
+  for (std::size_t i = 0; i < count; ++i, p += kCommandEntrySize) {
+    std::memcpy(d.values[i].data(), p, sizeof(d.values[i]));
+    std::memcpy(&d.timeouts[i], p + sizeof(d.values[i]), sizeof(double));
+  }
+  return d;
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                               Response Frame
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Progress report for a compact command.
+ */
+struct CommandResponse
+{
+  uint32_t cmd_id{0};
+  control::ResponseStatus status{control::ResponseStatus::kUnknown};
+  uint32_t index{0};    ///< Entry the status refers to.
+};
+
+inline void EncodeCommandResponse(const CommandResponse& r, std::array<uint8_t, kCommandResponseSize>& out) noexcept
+{
+  const uint32_t words[3] = {r.cmd_id, static_cast<uint32_t>(r.status), r.index};
+  out.fill(0);
+  out[0] = kResponseFrameTag;
+  std::memcpy(out.data() + 4, words, sizeof(words));
+}
+
+/**
+ * @brief Decode a response frame; unknown status codes map to ResponseStatus::kUnknown.
+ * @return std::nullopt if the frame is truncated or not a response frame.
+ */
+[[nodiscard]] inline std::optional<CommandResponse> DecodeCommandResponse(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size < kCommandResponseSize || data[0] != kResponseFrameTag) return std::nullopt;
+  uint32_t words[3];
+  std::memcpy(words, data + 4, sizeof(words));
+  return CommandResponse{words[0], control::detail::ToResponseStatus(words[1]), words[2]};
+}
+
+/**
+ * @brief Apply a response to the command it belongs to.
+ * @return true if the response completed the command.
+ */
+inline bool ApplyCommandResponse(control::RobotCommand& cmd, const CommandResponse& r) noexcept
+{
+  if (r.cmd_id != cmd.cmd_id || cmd.finished.load()) return false;
+  if (r.status == control::ResponseStatus::kSubSuccess) {
+    cmd.Advance();
+    return false;
+  }
+  cmd.status = r.status;
+  if (!control::detail::IsActionFinished(r.status)) return false;
+  cmd.finished.store(true);
+  return true;
+}
+
+
+
+
+// -----------------------------------------------------------------------------------
+//                                 Stop Frame
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Request to preempt every command on a set of resources.
+ */
+struct StopRequest
+{
+  uint32_t stop_id{0};     ///< Echoed as cmd_id in the acknowledgement.
+  uint32_t resources{0};   ///< control::ResourceMask.
+};
+
+inline void EncodeStopFrame(const StopRequest& r, std::array<uint8_t, kStopFrameSize>& out) noexcept
+{
+  out.fill(0);
+  out[0] = kStopFrameTag;
+  std::memcpy(out.data() + 4, &r.stop_id, sizeof(r.stop_id));
+  std::memcpy(out.data() + 8, &r.resources, sizeof(r.resources));
+}
+
+/**
+ * @return std::nullopt if the frame is truncated or not a stop frame.
+ */
+[[nodiscard]] inline std::optional<StopRequest> DecodeStopFrame(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size < kStopFrameSize || data[0] != kStopFrameTag) return std::nullopt;
+  StopRequest r;
+  std::memcpy(&r.stop_id, data + 4, sizeof(r.stop_id));
+  std::memcpy(&r.resources, data + 8, sizeof(r.resources));
+  return r;
+}
+
+}  // namespace wisson_SDK::network
@@ -0,0 +1,206 @@
+/**
+ * @file compiled_command.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Sealed command frames and commands encoded once for repeated sending.
+ *
+ * Sealed command frame (little-endian):
+ *
+ *   u8   'Q'        tag
+ *   u8[3]           reserved
+ *   u32  crc        CRC-32 of everything after this field
+ *   u32  seq        per-connection frame counter
+ *   ...             command frame (see command_frame.hpp)
+ *
+ * The server drops frames whose CRC does not match and detects lost or replayed
+ * frames by seq. Used when the server advertises CapabilityFlag::kSealedFrames.
+ *
+ * CompiledCommand encodes and seals a RobotCommand once. CRC-32 is linear, so the
+ * CRC of the frame with a new cmd_id and seq is the CRC of the compiled frame
+ * XOR the contribution of each changed bit; those are tabulated per nibble at
+ * compile time. Re-sending costs 16 table lookups, independent of the number of
+ * waypoints, plus one copy of the frame when stamped into a send buffer.
+ *
+ * @example:
+ *   CompiledCommand cycle(*cmd, ControllerMode::JointPosition());    // once
+ *   ...
+ *   auto frame = cycle.Stamp(Controller::GenerateCommandId(), ++seq);  // every cycle
+ *   queue.Submit(frame.data(), frame.size());
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "perseuslib/common/crc32.hpp"
+#include "perseuslib/network/command_frame.hpp"
+#include "perseuslib/network/send_queue.hpp"
+
+
+namespace wisson_SDK::network {
+
+inline constexpr uint8_t kSealedFrameTag = 'Q';
+inline constexpr std::size_t kSealedHeaderSize = 12;
+inline constexpr std::size_t kSealedCrcOffset = 4;
+inline constexpr std::size_t kSealedSeqOffset = 8;
+inline constexpr std::size_t kSealedCmdIdOffset = kSealedHeaderSize + 4;   ///< cmd_id inside the command frame.
+
+
+// -----------------------------------------------------------------------------------
+//                                Sealed Frame
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Wrap an encoded command frame into a sealed frame with sequence number @p seq.
+ * @param out Resized; reuse it to avoid reallocation.
+ */
+inline void SealCommandFrame(uint32_t seq, const std::vector<uint8_t>& command_frame, std::vector<uint8_t>& out)
+{
+  const std::size_t size = kSealedHeaderSize + command_frame.size();
+  out.resize(size);
+  uint8_t* p = out.data();
+  p[0] = kSealedFrameTag;
+  p[1] = p[2] = p[3] = 0;
+  std::memcpy(p + kSealedSeqOffset, &seq, sizeof(seq));
+  std::copy(command_frame.begin(), command_frame.end(), p + kSealedHeaderSize);
+  const uint32_t crc = Crc32(p + kSealedSeqOffset, size - kSealedSeqOffset);
+  std::memcpy(p + kSealedCrcOffset, &crc, sizeof(crc));
+}
+
+struct SealedFrameView
+{
+  uint32_t seq{0};
+  const uint8_t* command{nullptr};   ///< Embedded command frame.
+  std::size_t command_size{0};
+};
+
+/**
+ * @brief Check and unwrap a sealed frame.
+ * @return std::nullopt if the frame is not a sealed frame or its CRC does not match.
+ */
+[[nodiscard]] inline std::optional<SealedFrameView> DecodeSealedFrame(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size <= kSealedHeaderSize || data[0] != kSealedFrameTag) return std::nullopt;
+  uint32_t crc = 0;
+  std::memcpy(&crc, data + kSealedCrcOffset, sizeof(crc));
+  if (crc != Crc32(data + kSealedSeqOffset, size - kSealedSeqOffset)) return std::nullopt;
+  SealedFrameView v;
+  std::memcpy(&v.seq, data + kSealedSeqOffset, sizeof(v.seq));
+  v.command = data + kSealedHeaderSize;
+  v.command_size = size - kSealedHeaderSize;
+  return v;
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Compiled Command
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief A RobotCommand encoded and sealed once, re-sent with a fresh cmd_id and seq.
+ *
+ * The compiled frame is a snapshot: later changes to the RobotCommand are not
+ * picked up. Stamp() patches the object's own frame and is meant for one sending
+ * thread; StampInto() leaves the object untouched and may be called concurrently.
+ */
+class CompiledCommand
+{
+public:
+  /**
+   * @throw CommandException if @p cmd has no compact frame for @p mode.
+   */
+  CompiledCommand(const control::RobotCommand& cmd, const control::ControllerMode& mode,
+                  const ImpedanceGains* gains = nullptr)
+  {
+    std::vector<uint8_t> command_frame;
+    EncodeCommandFrame(cmd, mode, command_frame, gains);
+    const uint32_t zero = 0;
+    std::memcpy(command_frame.data() + 4, &zero, sizeof(zero));
+    SealCommandFrame(0, command_frame, frame_);
+    std::memcpy(&base_crc_, frame_.data() + kSealedCrcOffset, sizeof(base_crc_));
+    BuildPatchTables();
+  }
+
+  /**
+   * @brief Patch @p cmd_id and @p seq into the compiled frame.
+   * @return The sealed frame, valid until the next Stamp().
+   */
+  std::span<const uint8_t> Stamp(uint32_t cmd_id, uint32_t seq) noexcept
+  {
+    Patch(frame_.data(), cmd_id, seq);
+    return frame_;
+  }
+
+  /**
+   * @brief Copy the frame into @p buf and patch @p cmd_id and @p seq there.
+   * @return false if the frame does not fit into @p buf.
+   */
+  bool StampInto(FrameBuffer& buf, uint32_t cmd_id, uint32_t seq) const noexcept
+  {
+    if (!buf.Assign(frame_.data(), frame_.size())) return false;
+    Patch(buf.data, cmd_id, seq);
+    return true;
+  }
+
+  [[nodiscard]] std::size_t Size() const noexcept { return frame_.size(); }
+
+private:
+  /// Nibble n of seq is nibble n of the table index; nibbles 8..15 are cmd_id.
+  static constexpr std::size_t kNibbles = 16;
+
+  /**
+   * @brief CRC contribution of every value of every nibble of seq and cmd_id.
+   *
+   * For equal-length messages crc(a ^ d) = crc(a) ^ crc(d) ^ crc(0), so flipping
+   * bits d changes the CRC by crc(d) ^ crc(0), and contributions of separate bits
+   * combine by XOR.
+   */
+  void BuildPatchTables()
+  {
+    std::vector<uint8_t> probe(frame_.size() - kSealedSeqOffset, 0);
+    const uint32_t crc_zero = Crc32(probe.data(), probe.size());
+    std::array<uint32_t, 4 * kNibbles> bit_crc{};
+    for (std::size_t b = 0; b < bit_crc.size(); ++b) {
+      const std::size_t offset = (b < 32 ? 0 : kSealedCmdIdOffset - kSealedSeqOffset) + (b % 32) / 8;
+      probe[offset] = static_cast<uint8_t>(1u << (b % 8));
+      bit_crc[b] = Crc32(probe.data(), probe.size()) ^ crc_zero;
+      probe[offset] = 0;
+    }
+    for (std::size_t n = 0; n < kNibbles; ++n) {
+      for (uint32_t v = 1; v < 16; ++v) {
+        const uint32_t low = v & (0u - v);   // lowest set bit
+        patch_[n][v] = patch_[n][v ^ low] ^ bit_crc[4 * n + static_cast<std::size_t>(__builtin_ctz(low))];
+      }
+    }
+  }
+
+  void Patch(uint8_t* frame, uint32_t cmd_id, uint32_t seq) const noexcept
+  {
+    uint32_t crc = base_crc_;
+    for (std::size_t n = 0; n < 8; ++n) {
+      crc ^= patch_[n][(seq >> (4 * n)) & 0xFu] ^ patch_[8 + n][(cmd_id >> (4 * n)) & 0xFu];
+    }
+    std::memcpy(frame + kSealedSeqOffset, &seq, sizeof(seq));
+    std::memcpy(frame + kSealedCmdIdOffset, &cmd_id, sizeof(cmd_id));
+    std::memcpy(frame + kSealedCrcOffset, &crc, sizeof(crc));
+  }
+
+private:
+  std::vector<uint8_t> frame_;
+  uint32_t base_crc_{0};
+  std::array<std::array<uint32_t, 16>, kNibbles> patch_{};
+};
+
+}  // namespace wisson_SDK::network
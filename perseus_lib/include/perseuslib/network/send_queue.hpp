@@ -0,0 +1,304 @@
+/**
+ * @file send_queue.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Mutex-free submission path from user threads into the TcpClient io thread.
+ *
+ * This header contains:
+ *  - FrameBuffer     : pre-sized, pooled byte buffer carrying one protocol frame
+ *  - FrameBufferPool : fixed set of FrameBuffers recycled without allocation
+ *  - SendQueue       : MPSC hand-off of FrameBuffers with a single wakeup per batch,
+ *                      plus a priority lane that overtakes queued frames
+ *
+ * Typical flow:
+ *   user thread : buf = queue.Acquire(); encode into buf->data; queue.Submit(buf);
+ *   stop path   : queue.SubmitUrgent(stop_frame, size);
+ *   io thread   : woken once by the wakeup handler, calls queue.Drain(write_fn).
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "perseuslib/common/mpsc_queue.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+
+
+namespace wisson_SDK::network {
+
+// -----------------------------------------------------------------------------------
+//                                Constants
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Default number of in-flight frames per SendQueue.
+ */
+inline constexpr std::size_t kDefaultFramePoolSize = 64;
+
+/**
+ * @brief Default capacity of one frame buffer in bytes.
+ */
+inline constexpr std::size_t kDefaultFrameCapacity = 4096;
+
+/**
+ * @brief Frames reserved for the priority lane, so it never starves behind a full pool.
+ */
+inline constexpr std::size_t kUrgentFramePoolSize = 4;
+
+
+
+// -----------------------------------------------------------------------------------
+//                               Frame Buffer
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief One encoded protocol frame. Storage is owned by FrameBufferPool.
+ */
+struct FrameBuffer : MpscNode
+{
+  uint8_t* data{nullptr};   ///< Start of the pre-sized storage.
+  std::size_t size{0};      ///< Number of valid bytes.
+  std::size_t capacity{0};  ///< Storage size in bytes.
+  uint32_t slot{0};         ///< Index inside the owning pool.
+
+  /**
+   * @brief Copy bytes into the buffer.
+   * @return false if the payload does not fit.
+   */
+  bool Assign(const uint8_t* src, std::size_t n) noexcept
+  {
+    if (n > capacity) return false;
+    std::memcpy(data, src, n);
+    size = n;
+    return true;
+  }
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                             Frame Buffer Pool
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Fixed-size pool of FrameBuffers backed by one contiguous allocation.
+ *
+ * Acquire() and Release() are lock-free and safe from any thread.
+ */
+class FrameBufferPool
+{
+public:
+  FrameBufferPool(std::size_t pool_size = kDefaultFramePoolSize,
+                  std::size_t frame_capacity = kDefaultFrameCapacity)
+    : frames_(pool_size),
+      storage_(new uint8_t[pool_size * frame_capacity]),
+      free_list_(static_cast<uint32_t>(pool_size))
+  {
+    if (pool_size == 0 || frame_capacity == 0) {
+      throw wisson_SDK::ConstructorException("libperseus-FrameBufferPool: pool size and frame capacity must be non-zero.");
+    }
+    for (std::size_t i = 0; i < pool_size; ++i) {
+      frames_[i].data = storage_.get() + i * frame_capacity;
+      frames_[i].capacity = frame_capacity;
+      frames_[i].slot = static_cast<uint32_t>(i);
+    }
+  }
+
+  FrameBufferPool(const FrameBufferPool&) = delete;
+  FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+  /**
+   * @brief Take an empty buffer.
+   * @return Buffer, or nullptr if all buffers are in flight.
+   */
+  FrameBuffer* Acquire() noexcept
+  {
+    const uint32_t slot = free_list_.Acquire();
+    if (slot == IndexFreeList::kInvalid) return nullptr;
+    FrameBuffer* buf = &frames_[slot];
+    buf->size = 0;
+    return buf;
+  }
+
+  /**
+   * @brief Give a buffer back to the pool.
+   */
+  void Release(FrameBuffer* buf) noexcept { free_list_.Release(buf->slot); }
+
+  [[nodiscard]] std::size_t Size() const noexcept { return frames_.size(); }
+  [[nodiscard]] std::size_t FrameCapacity() const noexcept { return frames_.front().capacity; }
+
+private:
+  std::vector<FrameBuffer> frames_;
+  std::unique_ptr<uint8_t[]> storage_;
+  IndexFreeList free_list_;
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                                Send Queue
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Lock-free submission queue from user threads into the io thread.
+ *
+ * Producers never take a mutex and never allocate. The wakeup handler (usually a
+ * post() onto the io_context) is invoked only on the first submission after a
+ * drain, so a burst of frames from several threads costs one io wakeup.
+ *
+ * Frames handed to SubmitUrgent() take a separate lane with its own small pool.
+ * Drain() empties that lane before every regular frame, so an urgent frame (e.g. a
+ * stop request) waits for at most the frame currently being written, however many
+ * regular frames are queued.
+ */
+class SendQueue
+{
+public:
+  using WakeupHandler = std::function<void()>;
+
+  SendQueue(std::size_t pool_size = kDefaultFramePoolSize,
+            std::size_t frame_capacity = kDefaultFrameCapacity)
+    : pool_(pool_size, frame_capacity), urgent_pool_(kUrgentFramePoolSize, frame_capacity) {}
+
+  SendQueue(const SendQueue&) = delete;
+  SendQueue& operator=(const SendQueue&) = delete;
+
+  /**
+   * @brief Set the handler that schedules Drain() on the io thread.
+   * @note Must be set before the first Submit().
+   */
+  void SetWakeupHandler(WakeupHandler handler) { wakeup_handler_ = std::move(handler); }
+
+  /**
+   * @brief Take an empty frame buffer to encode into (any thread).
+   * @return Buffer, or nullptr if the pool is exhausted (back-pressure).
+   */
+  FrameBuffer* Acquire() noexcept { return pool_.Acquire(); }
+
+  /**
+   * @brief Return an unused buffer without sending it (any thread).
+   */
+  void Discard(FrameBuffer* buf) noexcept { pool_.Release(buf); }
+
+  /**
+   * @brief Hand a filled buffer to the io thread (any thread).
+   */
+  void Submit(FrameBuffer* buf) noexcept
+  {
+    queue_.Push(buf);
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    if (!wakeup_pending_.exchange(true, std::memory_order_acq_rel)) {
+      wakeups_.fetch_add(1, std::memory_order_relaxed);
+      if (wakeup_handler_) wakeup_handler_();
+    }
+  }
+
+  /**
+   * @brief Copy a raw frame into a pooled buffer and submit it (any thread).
+   * @return false if the pool is exhausted or the frame is larger than a buffer.
+   */
+  bool Submit(const uint8_t* data, std::size_t size) noexcept
+  {
+    FrameBuffer* buf = pool_.Acquire();
+    if (buf == nullptr) return false;
+    if (!buf->Assign(data, size)) {
+      pool_.Release(buf);
+      return false;
+    }
+    Submit(buf);
+    return true;
+  }
+
+  /**
+   * @brief Copy a raw frame into the priority lane (any thread).
+   *
+   * Does not compete with regular frames for pool buffers.
+   * @return false if kUrgentFramePoolSize urgent frames are already pending, or the
+   *         frame is larger than a buffer.
+   */
+  bool SubmitUrgent(const uint8_t* data, std::size_t size) noexcept
+  {
+    FrameBuffer* buf = urgent_pool_.Acquire();
+    if (buf == nullptr) return false;
+    if (!buf->Assign(data, size)) {
+      urgent_pool_.Release(buf);
+      return false;
+    }
+    urgent_.Push(buf);
+    urgent_submitted_.fetch_add(1, std::memory_order_relaxed);
+    if (!wakeup_pending_.exchange(true, std::memory_order_acq_rel)) {
+      wakeups_.fetch_add(1, std::memory_order_relaxed);
+      if (wakeup_handler_) wakeup_handler_();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Consume every queued frame (io thread only).
+   *
+   * @param write Callable `void(const FrameBuffer&)`, invoked in submission order
+   *              per producer and lane. Urgent frames are written before the next
+   *              regular frame. The buffer is recycled right after it returns.
+   * @return Number of frames written in this batch.
+   */
+  template <typename WriteFn>
+  std::size_t Drain(WriteFn&& write)
+  {
+    // Re-arm before popping so that any later Submit() triggers a new wakeup. An RMW
+    // (not a plain store) so that a producer whose exchange(true) is ordered after
+    // it in the modification order also has its push visible to the Pop() below.
+    wakeup_pending_.exchange(false, std::memory_order_acq_rel);
+
+    std::size_t n = DrainUrgent(write);
+    while (MpscNode* node = queue_.Pop()) {
+      auto* buf = static_cast<FrameBuffer*>(node);
+      write(static_cast<const FrameBuffer&>(*buf));
+      pool_.Release(buf);
+      n += 1 + DrainUrgent(write);
+    }
+    return n;
+  }
+
+  [[nodiscard]] uint64_t SubmittedCount() const noexcept { return submitted_.load(std::memory_order_relaxed); }
+  [[nodiscard]] uint64_t UrgentCount() const noexcept { return urgent_submitted_.load(std::memory_order_relaxed); }
+  [[nodiscard]] uint64_t WakeupCount() const noexcept { return wakeups_.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::size_t FrameCapacity() const noexcept { return pool_.FrameCapacity(); }
+
+private:
+  template <typename WriteFn>
+  std::size_t DrainUrgent(WriteFn& write)
+  {
+    std::size_t n = 0;
+    while (MpscNode* node = urgent_.Pop()) {
+      auto* buf = static_cast<FrameBuffer*>(node);
+      write(static_cast<const FrameBuffer&>(*buf));
+      urgent_pool_.Release(buf);
+      ++n;
+    }
+    return n;
+  }
+
+private:
+  FrameBufferPool pool_;
+  FrameBufferPool urgent_pool_;
+  MpscQueue queue_;
+  MpscQueue urgent_;
+  WakeupHandler wakeup_handler_;
+  alignas(64) std::atomic<bool> wakeup_pending_{false};
+  std::atomic<uint64_t> submitted_{0};
+  std::atomic<uint64_t> urgent_submitted_{0};
+  std::atomic<uint64_t> wakeups_{0};
+};
+
+}  // namespace wisson_SDK::network
@@ -0,0 +1,181 @@
+/**
+ * @file sequence_frame.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Sequence frames: one RobotCommand whose steps run in different controller modes.
+ *
+ * Sequence frame (little-endian):
+ *
+ *   u8   'M'             tag
+ *   u8                   reserved
+ *   u16  count           number of steps (<= cmd_list_size)
+ *   u32  cmd_id
+ *   f64  total_timeout   [s]
+ *   count x {
+ *     u8   space         control::ControlSpace of the step
+ *     u8   type          control::ControlType of the step
+ *     u8   entry         0 MotionCommand, 1 TorqueCommand, 2 EndEffectorCommand
+ *     u8                 reserved
+ *     u32  ee_action     control::EndEffectorAction (entry 2)
+ *     f64  values[JOINT_NUM]   positions, velocities or torques by type; 0 for entry 2
+ *     f64  timeout
+ *   }
+ *
+ * The server executes the steps back to back, switching its controller between
+ * steps, and answers with the response frames of command_frame.hpp: kSubSuccess
+ * per step, then the final status. Meant for servers advertising
+ * CapabilityFlag::kMixedSequences; not wired into the shipped transport yet, which
+ * never sends sequence frames.
+ *
+ * @example:
+ *   EncodeSequenceFrame(*seq.Build(), seq.Modes(), frame);
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "perseuslib/common/wisson_exception.hpp"
+#include "perseuslib/controller/controller.h"
+
+
+namespace wisson_SDK::network {
+
+inline constexpr uint8_t kSequenceFrameTag = 'M';
+inline constexpr std::size_t kSequenceHeaderSize = 1 + 1 + 2 + 4 + 8;
+inline constexpr std::size_t kSequenceStepSize = 8 + (JOINT_NUM + 1) * sizeof(double);
+
+[[nodiscard]] inline constexpr std::size_t SequenceFrameSize(std::size_t count) noexcept
+{
+  return kSequenceHeaderSize + count * kSequenceStepSize;
+}
+
+
+/**
+ * @brief Encode @p cmd, step i running in @p modes[i], into @p out (resized; reuse it).
+ * @throw CommandException if the sizes differ, a step cannot run in its mode, or a
+ *        mode is impedance (gains are per command, see command_frame.hpp).
+ */
+inline void EncodeSequenceFrame(const control::RobotCommand& cmd, std::span<const control::ControllerMode> modes,
+                                std::vector<uint8_t>& out)
+{
+  const std::size_t count = cmd.commands.size();
+  if (count != modes.size() || count > control::cmd_list_size) {
+    throw wisson_SDK::CommandException("libperseus-SequenceFrame: command " + std::to_string(cmd.cmd_id) + " has " +
+                                       std::to_string(count) + " steps and " + std::to_string(modes.size()) +
+                                       " modes.");
+  }
+
+  out.resize(SequenceFrameSize(count));
+  uint8_t* p = out.data();
+  const auto n = static_cast<uint16_t>(count);
+  p[0] = kSequenceFrameTag;
+  p[1] = 0;
+  std::memcpy(p + 2, &n, sizeof(n));
+  std::memcpy(p + 4, &cmd.cmd_id, sizeof(cmd.cmd_id));
+  std::memcpy(p + 8, &cmd.total_timeout, sizeof(cmd.total_timeout));
+  p += kSequenceHeaderSize;
+
+  for (std::size_t i = 0; i < count; ++i, p += kSequenceStepSize) {
+    const auto& step = cmd.commands[i];
+    const auto& mode = modes[i];
+    if (!control::detail::IsCommandSupported(mode, step) || mode.type == control::ControlType::kImpedance) {
+      throw wisson_SDK::CommandException("libperseus-SequenceFrame: step " + std::to_string(i) + " of command " +
+                                         std::to_string(cmd.cmd_id) + " cannot run in mode " + mode.ModeToString() + ".");
+    }
+
+    std::array<double, JOINT_NUM> values{};
+    uint32_t ee_action = 0;
+    double timeout = 0.0;
+    if (const auto* m = std::get_if<control::MotionCommand>(&step)) {
+      values = (mode.type == control::ControlType::kVelocity) ? m->joint_velocities : m->joint_positions;
+      timeout = m->timeout;
+    } else if (const auto* t = std::get_if<control::TorqueCommand>(&step)) {
+      values = t->desired_torque;
+      timeout = t->timeout;
+    } else if (const auto* e = std::get_if<control::EndEffectorCommand>(&step)) {
+      ee_action = static_cast<uint32_t>(e->ee_action);
+      timeout = e->timeout;
+    }
+    p[0] = static_cast<uint8_t>(mode.space);
+    p[1] = static_cast<uint8_t>(mode.type);
+    p[2] = static_cast<uint8_t>(step.index());
+    p[3] = 0;
+    std::memcpy(p + 4, &ee_action, sizeof(ee_action));
+    std::memcpy(p + 8, values.data(), sizeof(values));
+    std::memcpy(p + 8 + sizeof(values), &timeout, sizeof(timeout));
+  }
+}
+
+
+/**
+ * @brief Fields of a decoded sequence frame.
+ */
+struct DecodedSequenceFrame
+{
+  uint32_t cmd_id{0};
+  double total_timeout{0.0};
+  std::vector<control::SDKCmdVariant> steps;
+  std::vector<control::ControllerMode> modes;
+};
+
+/**
+ * @brief Decode a sequence frame.
+ * @return std::nullopt if the frame is truncated, not a sequence frame or has an unknown entry.
+ */
+[[nodiscard]] inline std::optional<DecodedSequenceFrame> DecodeSequenceFrame(const uint8_t* data, std::size_t size)
+{
+  if (data == nullptr || size < kSequenceHeaderSize || data[0] != kSequenceFrameTag) return std::nullopt;
+  uint16_t count = 0;
+  std::memcpy(&count, data + 2, sizeof(count));
+  if (count > control::cmd_list_size || size < SequenceFrameSize(count)) return std::nullopt;
+
+  DecodedSequenceFrame d;
+  std::memcpy(&d.cmd_id, data + 4, sizeof(d.cmd_id));
+  std::memcpy(&d.total_timeout, data + 8, sizeof(d.total_timeout));
+  d.steps.reserve(count);
+  d.modes.reserve(count);
+  const uint8_t* p = data + kSequenceHeaderSize;
+  for (std::size_t i = 0; i < count; ++i, p += kSequenceStepSize) {
+    const control::ControllerMode mode{static_cast<control::ControlSpace>(p[0]), static_cast<control::ControlType>(p[1])};
+    uint32_t ee_action = 0;
+    std::array<double, JOINT_NUM> values;
+    double timeout = 0.0;
+    std::memcpy(&ee_action, p + 4, sizeof(ee_action));
+    std::memcpy(values.data(), p + 8, sizeof(values));
+    std::memcpy(&timeout, p + 8 + sizeof(values), sizeof(timeout));
+
+    switch (p[2])
+    {
+      case 0:
+        d.steps.push_back(mode.type == control::ControlType::kVelocity
+                            ? control::MotionCommand::CreateVelocityCommand(values, timeout)
+                            : control::MotionCommand::CreateCommand(values, timeout));
+        break;
+      case 1:
+        d.steps.push_back(control::TorqueCommand::CreateCommand(values, timeout));
+        break;
+      case 2:
+        d.steps.push_back(control::EndEffectorCommand{.ee_action = static_cast<control::EndEffectorAction>(ee_action),
+                                                      .timeout = timeout});
+        break;
+      default:
+        return std::nullopt;
+    }
+    d.modes.push_back(mode);
+  }
+  return d;
+}
+
+}  // namespace wisson_SDK::network
@@ -0,0 +1,180 @@
+/**
+ * @file setpoint_frame.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Compact fixed-size frames carrying one streamed setpoint.
+ *
+ * Wire layout (little-endian, SetpointFrameSize(kind) bytes):
+ *
+ *   u8   kind        SetpointKind
+ *   u8   space       control::ControlSpace
+ *   u16  reserved    0
+ *   u32  sequence    setpoint counter of this stream
+ *   u64  state_seq   sequence of the state the setpoint was computed from
+ *   f64  values[JOINT_NUM]
+ *   f64  stiffness[JOINT_NUM]   kImpedance only
+ *   f64  damping[JOINT_NUM]     kImpedance only
+ *
+ * Encoding writes into a caller-provided buffer and never allocates.
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+#include "perseuslib/common/robot_state.hpp"
+#include "perseuslib/controller/controller.h"
+
+
+namespace wisson_SDK::network {
+
+static_assert(std::endian::native == std::endian::little, "setpoint frame assumes a little-endian host");
+
+/**
+ * @brief Quantity carried by a setpoint frame. Values are part of the wire protocol.
+ */
+enum class SetpointKind : uint8_t
+{
+  kPosition  = 'P',  ///< Joint positions [deg] (joint 0: [m]).
+  kVelocity  = 'V',  ///< Joint velocities [deg/s] (joint 0: [m/s]).
+  kTorque    = 'T',  ///< Joint torques [Nm] (joint 0: [N]).
+  kImpedance = 'I'   ///< Joint equilibrium positions plus per-joint stiffness and damping.
+};
+
+
+/**
+ * @brief One setpoint of a streaming control loop.
+ */
+struct Setpoint
+{
+  SetpointKind kind{SetpointKind::kPosition};
+  std::array<double, JOINT_NUM> values{};
+  std::array<double, JOINT_NUM> stiffness{};   ///< kImpedance only [Nm/deg] (joint 0: [N/m]).
+  std::array<double, JOINT_NUM> damping{};     ///< kImpedance only [Nms/deg] (joint 0: [Ns/m]).
+};
+
+
+inline constexpr std::size_t kSetpointHeaderSize = 1 + 1 + 2 + 4 + 8;
+inline constexpr std::size_t kSetpointFrameSize = kSetpointHeaderSize + JOINT_NUM * sizeof(double);
+inline constexpr std::size_t kImpedanceSetpointFrameSize = kSetpointHeaderSize + 3 * JOINT_NUM * sizeof(double);
+
+using SetpointFrameBuffer = std::array<uint8_t, kImpedanceSetpointFrameSize>;
+
+
+/**
+ * @brief Encoded size of a frame of @p kind, or 0 for an unknown kind.
+ */
+[[nodiscard]] inline constexpr std::size_t SetpointFrameSize(SetpointKind kind) noexcept
+{
+  switch (kind)
+  {
+    case SetpointKind::kPosition:
+    case SetpointKind::kVelocity:
+    case SetpointKind::kTorque:    return kSetpointFrameSize;
+    case SetpointKind::kImpedance: return kImpedanceSetpointFrameSize;
+    default:                       return 0;
+  }
+}
+
+
+/**
+ * @brief Setpoint kind used for @p type, if it can be streamed.
+ */
+[[nodiscard]] inline constexpr std::optional<SetpointKind> SetpointKindFor(control::ControlType type) noexcept
+{
+  switch (type)
+  {
+    case control::ControlType::kPosition:  return SetpointKind::kPosition;
+    case control::ControlType::kVelocity:  return SetpointKind::kVelocity;
+    case control::ControlType::kTorque:    return SetpointKind::kTorque;
+    case control::ControlType::kImpedance: return SetpointKind::kImpedance;
+    default:                               return std::nullopt;
+  }
+}
+
+
+/**
+ * @brief Encode a setpoint frame into @p out.
+ * @return Number of bytes written (SetpointFrameSize(sp.kind)).
+ */
+inline std::size_t EncodeSetpoint(const Setpoint& sp, control::ControlSpace space, uint32_t sequence,
+                           uint64_t state_seq, SetpointFrameBuffer& out) noexcept
+{
+  out[0] = static_cast<uint8_t>(sp.kind);
+  out[1] = static_cast<uint8_t>(space);
+  out[2] = 0;
+  out[3] = 0;
+  std::memcpy(out.data() + 4, &sequence, sizeof(sequence));
+  std::memcpy(out.data() + 8, &state_seq, sizeof(state_seq));
+  std::memcpy(out.data() + kSetpointHeaderSize, sp.values.data(), sizeof(sp.values));
+  if (sp.kind == SetpointKind::kImpedance) {
+    std::memcpy(out.data() + kSetpointFrameSize, sp.stiffness.data(), sizeof(sp.stiffness));
+    std::memcpy(out.data() + kSetpointFrameSize + sizeof(sp.stiffness), sp.damping.data(), sizeof(sp.damping));
+  }
+  return SetpointFrameSize(sp.kind);
+}
+
+
+/**
+ * @brief Fields of a decoded setpoint frame.
+ */
+struct DecodedSetpoint
+{
+  Setpoint setpoint{};
+  control::ControlSpace space{control::ControlSpace::kUnknown};
+  uint32_t sequence{0};
+  uint64_t state_seq{0};
+};
+
+/**
+ * @brief Decode a setpoint frame.
+ * @return std::nullopt if the frame is truncated or of an unknown kind.
+ */
+[[nodiscard]] inline std::optional<DecodedSetpoint> DecodeSetpoint(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size < kSetpointHeaderSize) return std::nullopt;
+  const auto kind = static_cast<SetpointKind>(data[0]);
+  const std::size_t frame_size = SetpointFrameSize(kind);
+  if (frame_size == 0 || size < frame_size) return std::nullopt;
+  DecodedSetpoint d;
+  d.setpoint.kind = kind;
+  d.space = static_cast<control::ControlSpace>(data[1]);
+  std::memcpy(&d.sequence, data + 4, sizeof(d.sequence));
+  std::memcpy(&d.state_seq, data + 8, sizeof(d.state_seq));
+  std::memcpy(d.setpoint.values.data(), data + kSetpointHeaderSize, sizeof(d.setpoint.values));
+  if (kind == SetpointKind::kImpedance) {
+    std::memcpy(d.setpoint.stiffness.data(), data + kSetpointFrameSize, sizeof(d.setpoint.stiffness));
+    std::memcpy(d.setpoint.damping.data(), data + kSetpointFrameSize + sizeof(d.setpoint.stiffness),
+                sizeof(d.setpoint.damping));
+  }
+  return d;
+}
+
+
+namespace detail {
+
+[[nodiscard]] inline constexpr std::string_view SetpointKindToString(SetpointKind kind) noexcept
+{
+  switch (kind)
+  {
+    case SetpointKind::kPosition:  return "Position";
+    case SetpointKind::kVelocity:  return "Velocity";
+    case SetpointKind::kTorque:    return "Torque";
+    case SetpointKind::kImpedance: return "Impedance";
+    default:                       return "Unknown";
+  }
+}
+
+} // namespace detail
+
+}  // namespace wisson_SDK::network
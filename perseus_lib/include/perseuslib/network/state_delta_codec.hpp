@@ -0,0 +1,443 @@
+/**
+ * @file state_delta_codec.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Keyframe + delta encoding of the state stream.
+ *
+ * Negotiated through CapabilityFlag::kStateDelta. Wire layout (little-endian):
+ *
+ *   u8     kind        'K' keyframe | 'D' delta
+ *   varint sequence    number of frames sent on this stream
+ *   varint due_mask    StateField bits refreshed by this frame; a keyframe carries
+ *                      every field the stream has sent so far, not only the due ones
+ *   varint changed     (delta only) subset of due_mask that changed;
+ *                      due_mask & ~changed is the "unchanged" bitmask
+ *   fields             in StateField bit order, for due_mask (keyframe) or changed (delta):
+ *                        q, q_err   : keyframe f64[9]; delta zig-zag varint of quantized step
+ *                        pressure   : zig-zag varint[18] (delta: difference to previous)
+ *                        pSource/pSink : zig-zag varint (delta: difference to previous)
+ *                        m_total    : f64
+ *                        O_T_EE     : f64[16]
+ *                        robot_mode : u8
+ *
+ * Joint deltas are quantized against the value the decoder reconstructed, so the
+ * error stays below half a quantum and never drifts. Keyframes carry raw values
+ * and are a full resync: the decoder drops its reference of any field a keyframe
+ * leaves out, so a frame that was skipped can never leave a stale value behind.
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "perseuslib/common/robot_state.hpp"
+#include "perseuslib/network/state_subscription.hpp"
+
+
+namespace wisson_SDK::network {
+
+static_assert(std::endian::native == std::endian::little, "state delta codec assumes a little-endian host");
+
+// -----------------------------------------------------------------------------------
+//                                Constants
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Upper bound of one encoded state frame [bytes].
+ */
+inline constexpr std::size_t kMaxEncodedStateSize = 512;
+
+/**
+ * @brief Default joint quantum for deltas [deg] (joint 0: [m]).
+ */
+inline constexpr double kDefaultJointQuantum = 1e-6;
+
+/**
+ * @brief Default number of frames between two keyframes.
+ */
+inline constexpr uint32_t kDefaultKeyframeInterval = 100;
+
+
+/**
+ * @brief Frame kind marker (first byte of every encoded state frame).
+ */
+enum class StateFrameKind : uint8_t
+{
+  kKeyframe = 'K',
+  kDelta    = 'D'
+};
+
+
+/**
+ * @brief Outcome of decoding one state frame.
+ */
+enum class StateDecodeResult : uint8_t
+{
+  kOk,            ///< Frame applied.
+  kNeedKeyframe,  ///< Delta without a valid reference (skipped); wait for a keyframe.
+  kMalformed      ///< Truncated or corrupt frame (skipped).
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Byte Helpers
+// -----------------------------------------------------------------------------------
+namespace detail {
+
+[[nodiscard]] inline constexpr uint64_t ZigZagEncode(int64_t v) noexcept
+  { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+[[nodiscard]] inline constexpr int64_t ZigZagDecode(uint64_t v) noexcept
+  { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+/**
+ * @brief Bounded writer over caller-owned storage. Sets `overflow` instead of throwing.
+ */
+struct ByteWriter
+{
+  uint8_t* data;
+  std::size_t capacity;
+  std::size_t size{0};
+  bool overflow{false};
+
+  void PutU8(uint8_t v) noexcept
+  {
+    if (size >= capacity) { overflow = true; return; }
+    data[size++] = v;
+  }
+  void PutVarint(uint64_t v) noexcept
+  {
+    while (v >= 0x80) { PutU8(static_cast<uint8_t>(v | 0x80)); v >>= 7; }
+    PutU8(static_cast<uint8_t>(v));
+  }
+  void PutZigZag(int64_t v) noexcept { PutVarint(ZigZagEncode(v)); }
+  void PutF64(double v) noexcept
+  {
+    if (size + sizeof(double) > capacity) { overflow = true; return; }
+    std::memcpy(data + size, &v, sizeof(double));
+    size += sizeof(double);
+  }
+};
+
+/**
+ * @brief Bounded reader. Sets `error` on truncation.
+ */
+struct ByteReader
+{
+  const uint8_t* data;
+  std::size_t size;
+  std::size_t pos{0};
+  bool error{false};
+
+  uint8_t GetU8() noexcept
+  {
+    if (pos >= size) { error = true; return 0; }
+    return data[pos++];
+  }
+  uint64_t GetVarint() noexcept
+  {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const uint8_t b = GetU8();
+      v |= static_cast<uint64_t>(b & 0x7F) << shift;
+      if ((b & 0x80) == 0) return v;
+    }
+    error = true;
+    return 0;
+  }
+  int64_t GetZigZag() noexcept { return ZigZagDecode(GetVarint()); }
+  double GetF64() noexcept
+  {
+    if (pos + sizeof(double) > size) { error = true; return 0.0; }
+    double v;
+    std::memcpy(&v, data + pos, sizeof(double));
+    pos += sizeof(double);
+    return v;
+  }
+};
+
+} // namespace detail
+
+
+
+// -----------------------------------------------------------------------------------
+//                               Encoder
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Server-side (or stand-in) encoder. Not thread-safe; one per stream.
+ */
+class StateDeltaEncoder
+{
+public:
+  explicit StateDeltaEncoder(uint32_t keyframe_interval = kDefaultKeyframeInterval,
+                             double joint_quantum = kDefaultJointQuantum) noexcept
+    : keyframe_interval_(keyframe_interval == 0 ? 1 : keyframe_interval),
+      quantum_(joint_quantum), inv_quantum_(1.0 / joint_quantum) {}
+
+  /**
+   * @brief Force the next frame to be a keyframe (e.g. on client request).
+   */
+  void RequestKeyframe() noexcept { force_keyframe_ = true; }
+
+  /**
+   * @brief Encode @p state, refreshing the fields in @p due.
+   *
+   * A keyframe (periodic, forced, or for a field sent for the first time) also
+   * rewrites every field sent before, so it resyncs the decoder completely.
+   * @return Encoded size, or 0 if @p capacity is too small.
+   */
+  std::size_t Encode(const RobotState& state, StateFieldMask due, uint8_t* out, std::size_t capacity) noexcept
+  {
+    due &= kAllStateFields;
+    const bool keyframe = force_keyframe_ || since_keyframe_ + 1 >= keyframe_interval_ ||
+                          (due & ~ref_valid_) != 0;
+
+    detail::ByteWriter w{out, capacity};
+    const RobotState prev = ref_;
+    if (keyframe) {
+      due |= ref_valid_;
+      w.PutU8(static_cast<uint8_t>(StateFrameKind::kKeyframe));
+      w.PutVarint(sequence_);
+      w.PutVarint(due);
+      WriteKeyframeFields(w, state, due);
+    } else {
+      const StateFieldMask changed = ChangedFields(state, due);
+      w.PutU8(static_cast<uint8_t>(StateFrameKind::kDelta));
+      w.PutVarint(sequence_);
+      w.PutVarint(due);
+      w.PutVarint(changed);
+      WriteDeltaFields(w, state, changed);
+    }
+
+    if (w.overflow) {
+      ref_ = prev;  // nothing was sent; keep the decoder's view
+      return 0;
+    }
+    if (keyframe) {
+      ref_valid_ = due;
+      since_keyframe_ = 0;
+      force_keyframe_ = false;
+      ++keyframes_;
+    } else {
+      ++since_keyframe_;
+      ++deltas_;
+    }
+    ++sequence_;
+    return w.size;
+  }
+
+  [[nodiscard]] uint64_t KeyframeCount() const noexcept { return keyframes_; }
+  [[nodiscard]] uint64_t DeltaCount() const noexcept { return deltas_; }
+
+private:
+  int64_t Quantize(double target, double ref) const noexcept
+    { return static_cast<int64_t>(std::llround((target - ref) * inv_quantum_)); }
+
+  StateFieldMask ChangedFields(const RobotState& s, StateFieldMask due) const noexcept
+  {
+    StateFieldMask changed = 0;
+    auto joints_changed = [this](const auto& a, const auto& ref) {
+      for (std::size_t i = 0; i < JOINT_NUM; ++i) {
+        if (Quantize(a[i], ref[i]) != 0) return true;
+      }
+      return false;
+    };
+    if (HasField(due, StateField::kQ) && joints_changed(s.q, ref_.q)) changed |= StateField::kQ;
+    if (HasField(due, StateField::kQErr) && joints_changed(s.q_err, ref_.q_err)) changed |= StateField::kQErr;
+    if (HasField(due, StateField::kPressure) && s.pressure != ref_.pressure) changed |= StateField::kPressure;
+    if (HasField(due, StateField::kPSource) && s.pSource != ref_.pSource) changed |= StateField::kPSource;
+    if (HasField(due, StateField::kPSink) && s.pSink != ref_.pSink) changed |= StateField::kPSink;
+    if (HasField(due, StateField::kMTotal) && s.m_total != ref_.m_total) changed |= StateField::kMTotal;
+    if (HasField(due, StateField::kOTEE) && s.O_T_EE != ref_.O_T_EE) changed |= StateField::kOTEE;
+    if (HasField(due, StateField::kRobotMode) && s.robot_mode != ref_.robot_mode) changed |= StateField::kRobotMode;
+    return changed;
+  }
+
+  void WriteKeyframeFields(detail::ByteWriter& w, const RobotState& s, StateFieldMask m) noexcept
+  {
+    if (HasField(m, StateField::kQ)) {
+      for (double v : s.q) w.PutF64(v);
+      ref_.q = s.q;
+    }
+    if (HasField(m, StateField::kQErr)) {
+      for (double v : s.q_err) w.PutF64(v);
+      ref_.q_err = s.q_err;
+    }
+    if (HasField(m, StateField::kPressure)) {
+      for (int v : s.pressure) w.PutZigZag(v);
+      ref_.pressure = s.pressure;
+    }
+    if (HasField(m, StateField::kPSource)) { w.PutZigZag(s.pSource); ref_.pSource = s.pSource; }
+    if (HasField(m, StateField::kPSink))   { w.PutZigZag(s.pSink);   ref_.pSink = s.pSink; }
+    if (HasField(m, StateField::kMTotal))  { w.PutF64(s.m_total);    ref_.m_total = s.m_total; }
+    if (HasField(m, StateField::kOTEE)) {
+      for (double v : s.O_T_EE) w.PutF64(v);
+      ref_.O_T_EE = s.O_T_EE;
+    }
+    if (HasField(m, StateField::kRobotMode)) {
+      w.PutU8(static_cast<uint8_t>(s.robot_mode));
+      ref_.robot_mode = s.robot_mode;
+    }
+  }
+
+  void WriteDeltaFields(detail::ByteWriter& w, const RobotState& s, StateFieldMask m) noexcept
+  {
+    auto put_joints = [&](const auto& target, auto& ref) {
+      for (std::size_t i = 0; i < JOINT_NUM; ++i) {
+        const int64_t k = Quantize(target[i], ref[i]);
+        w.PutZigZag(k);
+        ref[i] += static_cast<double>(k) * quantum_;  // mirror the decoder reconstruction
+      }
+    };
+    if (HasField(m, StateField::kQ))    put_joints(s.q, ref_.q);
+    if (HasField(m, StateField::kQErr)) put_joints(s.q_err, ref_.q_err);
+    if (HasField(m, StateField::kPressure)) {
+      for (std::size_t i = 0; i < CHAMBER_NUM; ++i) w.PutZigZag(s.pressure[i] - ref_.pressure[i]);
+      ref_.pressure = s.pressure;
+    }
+    if (HasField(m, StateField::kPSource)) { w.PutZigZag(s.pSource - ref_.pSource); ref_.pSource = s.pSource; }
+    if (HasField(m, StateField::kPSink))   { w.PutZigZag(s.pSink - ref_.pSink);     ref_.pSink = s.pSink; }
+    if (HasField(m, StateField::kMTotal))  { w.PutF64(s.m_total);                   ref_.m_total = s.m_total; }
+    if (HasField(m, StateField::kOTEE)) {
+      for (double v : s.O_T_EE) w.PutF64(v);
+      ref_.O_T_EE = s.O_T_EE;
+    }
+    if (HasField(m, StateField::kRobotMode)) {
+      w.PutU8(static_cast<uint8_t>(s.robot_mode));
+      ref_.robot_mode = s.robot_mode;
+    }
+  }
+
+private:
+  const uint32_t keyframe_interval_;
+  const double quantum_;
+  const double inv_quantum_;
+  RobotState ref_{};
+  StateFieldMask ref_valid_{0};
+  uint64_t sequence_{0};
+  uint32_t since_keyframe_{0};
+  bool force_keyframe_{true};
+  uint64_t keyframes_{0};
+  uint64_t deltas_{0};
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                               Decoder
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Client-side decoder, run in SDKNetwork before a state is published.
+ *
+ * Not thread-safe; one per stream. On kNeedKeyframe / kMalformed the published
+ * state is left untouched and the caller should ask the server for a keyframe.
+ */
+class StateDeltaDecoder
+{
+public:
+  explicit StateDeltaDecoder(double joint_quantum = kDefaultJointQuantum) noexcept
+    : quantum_(joint_quantum) {}
+
+  /**
+   * @brief Drop the reference state, e.g. after a reconnect.
+   */
+  void Reset() noexcept
+  {
+    ref_ = RobotState{};
+    ref_valid_ = 0;
+    synced_ = false;
+  }
+
+  /**
+   * @brief Decode one frame and merge it into @p out.
+   */
+  StateDecodeResult Decode(const uint8_t* data, std::size_t size, SubscribedRobotState& out) noexcept
+  {
+    detail::ByteReader r{data, size};
+    const auto kind = static_cast<StateFrameKind>(r.GetU8());
+    const uint64_t seq = r.GetVarint();
+    const auto due = static_cast<StateFieldMask>(r.GetVarint());
+    if (r.error || (due & ~kAllStateFields) != 0) return Fail(StateDecodeResult::kMalformed);
+
+    RobotState next = ref_;
+    if (kind == StateFrameKind::kKeyframe) {
+      ReadKeyframeFields(r, next, due);
+      if (r.error || r.pos != size) return Fail(StateDecodeResult::kMalformed);
+      ref_valid_ = due;  // full resync: fields left out need the next keyframe
+      synced_ = true;
+    } else if (kind == StateFrameKind::kDelta) {
+      const auto changed = static_cast<StateFieldMask>(r.GetVarint());
+      if (r.error || (changed & ~due) != 0) return Fail(StateDecodeResult::kMalformed);
+      if (!synced_ || seq != last_sequence_ + 1 || (due & ~ref_valid_) != 0) {
+        return Fail(StateDecodeResult::kNeedKeyframe);
+      }
+      ReadDeltaFields(r, next, changed);
+      if (r.error || r.pos != size) return Fail(StateDecodeResult::kMalformed);
+    } else {
+      return Fail(StateDecodeResult::kMalformed);
+    }
+
+    ref_ = next;
+    last_sequence_ = seq;
+    out.Merge(ref_, due, seq);
+    ++decoded_;
+    return StateDecodeResult::kOk;
+  }
+
+  [[nodiscard]] uint64_t DecodedCount() const noexcept { return decoded_; }
+  [[nodiscard]] uint64_t RejectedCount() const noexcept { return rejected_; }
+
+private:
+  StateDecodeResult Fail(StateDecodeResult result) noexcept
+  {
+    ++rejected_;
+    if (result == StateDecodeResult::kMalformed) synced_ = false;
+    return result;
+  }
+
+  static void ReadKeyframeFields(detail::ByteReader& r, RobotState& s, StateFieldMask m) noexcept
+  {
+    if (HasField(m, StateField::kQ))        for (double& v : s.q) v = r.GetF64();
+    if (HasField(m, StateField::kQErr))     for (double& v : s.q_err) v = r.GetF64();
+    if (HasField(m, StateField::kPressure)) for (int& v : s.pressure) v = static_cast<int>(r.GetZigZag());
+    if (HasField(m, StateField::kPSource))  s.pSource = static_cast<int>(r.GetZigZag());
+    if (HasField(m, StateField::kPSink))    s.pSink = static_cast<int>(r.GetZigZag());
+    if (HasField(m, StateField::kMTotal))   s.m_total = r.GetF64();
+    if (HasField(m, StateField::kOTEE))     for (double& v : s.O_T_EE) v = r.GetF64();
+    if (HasField(m, StateField::kRobotMode)) s.robot_mode = static_cast<RobotMode>(r.GetU8());
+  }
+
+  void ReadDeltaFields(detail::ByteReader& r, RobotState& s, StateFieldMask m) const noexcept
+  {
+    if (HasField(m, StateField::kQ))        for (double& v : s.q) v += static_cast<double>(r.GetZigZag()) * quantum_;
+    if (HasField(m, StateField::kQErr))     for (double& v : s.q_err) v += static_cast<double>(r.GetZigZag()) * quantum_;
+    if (HasField(m, StateField::kPressure)) for (int& v : s.pressure) v += static_cast<int>(r.GetZigZag());
+    if (HasField(m, StateField::kPSource))  s.pSource += static_cast<int>(r.GetZigZag());
+    if (HasField(m, StateField::kPSink))    s.pSink += static_cast<int>(r.GetZigZag());
+    if (HasField(m, StateField::kMTotal))   s.m_total = r.GetF64();
+    if (HasField(m, StateField::kOTEE))     for (double& v : s.O_T_EE) v = r.GetF64();
+    if (HasField(m, StateField::kRobotMode)) s.robot_mode = static_cast<RobotMode>(r.GetU8());
+  }
+
+private:
+  const double quantum_;
+  RobotState ref_{};
+  StateFieldMask ref_valid_{0};
+  uint64_t last_sequence_{0};
+  bool synced_{false};
+  uint64_t decoded_{0};
+  uint64_t rejected_{0};
+};
+
+}  // namespace wisson_SDK::network
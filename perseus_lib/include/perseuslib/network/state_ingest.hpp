@@ -0,0 +1,179 @@
+/**
+ * @file state_ingest.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Backlog-aware state ingestion: parse only the newest state frame of a batch.
+ *
+ * When the io thread falls behind, one socket read returns several queued frames.
+ * Decoding all of them in order only makes the published state lag further.
+ * StateIngestor classifies the frames of a receive batch by header, forwards
+ * non-state frames (command responses, test answers) in order, and decodes only
+ * the newest state frame. Superseded state frames are counted, never decoded.
+ *
+ * With delta encoding (CapabilityFlag::kStateDelta) deltas depend on their
+ * predecessors, so decoding restarts at the newest keyframe of the batch; only
+ * frames before it are skipped. This relies on every keyframe being a full resync
+ * (StateDeltaEncoder writes all fields sent so far, not only the due ones): a
+ * skipped delta may be the only carrier of a rate-limited field. Against a keyframe
+ * that leaves a field out, the decoder reports kNeedKeyframe for the next delta
+ * touching it instead of applying that delta to a stale value.
+ *
+ * StateNotifyFd() exposes the state channel to user event loops: the descriptor
+ * becomes readable after every batch that published a new state.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <span>
+
+#include "perseuslib/common/event_fd.hpp"
+#include "perseuslib/network/state_delta_codec.hpp"
+
+
+namespace wisson_SDK::network {
+
+/**
+ * @brief One complete frame inside a receive batch (borrowed bytes).
+ */
+struct FrameView
+{
+  const uint8_t* data{nullptr};
+  std::size_t size{0};
+};
+
+
+/**
+ * @brief Frame categories, decided from the frame header only.
+ */
+enum class FrameClass : uint8_t
+{
+  kOther,          ///< Not a state frame; always handled, in order.
+  kState,          ///< Self-contained state frame (full encoding).
+  kStateKeyframe,  ///< Delta stream keyframe.
+  kStateDelta      ///< Delta stream delta; needs its predecessors.
+};
+
+
+/**
+ * @brief Classify a delta-codec payload from its first byte.
+ */
+[[nodiscard]] inline constexpr FrameClass ClassifyDeltaStateFrame(const FrameView& frame) noexcept
+{
+  if (frame.size == 0) return FrameClass::kOther;
+  switch (static_cast<StateFrameKind>(frame.data[0]))
+  {
+    case StateFrameKind::kKeyframe: return FrameClass::kStateKeyframe;
+    case StateFrameKind::kDelta:    return FrameClass::kStateDelta;
+    default:                        return FrameClass::kOther;
+  }
+}
+
+
+/**
+ * @brief Ingestion counters. Readable from any thread.
+ */
+struct IngestStats
+{
+  std::atomic<uint64_t> batches{0};       ///< Receive batches processed.
+  std::atomic<uint64_t> decoded{0};       ///< State frames handed to the decoder.
+  std::atomic<uint64_t> superseded{0};    ///< State frames skipped without decoding.
+  std::atomic<uint64_t> max_backlog{0};   ///< Largest number of state frames in one batch.
+};
+
+
+/**
+ * @brief Applies the newest-frame-wins policy to receive batches (io thread only).
+ */
+class StateIngestor
+{
+public:
+  /**
+   * @brief Process one receive batch.
+   *
+   * @param frames    Complete frames in arrival order.
+   * @param classify  `FrameClass(const FrameView&)`, must not decode the payload.
+   * @param on_state  `void(const FrameView&)`, decodes and publishes a state frame.
+   * @param on_other  `void(const FrameView&)`, handles a non-state frame.
+   */
+  template <typename ClassifyFn, typename StateFn, typename OtherFn>
+  void ProcessBatch(std::span<const FrameView> frames, ClassifyFn&& classify,
+                    StateFn&& on_state, OtherFn&& on_other)
+  {
+    // Backwards scan: newest self-contained state frame and newest keyframe.
+    constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+    std::size_t newest_full = kNone;
+    std::size_t newest_key = kNone;
+    uint64_t state_frames = 0;
+    for (std::size_t i = frames.size(); i-- > 0;) {
+      const FrameClass c = classify(frames[i]);
+      if (c == FrameClass::kOther) continue;
+      ++state_frames;
+      if (c == FrameClass::kState && newest_full == kNone) newest_full = i;
+      if (c == FrameClass::kStateKeyframe && newest_key == kNone) newest_key = i;
+    }
+
+    uint64_t decoded = 0;
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+      const FrameClass c = classify(frames[i]);
+      bool decode = false;
+      switch (c)
+      {
+        case FrameClass::kOther:
+          on_other(frames[i]);
+          continue;
+        case FrameClass::kState:
+          decode = (i == newest_full);
+          break;
+        case FrameClass::kStateKeyframe:
+        case FrameClass::kStateDelta:
+          // Keyframes are full resyncs, so nothing before the newest one is needed.
+          decode = (newest_key == kNone || i >= newest_key);
+          break;
+      }
+      if (decode) {
+        on_state(frames[i]);
+        ++decoded;
+      }
+    }
+
+    if (decoded > 0 && state_event_) state_event_->Notify();
+
+    stats_.batches.fetch_add(1, std::memory_order_relaxed);
+    stats_.decoded.fetch_add(decoded, std::memory_order_relaxed);
+    stats_.superseded.fetch_add(state_frames - decoded, std::memory_order_relaxed);
+    if (state_frames > stats_.max_backlog.load(std::memory_order_relaxed)) {
+      stats_.max_backlog.store(state_frames, std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] const IngestStats& Stats() const noexcept { return stats_; }
+
+  /**
+   * @brief Descriptor that becomes readable once a new state was published.
+   *
+   * One notification per batch, however many state frames it held. Consume it
+   * (EventFd::Consume semantics: read 8 bytes) before reading the state, so a state
+   * published meanwhile wakes the loop again.
+   * @note Call before the first ProcessBatch().
+   * @throw ConstructorException if no eventfd can be created.
+   */
+  [[nodiscard]] int StateNotifyFd()
+  {
+    if (!state_event_) state_event_ = std::make_unique<EventFd>();
+    return state_event_->Fd();
+  }
+
+private:
+  IngestStats stats_;
+  std::unique_ptr<EventFd> state_event_;
+};
+
+}  // namespace wisson_SDK::network
@@ -0,0 +1,316 @@
+/**
+ * @file state_subscription.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Field-subset and rate-controlled state subscriptions.
+ *
+ * This header contains:
+ *  - StateField bits naming the RobotState fields
+ *  - StateSubscription: which fields to stream and at which decimated rate
+ *  - SubscribedRobotState: RobotState plus per-field validity flags
+ *
+ * Not wired into the shipped transport yet: the state client never sends a
+ * subscription on connect, and PerseusRobot has no way to request one, so the
+ * server keeps streaming every field at the base rate. The types are the building
+ * block for a state client that does, and for servers decimating their stream.
+ *
+ * @example:
+ *   auto sub = StateSubscription()
+ *                .Add(StateField::kQ, 1000)
+ *                .Add(StateField::kPressure | StateField::kPSource | StateField::kPSink, 50);
+ *   Json::Value body = sub.ToJson();   // body of the subscription request frame
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+
+#include <json/json.h>
+
+#include "perseuslib/common/robot_state.hpp"
+#include "perseuslib/common/wisson_exception.hpp"
+
+
+namespace wisson_SDK::network {
+
+// -----------------------------------------------------------------------------------
+//                                Constants
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Nominal rate of the server state stream [Hz].
+ */
+inline constexpr uint32_t kStateBaseRateHz = 1000;
+
+
+
+// -----------------------------------------------------------------------------------
+//                                State Fields
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief One bit per RobotState field. Values are part of the wire protocol.
+ */
+enum class StateField : uint32_t
+{
+  kQ         = 1u << 0,   ///< RobotState::q
+  kQErr      = 1u << 1,   ///< RobotState::q_err
+  kPressure  = 1u << 2,   ///< RobotState::pressure
+  kPSource   = 1u << 3,   ///< RobotState::pSource
+  kPSink     = 1u << 4,   ///< RobotState::pSink
+  kMTotal    = 1u << 5,   ///< RobotState::m_total
+  kOTEE      = 1u << 6,   ///< RobotState::O_T_EE
+  kRobotMode = 1u << 7,   ///< RobotState::robot_mode
+};
+
+using StateFieldMask = uint32_t;
+
+inline constexpr std::size_t kStateFieldCount = 8;
+inline constexpr StateFieldMask kAllStateFields = (1u << kStateFieldCount) - 1;
+
+[[nodiscard]] inline constexpr StateFieldMask operator|(StateField a, StateField b) noexcept
+  { return static_cast<StateFieldMask>(a) | static_cast<StateFieldMask>(b); }
+[[nodiscard]] inline constexpr StateFieldMask operator|(StateFieldMask a, StateField b) noexcept
+  { return a | static_cast<StateFieldMask>(b); }
+inline constexpr StateFieldMask& operator|=(StateFieldMask& a, StateField b) noexcept
+  { return a = a | b; }
+[[nodiscard]] inline constexpr bool HasField(StateFieldMask mask, StateField f) noexcept
+  { return (mask & static_cast<StateFieldMask>(f)) != 0; }
+
+
+namespace detail {
+
+/**
+ * @brief Convert a single StateField to its RobotState member name.
+ */
+[[nodiscard]] inline constexpr std::string_view StateFieldToString(StateField field) noexcept
+{
+  switch (field)
+  {
+    case StateField::kQ:         return "q";
+    case StateField::kQErr:      return "q_err";
+    case StateField::kPressure:  return "pressure";
+    case StateField::kPSource:   return "pSource";
+    case StateField::kPSink:     return "pSink";
+    case StateField::kMTotal:    return "m_total";
+    case StateField::kOTEE:      return "O_T_EE";
+    case StateField::kRobotMode: return "robot_mode";
+    default:                     return "Unknown";
+  }
+}
+
+/**
+ * @brief Format a mask as "q|pressure|...".
+ */
+[[nodiscard]] inline std::string StateFieldMaskToString(StateFieldMask mask)
+{
+  std::string out;
+  for (std::size_t i = 0; i < kStateFieldCount; ++i) {
+    const auto f = static_cast<StateField>(1u << i);
+    if (!HasField(mask, f)) continue;
+    if (!out.empty()) out += "|";
+    out += StateFieldToString(f);
+  }
+  return out.empty() ? "None" : out;
+}
+
+} // namespace detail
+
+
+
+// -----------------------------------------------------------------------------------
+//                             State Subscription
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief A group of fields streamed at one rate.
+ */
+struct FieldRate
+{
+  StateFieldMask fields{0};
+  uint32_t rate_hz{kStateBaseRateHz};
+
+  constexpr bool operator==(const FieldRate&) const = default;
+};
+
+
+/**
+ * @brief Subscription request sent on the state channel.
+ *
+ * A default-constructed subscription means "everything at the base rate", which
+ * is what legacy servers stream anyway. Rates are realized by decimating the base
+ * stream, so the effective rate is kStateBaseRateHz / round(kStateBaseRateHz / rate_hz).
+ */
+class StateSubscription
+{
+public:
+  StateSubscription() = default;
+
+  /**
+   * @brief Request @p fields at @p rate_hz. Fields already requested keep the higher rate.
+   * @throw InvalidOperationException if rate_hz is 0 or above the base rate.
+   */
+  StateSubscription& Add(StateFieldMask fields, uint32_t rate_hz)
+  {
+    if (rate_hz == 0 || rate_hz > kStateBaseRateHz) {
+      throw wisson_SDK::InvalidOperationException("libperseus-StateSubscription: rate must be in (0, base rate].");
+    }
+    fields &= kAllStateFields;
+    for (auto& group : groups_) {
+      if (group.rate_hz >= rate_hz) fields &= ~group.fields;
+    }
+    for (auto& group : groups_) {
+      if (group.rate_hz < rate_hz) group.fields &= ~fields;
+    }
+    std::erase_if(groups_, [](const FieldRate& g) { return g.fields == 0; });
+    if (fields == 0) return *this;
+
+    auto it = std::find_if(groups_.begin(), groups_.end(),
+                           [rate_hz](const FieldRate& g) { return g.rate_hz == rate_hz; });
+    if (it != groups_.end()) it->fields |= fields;
+    else groups_.push_back({fields, rate_hz});
+    return *this;
+  }
+
+  StateSubscription& Add(StateField field, uint32_t rate_hz)
+    { return Add(static_cast<StateFieldMask>(field), rate_hz); }
+
+  /**
+   * @brief True if nothing was requested (i.e. full stream).
+   */
+  [[nodiscard]] bool IsFullStream() const noexcept { return groups_.empty(); }
+
+  /**
+   * @brief Union of all subscribed fields.
+   */
+  [[nodiscard]] StateFieldMask Fields() const noexcept
+  {
+    if (groups_.empty()) return kAllStateFields;
+    StateFieldMask mask = 0;
+    for (const auto& g : groups_) mask |= g.fields;
+    return mask;
+  }
+
+  [[nodiscard]] const std::vector<FieldRate>& Groups() const noexcept { return groups_; }
+
+  /**
+   * @brief Decimation divisor applied to the base stream for @p rate_hz.
+   */
+  [[nodiscard]] static constexpr uint32_t Divisor(uint32_t rate_hz) noexcept
+  {
+    if (rate_hz == 0) return 0;
+    return std::max<uint32_t>(1, (kStateBaseRateHz + rate_hz / 2) / rate_hz);
+  }
+
+  /**
+   * @brief Fields that are due in base-stream frame number @p tick.
+   */
+  [[nodiscard]] StateFieldMask FieldsDue(uint64_t tick) const noexcept
+  {
+    if (groups_.empty()) return kAllStateFields;
+    StateFieldMask mask = 0;
+    for (const auto& g : groups_) {
+      if (tick % Divisor(g.rate_hz) == 0) mask |= g.fields;
+    }
+    return mask;
+  }
+
+  /**
+   * @brief Encode as the body of the subscription request frame.
+   */
+  [[nodiscard]] Json::Value ToJson() const
+  {
+    Json::Value body(Json::objectValue);
+    Json::Value groups(Json::arrayValue);
+    for (const auto& g : groups_) {
+      Json::Value item;
+      item["Fields"] = Json::UInt(g.fields);
+      item["RateHz"] = Json::UInt(g.rate_hz);
+      groups.append(item);
+    }
+    body["Subscription"] = groups;
+    return body;
+  }
+
+  /**
+   * @brief Decode a subscription request body.
+   * @throw ProtocolException if the body is malformed.
+   */
+  [[nodiscard]] static StateSubscription FromJson(const Json::Value& body)
+  {
+    if (!body.isObject() || !body["Subscription"].isArray()) {
+      throw wisson_SDK::ProtocolException("libperseus-StateSubscription: missing Subscription array.");
+    }
+    StateSubscription sub;
+    for (const auto& item : body["Subscription"]) {
+      if (!item["Fields"].isUInt() || !item["RateHz"].isUInt()) {
+        throw wisson_SDK::ProtocolException("libperseus-StateSubscription: malformed subscription entry.");
+      }
+      try {
+        sub.Add(item["Fields"].asUInt(), item["RateHz"].asUInt());
+      } catch (const wisson_SDK::InvalidOperationException& e) {
+        throw wisson_SDK::ProtocolException(e.what());
+      }
+    }
+    return sub;
+  }
+
+  bool operator==(const StateSubscription&) const = default;
+
+private:
+  std::vector<FieldRate> groups_;
+};
+
+
+
+// -----------------------------------------------------------------------------------
+//                           Subscribed Robot State
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief RobotState published under a subscription, with per-field validity.
+ *
+ * `valid` marks fields that have been received at least once; `updated` marks the
+ * fields refreshed by the most recent frame. Fields outside the subscription keep
+ * their default values and are never valid.
+ */
+struct SubscribedRobotState
+{
+  RobotState state{};
+  StateFieldMask valid{0};    ///< Fields holding received data.
+  StateFieldMask updated{0};  ///< Fields refreshed by the last frame.
+  uint64_t sequence{0};       ///< Base-stream frame number of the last update.
+
+  [[nodiscard]] bool IsValid(StateField f) const noexcept { return HasField(valid, f); }
+  [[nodiscard]] bool IsUpdated(StateField f) const noexcept { return HasField(updated, f); }
+
+  /**
+   * @brief Copy the fields in @p fields from @p src and update validity.
+   */
+  void Merge(const RobotState& src, StateFieldMask fields, uint64_t seq) noexcept
+  {
+    if (HasField(fields, StateField::kQ))         state.q = src.q;
+    if (HasField(fields, StateField::kQErr))      state.q_err = src.q_err;
+    if (HasField(fields, StateField::kPressure))  state.pressure = src.pressure;
+    if (HasField(fields, StateField::kPSource))   state.pSource = src.pSource;
+    if (HasField(fields, StateField::kPSink))     state.pSink = src.pSink;
+    if (HasField(fields, StateField::kMTotal))    state.m_total = src.m_total;
+    if (HasField(fields, StateField::kOTEE))      state.O_T_EE = src.O_T_EE;
+    if (HasField(fields, StateField::kRobotMode)) state.robot_mode = src.robot_mode;
+    valid |= fields;
+    updated = fields;
+    sequence = seq;
+  }
+};
+
+}  // namespace wisson_SDK::network
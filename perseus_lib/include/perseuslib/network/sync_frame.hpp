@@ -0,0 +1,220 @@
+/**
+ * @file sync_frame.hpp
+ *
+ * @copyright (c) 2025, WissonRobotics
+ *
+ * @version 1.0
+ * @date: 2026-10-16
+ * @author: Yuchen Xia (xiayuchen66@gmail.com)
+ *
+ * @brief Frames for clock synchronization and barrier-synchronized starts.
+ *
+ * All frames start with a tag byte followed by three reserved bytes (little-endian):
+ *
+ *   clock probe   'C'  u32 seq, i64 t0                                  (16 B)
+ *   clock answer  'c'  u32 seq, i64 t0, i64 t1, i64 t2                  (32 B)
+ *   stage         'A'  u32 group_id, command frame                      (8 B + command)
+ *   trigger       'G'  u32 group_id, i64 start_ns                       (16 B)
+ *   started       'g'  u32 group_id, u32 cmd_id, u32 reserved, i64 t    (24 B)
+ *   withdraw      'W'  u32 group_id                                     (8 B)
+ *
+ * A staged command is parsed and checked by the server but held until the trigger
+ * of its group arrives; the server acknowledges staging with a command response
+ * {cmd_id, kWaiting}. The trigger starts every command of the group at start_ns
+ * on the server clock, or on receipt if start_ns is 0. One started frame per
+ * command reports the actual start on the server clock. A withdraw drops the held
+ * commands of its group and stops those that already started; each answers with
+ * {cmd_id, kUserStop}. Used when the server
+ * advertises CapabilityFlag::kSyncStart.
+ *
+ * @example:
+ *   std::array<uint8_t, kClockProbeSize> probe;
+ *   EncodeClockProbe({seq, timer::SteadyNowNs()}, probe);
+ *   ...
+ *   if (auto a = DecodeClockAnswer(data, size)) sync.AddSample(a->t0, a->t1, a->t2, timer::SteadyNowNs());
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+
+namespace wisson_SDK::network {
+
+inline constexpr uint8_t kClockProbeTag  = 'C';
+inline constexpr uint8_t kClockAnswerTag = 'c';
+inline constexpr uint8_t kStageTag       = 'A';
+inline constexpr uint8_t kTriggerTag     = 'G';
+inline constexpr uint8_t kStartedTag     = 'g';
+inline constexpr uint8_t kWithdrawTag    = 'W';
+
+inline constexpr std::size_t kClockProbeSize  = 16;
+inline constexpr std::size_t kClockAnswerSize = 32;
+inline constexpr std::size_t kStageHeaderSize = 8;
+inline constexpr std::size_t kTriggerSize     = 16;
+inline constexpr std::size_t kStartedSize     = 24;
+inline constexpr std::size_t kWithdrawSize    = 8;
+
+
+namespace detail {
+
+template <typename T>
+inline void Put(uint8_t* p, const T& v) noexcept { std::memcpy(p, &v, sizeof(T)); }
+
+template <typename T>
+[[nodiscard]] inline T Get(const uint8_t* p) noexcept
+{
+  T v;
+  std::memcpy(&v, p, sizeof(T));
+  return v;
+}
+
+inline void PutTag(uint8_t* p, uint8_t tag) noexcept
+{
+  p[0] = tag;
+  p[1] = p[2] = p[3] = 0;
+}
+
+} // namespace detail
+
+
+
+// -----------------------------------------------------------------------------------
+//                                Clock Probe
+// -----------------------------------------------------------------------------------
+
+struct ClockProbe
+{
+  uint32_t seq{0};
+  int64_t t0{0};   ///< Client send time, local clock [ns].
+};
+
+struct ClockAnswer
+{
+  uint32_t seq{0};
+  int64_t t0{0};   ///< Echoed client send time [ns].
+  int64_t t1{0};   ///< Server receive time, server clock [ns].
+  int64_t t2{0};   ///< Server send time, server clock [ns].
+};
+
+inline void EncodeClockProbe(const ClockProbe& p, std::array<uint8_t, kClockProbeSize>& out) noexcept
+{
+  detail::PutTag(out.data(), kClockProbeTag);
+  detail::Put(out.data() + 4, p.seq);
+  detail::Put(out.data() + 8, p.t0);
+}
+
+[[nodiscard]] inline std::optional<ClockProbe> DecodeClockProbe(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size != kClockProbeSize || data[0] != kClockProbeTag) return std::nullopt;
+  return ClockProbe{detail::Get<uint32_t>(data + 4), detail::Get<int64_t>(data + 8)};
+}
+
+inline void EncodeClockAnswer(const ClockAnswer& a, std::array<uint8_t, kClockAnswerSize>& out) noexcept
+{
+  detail::PutTag(out.data(), kClockAnswerTag);
+  detail::Put(out.data() + 4, a.seq);
+  detail::Put(out.data() + 8, a.t0);
+  detail::Put(out.data() + 16, a.t1);
+  detail::Put(out.data() + 24, a.t2);
+}
+
+[[nodiscard]] inline std::optional<ClockAnswer> DecodeClockAnswer(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size != kClockAnswerSize || data[0] != kClockAnswerTag) return std::nullopt;
+  return ClockAnswer{detail::Get<uint32_t>(data + 4), detail::Get<int64_t>(data + 8),
+                     detail::Get<int64_t>(data + 16), detail::Get<int64_t>(data + 24)};
+}
+
+
+
+// -----------------------------------------------------------------------------------
+//                              Stage / Trigger
+// -----------------------------------------------------------------------------------
+
+/**
+ * @brief Wrap an encoded command frame into a stage frame of @p group_id.
+ * @param out Resized; reuse it to avoid reallocation.
+ */
+inline void EncodeStageFrame(uint32_t group_id, const std::vector<uint8_t>& command_frame, std::vector<uint8_t>& out)
+{
+  out.resize(kStageHeaderSize + command_frame.size());
+  detail::PutTag(out.data(), kStageTag);
+  detail::Put(out.data() + 4, group_id);
+  std::memcpy(out.data() + kStageHeaderSize, command_frame.data(), command_frame.size());
+}
+
+struct StageFrameView
+{
+  uint32_t group_id{0};
+  const uint8_t* command{nullptr};   ///< Embedded command frame.
+  std::size_t command_size{0};
+};
+
+[[nodiscard]] inline std::optional<StageFrameView> DecodeStageFrame(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size <= kStageHeaderSize || data[0] != kStageTag) return std::nullopt;
+  return StageFrameView{detail::Get<uint32_t>(data + 4), data + kStageHeaderSize, size - kStageHeaderSize};
+}
+
+struct Trigger
+{
+  uint32_t group_id{0};
+  int64_t start_ns{0};   ///< Start time on the server clock [ns]; 0 starts on receipt.
+};
+
+inline void EncodeTrigger(const Trigger& t, std::array<uint8_t, kTriggerSize>& out) noexcept
+{
+  detail::PutTag(out.data(), kTriggerTag);
+  detail::Put(out.data() + 4, t.group_id);
+  detail::Put(out.data() + 8, t.start_ns);
+}
+
+[[nodiscard]] inline std::optional<Trigger> DecodeTrigger(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size != kTriggerSize || data[0] != kTriggerTag) return std::nullopt;
+  return Trigger{detail::Get<uint32_t>(data + 4), detail::Get<int64_t>(data + 8)};
+}
+
+struct Started
+{
+  uint32_t group_id{0};
+  uint32_t cmd_id{0};
+  int64_t started_ns{0};   ///< Actual start, server clock [ns].
+};
+
+inline void EncodeStarted(const Started& s, std::array<uint8_t, kStartedSize>& out) noexcept
+{
+  detail::PutTag(out.data(), kStartedTag);
+  detail::Put(out.data() + 4, s.group_id);
+  detail::Put(out.data() + 8, s.cmd_id);
+  detail::Put(out.data() + 12, uint32_t{0});
+  detail::Put(out.data() + 16, s.started_ns);
+}
+
+[[nodiscard]] inline std::optional<Started> DecodeStarted(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size != kStartedSize || data[0] != kStartedTag) return std::nullopt;
+  return Started{detail::Get<uint32_t>(data + 4), detail::Get<uint32_t>(data + 8), detail::Get<int64_t>(data + 16)};
+}
+
+inline void EncodeWithdraw(uint32_t group_id, std::array<uint8_t, kWithdrawSize>& out) noexcept
+{
+  detail::PutTag(out.data(), kWithdrawTag);
+  detail::Put(out.data() + 4, group_id);
+}
+
+/**
+ * @return Group id, or std::nullopt if the frame is not a withdraw frame.
+ */
+[[nodiscard]] inline std::optional<uint32_t> DecodeWithdraw(const uint8_t* data, std::size_t size) noexcept
+{
+  if (data == nullptr || size != kWithdrawSize || data[0] != kWithdrawTag) return std::nullopt;
+  return detail::Get<uint32_t>(data + 4);
+}
+
+}  // namespace wisson_SDK::network
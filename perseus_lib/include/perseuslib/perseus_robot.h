@@ -13,13 +13,18 @@
  */
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 
 #include "perseuslib/common/robot_state.hpp"
+#include "perseuslib/controller/command_handle.hpp"
+#include "perseuslib/controller/command_validator.hpp"
 #include "perseuslib/controller/controller.h"
+#include "perseuslib/controller/robot_task.hpp"
 
 
 namespace wisson_SDK {
@@ -96,11 +101,93 @@ public:
 
     /**
      * @brief Sends a motion command to the robot.
+     *
+     * Blocks until the command finishes. Only joint position and task command modes
+     * are executed (control::detail::IsControlModeSupported()); check other modes
+     * before calling, the prebuilt controller never completes them.
      * @param controller_mode Controller mode (joint/task/etc.)
      * @param cmd RobotCommand object containing target motion.
      */
     void Control(const control::ControllerMode& controller_mode, std::shared_ptr<control::RobotCommand> cmd);
 
+    /**
+     * @brief Non-blocking variant of Control().
+     *
+     * Commands of one robot are executed in submission order on a dedicated
+     * dispatcher thread; the returned handle reports status and progress and
+     * completes without polling. CommandHandle::Cancel() drops a queued command; on
+     * the running one it returns false, since only the server can stop a motion it
+     * executes. Stop that through the server stop path, control::StopChannel::Stop(*cmd):
+     * once the server acknowledges, Control() returns and the handle completes with
+     * kUserStop.
+     * @param controller_mode Controller mode (joint/task/etc.)
+     * @param cmd Shared pointer to robot command.
+     * @param limits Optional pre-flight limits; @p cmd is validated before it is queued,
+     *               instead of being refused by the server after a round trip.
+     * @return Handle on the queued command.
+     * @throw InvalidOperationException if the robot was not created by Create().
+     * @throw CommandException if Control() cannot execute @p controller_mode (see
+     *        control::detail::IsControlModeSupported()), an entry of @p cmd cannot run
+     *        in it, or @p cmd fails validation against @p limits.
+     */
+    [[nodiscard]] control::CommandHandle ControlAsync(const control::ControllerMode& controller_mode,
+                                                      std::shared_ptr<control::RobotCommand> cmd,
+                                                      const control::CommandLimits* limits = nullptr)
+    {
+        control::detail::RequireControlMode(controller_mode);
+        if (cmd && !control::detail::IsCommandSupported(controller_mode, *cmd)) {
+            throw CommandException("libperseus-PerseusRobot: command does not match mode " +
+                                   controller_mode.ModeToString() + ".");
+        }
+        if (cmd && limits != nullptr) {
+            if (const auto result = control::ValidateCommand(*cmd, controller_mode, *limits); !result) {
+                throw CommandException("libperseus-PerseusRobot: invalid command " + std::to_string(cmd->cmd_id) +
+                                       ": " + result.ToString() + ".");
+            }
+        }
+        const std::weak_ptr<PerseusRobot> weak = weak_from_this();
+        auto self = weak.lock();
+        if (!self) {
+            throw InvalidOperationException("libperseus-PerseusRobot: ControlAsync requires a robot created by Create().");
+        }
+        auto dispatcher = control::CommandDispatcher::ForOwner(self, "SDK_Dispatch");
+        return dispatcher->Submit(cmd, [self, controller_mode, cmd]() {
+            self->Control(controller_mode, cmd);
+            // Finished by a stop (control::detail::PreemptCommand) before a final response.
+            return control::detail::IsActionFinished(cmd->status) ? cmd->status : control::ResponseStatus::kUserStop;
+        });
+    }
+
+    /**
+     * @brief Non-blocking end-effector command; the handle can be co_awaited.
+     * @param action End-effector action.
+     * @param timeout Command timeout in seconds.
+     */
+    [[nodiscard]] control::CommandHandle EndEffectorAsync(control::EndEffectorAction action, double timeout = 10.0)
+    {
+        auto cmd = control::RobotCommand::CreateCommand(control::EndEffectorCommand{.ee_action = action, .timeout = timeout});
+        return ControlAsync(control::ControllerMode::TaskCommand(), std::move(cmd));
+    }
+
+    /**
+     * @brief Awaitable that completes once @p predicate holds for the robot state.
+     *
+     * Must be co_awaited from a flow running on a control::TaskExecutor. Yields the
+     * matching state, or nullptr if @p timeout elapsed first; an exception thrown by
+     * ReadOnce() or @p predicate is rethrown in the flow.
+     * @param predicate Condition on the current RobotState.
+     * @param timeout Optional timeout.
+     */
+    [[nodiscard]] control::StateAwaitable WaitState(control::TaskExecutor::StatePredicate predicate,
+                                                    std::optional<std::chrono::steady_clock::duration> timeout = std::nullopt)
+    {
+        std::shared_ptr<PerseusRobot> self = weak_from_this().lock();
+        if (!self) {
+            throw InvalidOperationException("libperseus-PerseusRobot: WaitState requires a robot created by Create().");
+        }
+        return control::StateAwaitable(this, [self]() { return self->ReadOnce(); }, std::move(predicate), timeout);
+    }
+
     /**
      * @brief Reads a single robot state update.
      * @return Shared pointer to current RobotState.